@@ -1,10 +1,11 @@
 /**
- * $group stages with no accumulators or with only $first accumulators can sometimes be converted
- * into a DISTINCT_SCAN (see SERVER-9507). This optimization potentially applies to a $group when it
- * begins the pipeline or when it is preceded only by one or both of $match and $sort (in that
- * order). In all cases, it must be possible to do a DISTINCT_SCAN that sees each value of the
- * distinct field exactly once among matching documents and also provides any requested sort. The
- * test queries below show most $match/$sort/$group combinations where that is possible.
+ * $group stages with no accumulators, with only $first accumulators or, when preceded by a $sort,
+ * with only $last accumulators can sometimes be converted into a DISTINCT_SCAN (see SERVER-9507).
+ * This optimization potentially applies to a $group when it begins the pipeline or when it is
+ * preceded only by one or both of $match and $sort (in that order). In all cases, it must be
+ * possible to do a DISTINCT_SCAN that sees each value of the distinct field exactly once among
+ * matching documents and also provides any requested sort. The test queries below show most
+ * $match/$sort/$group combinations where that is possible.
  *
  * @tags: [
  *   # The sharding and $facet passthrough suites modifiy aggregation pipelines in a way that
@@ -510,6 +511,47 @@ assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
 assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
 assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
 
+//
+// Verify that a $sort-$group pipeline can use DISTINCT_SCAN when all accumulators are $last, by
+// scanning for the first document of each group in the reverse of the requested sort.
+//
+pipeline = [{$sort: {a: 1, b: 1}}, {$group: {_id: "$a", accum: {$last: "$b"}}}];
+assertResultsMatchWithAndWithoutHintandIndexes(
+    pipeline, [{_id: null, accum: 1}, {_id: 1, accum: 3}, {_id: 2, accum: 2}]);
+explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+pipeline = [{$sort: {a: 1, b: 1, c: 1}}, {$group: {_id: "$a", accum: {$last: "$$ROOT"}}}];
+assertResultsMatchWithAndWithoutHintandIndexes(pipeline, [
+    {_id: null, accum: {_id: 6, a: null, b: 1, c: 1.5}},
+    {_id: 1, accum: {_id: 3, a: 1, b: 3, c: 2}},
+    {_id: 2, accum: {_id: 4, a: 2, b: 2, c: 2}}
+]);
+explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+//
+// Verify that a $group pipeline _does not_ use DISTINCT_SCAN when it mixes $first and $last
+// accumulators, or when it has $last accumulators but no $sort.
+//
+pipeline = [
+    {$sort: {a: 1, b: 1}},
+    {$group: {_id: "$a", firstB: {$first: "$b"}, lastB: {$last: "$b"}}}
+];
+assertResultsMatchWithAndWithoutHintandIndexes(pipeline, [
+    {_id: null, firstB: null, lastB: 1},
+    {_id: 1, firstB: 1, lastB: 3},
+    {_id: 2, firstB: 2, lastB: 2}
+]);
+explain = coll.explain().aggregate(pipeline);
+assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
+explain = coll.explain().aggregate([{$group: {_id: "$a", accum: {$last: "$b"}}}]);
+assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
 //
 // Verify that a $sort-$group pipeline _does not_ use DISTINCT_SCAN when there are non-$first
 // accumulators.
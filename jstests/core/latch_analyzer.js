@@ -39,6 +39,7 @@ function verifyLatchAnalysis({analysis, shouldHaveHierarchy}) {
         verifyField(singleLatch.acquired);
         verifyField(singleLatch.released);
         verifyField(singleLatch.contended);
+        verifyField(singleLatch.contendedWaitMicros);
 
         const acquiredAfter = singleLatch.acquiredAfter;
         const releasedBefore = singleLatch.releasedBefore;
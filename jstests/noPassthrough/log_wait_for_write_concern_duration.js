@@ -0,0 +1,67 @@
+/**
+ * Test that slow query log lines and profiler entries for writes that wait for write concern
+ * include waitForWriteConcernDurationMillis, and that writes which do not wait omit it.
+ *
+ * @tags: [requires_replication, requires_profiling]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/log.js");                 // For findMatchingLogLine.
+load("jstests/libs/write_concern_util.js");  // For stopServerReplication.
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB(jsTestName());
+const coll = testDB.coll;
+
+// Log every operation and profile every operation.
+assert.commandWorked(testDB.setProfilingLevel(2, -1));
+
+function getLogLineAndProfileEntry(comment) {
+    const globalLog = assert.commandWorked(testDB.adminCommand({getLog: "global"}));
+    const line = findMatchingLogLine(globalLog.log, {msg: "Slow query", comment: comment});
+    assert(line, "Failed to find a log line matching the comment " + comment);
+    const profileEntry = testDB.system.profile.findOne({"command.comment": comment});
+    assert(profileEntry, "Failed to find a profiler entry matching the comment " + comment);
+    return {line: line, profileEntry: profileEntry};
+}
+
+// A w:1 write does not wait for replication, so the field is omitted.
+let comment = "w1_insert_should_not_report_wait_for_write_concern_duration";
+assert.commandWorked(testDB.runCommand({
+    insert: coll.getName(),
+    documents: [{_id: 1}],
+    writeConcern: {w: 1},
+    comment: comment,
+}));
+
+let {line, profileEntry} = getLogLineAndProfileEntry(comment);
+assert(!line.includes("waitForWriteConcernDurationMillis"), line);
+assert(!profileEntry.hasOwnProperty("waitForWriteConcernDurationMillis"), profileEntry);
+
+// With replication stopped, a w:2 write waits until its wtimeout expires.
+const kWTimeoutMS = 1000;
+stopServerReplication(rst.getSecondary());
+
+comment = "w2_insert_should_report_wait_for_write_concern_duration";
+const res = assert.commandWorkedIgnoringWriteConcernErrors(testDB.runCommand({
+    insert: coll.getName(),
+    documents: [{_id: 2}],
+    writeConcern: {w: 2, wtimeout: kWTimeoutMS},
+    comment: comment,
+}));
+assert(res.writeConcernError, res);
+
+({line, profileEntry} = getLogLineAndProfileEntry(comment));
+const match = line.match(/waitForWriteConcernDurationMillis"?:([0-9]+)/);
+assert(match, `waitForWriteConcernDurationMillis missing from log line: ${line}`);
+assert.gt(parseInt(match[1]), 0, line);
+assert.gt(profileEntry.waitForWriteConcernDurationMillis, 0, profileEntry);
+
+restartServerReplication(rst.getSecondary());
+rst.stopSet();
+})();
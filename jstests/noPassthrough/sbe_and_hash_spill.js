@@ -0,0 +1,71 @@
+/**
+ * Tests that the SBE hash join built for an AND_HASH index intersection spills to disk when it is
+ * allowed to, and that it returns the same results whether or not it spilled.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For assertArrayEq.
+load("jstests/libs/analyze_plan.js");         // For getPlanStage.
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQueryForceIntersectionPlans: true,
+        internalQueryPlannerEnableHashIntersection: true,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_and_hash_spill;
+coll.drop();
+
+const kNumDocs = 1000;
+const docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i, a: i % 10, b: i % 7, padding: "x".repeat(100)});
+}
+assert.commandWorked(coll.insertMany(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+const query = {
+    a: {$gte: 2},
+    b: {$gte: 3}
+};
+const expected = docs.filter(doc => doc.a >= 2 && doc.b >= 3);
+
+function getHashJoinStats(allowDiskUse) {
+    let cursor = coll.find(query);
+    if (allowDiskUse) {
+        cursor = cursor.allowDiskUse();
+    }
+    const explain = cursor.explain("executionStats");
+    const hashJoin = getPlanStage(explain.executionStats.executionStages, "hj");
+    assert.neq(null, hashJoin, explain);
+    return hashJoin;
+}
+
+// With the default limit the hash table fits in memory.
+assertArrayEq({actual: coll.find(query).allowDiskUse().toArray(), expected: expected});
+assert.eq(false, getHashJoinStats(true).usedDisk);
+
+// Lower the limit so that the outer side no longer fits in memory.
+assert.commandWorked(db.adminCommand({
+    setParameter: 1,
+    internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill: 1,
+}));
+
+assertArrayEq({actual: coll.find(query).allowDiskUse().toArray(), expected: expected});
+let hashJoin = getHashJoinStats(true);
+assert.eq(true, hashJoin.usedDisk, hashJoin);
+assert.gt(hashJoin.spilledPartitions, 0, hashJoin);
+assert.gt(hashJoin.spilledOuterRecords, 0, hashJoin);
+
+// Without 'allowDiskUse' the join runs entirely in memory and reports no spilling stats.
+assertArrayEq({actual: coll.find(query).toArray(), expected: expected});
+hashJoin = getHashJoinStats(false);
+assert(!hashJoin.hasOwnProperty("usedDisk"), hashJoin);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,70 @@
+/**
+ * Tests that an SBE index scan over the point intervals of an $in sees index entries inserted while
+ * the query is yielded. Between two intervals the index scan may remember the entry it stopped on
+ * so that it can skip seeking to the next interval. That entry must be forgotten on yield, as an
+ * insert during the yield can land in front of it.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallel_shell_helpers.js");  // For funWithArgs.
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_index_scan_in_yield_concurrent_inserts;
+coll.drop();
+
+// Only the even values are present to begin with, so that every odd value of the $in sorts
+// between two existing index entries.
+const kNumValues = 40;
+const inValues = [];
+for (let i = 0; i < kNumValues; ++i) {
+    inValues.push(i);
+    if (i % 2 === 0) {
+        assert.commandWorked(coll.insert({_id: i, a: i}));
+    }
+}
+assert.commandWorked(coll.createIndex({a: 1}));
+
+// Yield after a few intervals have been scanned, and hang on the first yield.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 10}));
+const yieldHang =
+    configureFailPoint(conn, "setYieldAllLocksHang", {namespace: coll.getFullName()});
+
+const awaitQuery = startParallelShell(funWithArgs(function(collName, inValues) {
+    const values = db[collName]
+                       .find({a: {$in: inValues}})
+                       .hint({a: 1})
+                       .batchSize(1000)
+                       .toArray()
+                       .map(doc => doc.a);
+    assert.commandWorked(db.sbe_index_scan_in_yield_results.insert({values: values}));
+}, coll.getName(), inValues), conn.port);
+
+yieldHang.wait();
+for (let i = 1; i < kNumValues; i += 2) {
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+}
+yieldHang.off();
+awaitQuery();
+
+const values = db.sbe_index_scan_in_yield_results.findOne().values;
+jsTestLog("Query returned: " + tojson(values));
+
+// The index scan only moves forward, so an odd value is missing only if the scan was already past
+// it when the query yielded. Once one odd value has been returned, all larger ones must follow.
+const returnedOdd = values.filter(v => v % 2 === 1);
+assert.gt(returnedOdd.length, 0, values);
+const firstOdd = returnedOdd[0];
+for (let i = firstOdd; i < kNumValues; i += 2) {
+    assert.contains(i, values, "value " + i + " inserted during the yield was missed");
+}
+for (let i = 0; i < kNumValues; i += 2) {
+    assert.contains(i, values);
+}
+
+MongoRunner.stopMongod(conn);
+}());
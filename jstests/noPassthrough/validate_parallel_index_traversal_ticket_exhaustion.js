@@ -0,0 +1,64 @@
+/**
+ * Tests that a foreground validate which traverses indexes in parallel completes even when every
+ * read ticket is held by readers queued behind the exclusive collection lock it holds.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");
+
+const kNumReadTickets = 2;
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        wiredTigerConcurrentReadTransactions: kNumReadTickets,
+        maxValidateIndexTraversalThreads: 4,
+    }
+});
+
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+for (const field of ["a", "b", "c"]) {
+    assert.commandWorked(coll.createIndex({[field]: 1}));
+}
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    docs.push({_id: i, a: i, b: -i, c: "c" + i});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Pause the validate while it holds the exclusive collection lock, before it traverses indexes.
+assert.commandWorked(
+    db.adminCommand({configureFailPoint: "pauseCollectionValidationWithLock", mode: "alwaysOn"}));
+
+function runValidate(dbName, collName) {
+    const res = assert.commandWorked(db.getSiblingDB(dbName)[collName].validate());
+    assert(res.valid, tojson(res));
+}
+const awaitValidate =
+    startParallelShell(funWithArgs(runValidate, db.getName(), coll.getName()), conn.port);
+checkLog.containsJson(conn, 20304);
+
+// Each reader takes a read ticket, then waits for the collection lock held by the validate.
+function runReader(dbName, collName) {
+    assert.eq(100, db.getSiblingDB(dbName)[collName].find().itcount());
+}
+const readers = [];
+for (let i = 0; i < kNumReadTickets; i++) {
+    readers.push(
+        startParallelShell(funWithArgs(runReader, db.getName(), coll.getName()), conn.port));
+}
+assert.soon(() => db.currentOp({"command.find": coll.getName(), waitingForLock: true})
+                      .inprog.length === kNumReadTickets);
+
+// The index traversal threads must not need a read ticket to make progress.
+assert.commandWorked(
+    db.adminCommand({configureFailPoint: "pauseCollectionValidationWithLock", mode: "off"}));
+awaitValidate();
+readers.forEach((awaitReader) => awaitReader());
+
+MongoRunner.stopMongod(conn);
+}());
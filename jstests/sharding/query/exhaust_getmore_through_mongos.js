@@ -0,0 +1,56 @@
+/**
+ * Tests that exhaust getMores issued through mongos return every result of a sharded cursor, both
+ * for a merge-sorted and an unsorted query.
+ *
+ * @tags: [requires_getmore]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2});
+
+const mongosDB = st.s0.getDB(jsTestName());
+const mongosColl = mongosDB.coll;
+
+assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+st.ensurePrimaryShard(mongosDB.getName(), st.shard0.shardName);
+st.shardColl(mongosColl, {_id: 1}, {_id: 0}, {_id: 0});
+
+const docCount = 100;
+const bulk = mongosColl.initializeUnorderedBulkOp();
+for (let i = -docCount / 2; i < docCount / 2; ++i) {
+    bulk.insert({_id: i});
+}
+assert.commandWorked(bulk.execute());
+
+function getNetworkStats() {
+    return assert.commandWorked(mongosDB.adminCommand({serverStatus: 1})).network;
+}
+
+// Each batch holds a single document, so every result after the first is streamed by mongos.
+// Without exhaust support, the shell would send one getMore request per document instead.
+const networkBefore = getNetworkStats();
+const sorted = mongosColl.find().sort({_id: 1}).batchSize(1).addOption(DBQuery.Option.exhaust);
+let expectedId = -docCount / 2;
+while (sorted.hasNext()) {
+    assert.eq(sorted.next()._id, expectedId++);
+}
+assert.eq(expectedId, docCount / 2);
+
+// mongos counts the getMores it generates for an exhaust stream as logical input, but only the
+// requests the shell actually sent as physical input. Apart from the find, the first getMore and
+// the serverStatus commands, every getMore must have been generated by mongos.
+const networkAfter = getNetworkStats();
+const physicalBytesIn = networkAfter.physicalBytesIn - networkBefore.physicalBytesIn;
+const logicalBytesIn = networkAfter.bytesIn - networkBefore.bytesIn;
+assert.lt(physicalBytesIn,
+          logicalBytesIn / 2,
+          "mongos did not stream the exhaust getMore batches: " + tojson(networkAfter));
+
+assert.eq(mongosColl.find().batchSize(3).addOption(DBQuery.Option.exhaust).itcount(), docCount);
+
+// No cursor should be left open on mongos once the exhaust stream has finished.
+assert.eq(mongosDB.serverStatus().metrics.cursor.open.total, 0);
+
+st.stop();
+})();
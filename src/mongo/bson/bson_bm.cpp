@@ -112,8 +112,27 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+void BM_validateStrings(benchmark::State& state) {
+    // A flat object dominated by string fields, as seen on bulk ingest of text-heavy documents.
+    BSONObjBuilder builder;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++)
+        builder.append(fmt::format("field_{}", j), fmt::format("{}{:x<40s}", j, ""));
+    BSONObj obj = builder.done();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateStrings)->Ranges({{{1}, {1'000}}});
 
 }  // namespace mongo
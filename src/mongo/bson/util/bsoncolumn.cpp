@@ -28,3 +28,403 @@
  */
 
 #include "mongo/bson/util/bsoncolumn.h"
+
+#include "mongo/bson/util/simple8b_type_util.h"
+
+namespace mongo {
+namespace {
+static constexpr uint8_t kCountMask = 0x0F;
+static constexpr uint8_t kControlMask = 0xF0;
+
+// Control bytes for Simple-8b blocks, the high nibble encodes the scale index used for doubles.
+static constexpr uint8_t kControlSimple8bMin = 0x80;
+static constexpr uint8_t kControlSimple8bMax = 0xD0;
+
+bool isSimple8bControl(uint8_t control) {
+    uint8_t high = control & kControlMask;
+    return high >= kControlSimple8bMin && high <= kControlSimple8bMax;
+}
+
+uint8_t scaleIndexForControlByte(uint8_t control) {
+    // 0x80 is used for values stored as memory, 0x90-0xD0 for scale index 0-4. This is the inverse
+    // of kControlByteForScaleIndex in BSONColumnBuilder.
+    uint8_t high = control & kControlMask;
+    if (high == kControlSimple8bMin) {
+        return Simple8bTypeUtil::kMemoryAsInteger;
+    }
+    return (high >> 4) - (kControlSimple8bMin >> 4) - 1;
+}
+
+int numSimple8bBlocks(uint8_t control) {
+    return (control & kCountMask) + 1;
+}
+
+int64_t expandDelta(int64_t prev, int64_t delta) {
+    // Do the addition as unsigned and cast back to signed to get overflow defined to wrapped around
+    // instead of undefined behavior.
+    return static_cast<int64_t>(static_cast<uint64_t>(prev) + static_cast<uint64_t>(delta));
+}
+
+bool uses128bit(BSONType type) {
+    return type == NumberDecimal || type == BinData;
+}
+
+template <typename T>
+size_t numValuesInSimple8bBlocks(const char* buffer, int size) {
+    size_t num = 0;
+    Simple8b<T> s8b(buffer, size);
+    for (auto it = s8b.begin(), end = s8b.end(); it != end; it.advanceBlock()) {
+        num += it.blockSize();
+    }
+    return num;
+}
+
+const Simple8b<uint64_t>::Iterator kEmpty64 = Simple8b<uint64_t>(nullptr, 0).end();
+const Simple8b<uint128_t>::Iterator kEmpty128 = Simple8b<uint128_t>(nullptr, 0).end();
+}  // namespace
+
+BSONColumn::Iterator::Iterator(const char* control, const char* end)
+    : _control(control),
+      _end(end),
+      _s8b64(kEmpty64),
+      _s8b64End(kEmpty64),
+      _s8b128(kEmpty128),
+      _s8b128End(kEmpty128),
+      _scaleIndex(Simple8bTypeUtil::kMemoryAsInteger) {
+    if (_control != _end) {
+        _loadControl();
+    }
+}
+
+BSONColumn::Iterator::reference BSONColumn::Iterator::operator*() const {
+    if (_skip) {
+        return BSONElement();
+    }
+    return _last();
+}
+
+BSONColumn::Iterator& BSONColumn::Iterator::operator++() {
+    uassert(6100100, "Cannot advance BSONColumn iterator past the end", more());
+    ++_index;
+
+    // Advance within the current run of Simple-8b blocks if possible. Literals only hold a single
+    // value, so they always move us to the next control byte.
+    if (isSimple8bControl(*_control)) {
+        if (_uses128bit()) {
+            if (++_s8b128 != _s8b128End) {
+                _loadDelta();
+                return *this;
+            }
+        } else {
+            if (++_s8b64 != _s8b64End) {
+                _loadDelta();
+                return *this;
+            }
+        }
+        _control += 1 + numSimple8bBlocks(*_control) * sizeof(uint64_t);
+    } else {
+        _control += _lastSize;
+    }
+
+    _loadControl();
+    return *this;
+}
+
+BSONColumn::Iterator BSONColumn::Iterator::operator++(int) {
+    auto ret = *this;
+    operator++();
+    return ret;
+}
+
+BSONColumn::Iterator& BSONColumn::Iterator::advance(size_t n) {
+    for (size_t i = 0; i < n && more(); ++i) {
+        operator++();
+    }
+    return *this;
+}
+
+bool BSONColumn::Iterator::operator==(const Iterator& rhs) const {
+    if (!more() || !rhs.more()) {
+        return more() == rhs.more();
+    }
+    return _index == rhs._index;
+}
+
+bool BSONColumn::Iterator::operator!=(const Iterator& rhs) const {
+    return !operator==(rhs);
+}
+
+void BSONColumn::Iterator::_loadControl() {
+    uassert(6100101, "Invalid BSON Column encoding, missing EOO", _control < _end);
+
+    uint8_t control = *_control;
+    if (control == EOO) {
+        _control = _end;
+        _skip = true;
+        return;
+    }
+
+    if (isSimple8bControl(control)) {
+        int size = numSimple8bBlocks(control) * sizeof(uint64_t);
+        uassert(6100102,
+                "Invalid BSON Column encoding, Simple-8b blocks out of bounds",
+                _end - (_control + 1) >= size);
+
+        _scaleIndex = scaleIndexForControlByte(control);
+        // Doubles are delta encoded on their scaled integer representation, re-encode the last
+        // value using the scale factor of this run of blocks.
+        if (_lastLiteral && _last().type() == NumberDouble) {
+            auto encoded = Simple8bTypeUtil::encodeDouble(_last()._numberDouble(), _scaleIndex);
+            uassert(6100103,
+                    "Invalid BSON Column encoding, double cannot be scaled",
+                    encoded.has_value());
+            _lastEncodedValue64 = *encoded;
+        }
+
+        if (_uses128bit()) {
+            Simple8b<uint128_t> s8b(_control + 1, size);
+            _s8b128 = s8b.begin();
+            _s8b128End = s8b.end();
+        } else {
+            Simple8b<uint64_t> s8b(_control + 1, size);
+            _s8b64 = s8b.begin();
+            _s8b64End = s8b.end();
+        }
+        _loadDelta();
+        return;
+    }
+
+    // Literal, stored as a BSONElement with empty field name.
+    BSONElement literal(_control, 1, -1, BSONElement::CachedSizeTag{});
+    uassert(6100104,
+            "Invalid BSON Column encoding, literal out of bounds",
+            literal.size() <= _end - _control);
+    _setLiteral(_control, literal.size());
+}
+
+void BSONColumn::Iterator::_setLiteral(const char* literal, int size) {
+    _lastLiteral = literal;
+    _lastSize = size;
+    _lastDecoded = false;
+    _skip = false;
+
+    // Reset state needed to apply deltas on top of this literal.
+    _lastEncodedValueForDeltaOfDelta = 0;
+    BSONElement elem = _last();
+    switch (elem.type()) {
+        case jstOID:
+            _lastEncodedValue64 = Simple8bTypeUtil::encodeObjectId(elem.__oid());
+            break;
+        case NumberDecimal:
+            _lastEncodedValue128 = Simple8bTypeUtil::encodeDecimal128(elem._numberDecimal());
+            break;
+        case BinData: {
+            int size;
+            const char* binary = elem.binData(size);
+            if (size <= 16) {
+                _lastEncodedValue128 = Simple8bTypeUtil::encodeBinary(binary, size);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+BSONElement BSONColumn::Iterator::_last() const {
+    return {_lastDecoded ? _storage : _lastLiteral, 1, _lastSize, BSONElement::CachedSizeTag{}};
+}
+
+bool BSONColumn::Iterator::_uses128bit() const {
+    return _lastLiteral && uses128bit(_last().type());
+}
+
+char* BSONColumn::Iterator::_allocateDecoded(BSONType type, int valueSize) {
+    _storage[0] = type;
+    _storage[1] = '\0';
+    _lastSize = valueSize + 2;
+    _lastDecoded = true;
+    return _storage + 2;
+}
+
+void BSONColumn::Iterator::_loadDelta() {
+    if (_uses128bit()) {
+        const auto& delta = *_s8b128;
+        _skip = !delta.has_value();
+        if (!_skip) {
+            _applyDelta128(*delta);
+        }
+    } else {
+        const auto& delta = *_s8b64;
+        _skip = !delta.has_value();
+        if (!_skip) {
+            _applyDelta64(*delta);
+        }
+    }
+}
+
+void BSONColumn::Iterator::_applyDelta64(uint64_t encoded) {
+    uassert(6100105, "Invalid BSON Column encoding, delta without base value", _lastLiteral);
+
+    BSONElement last = _last();
+    BSONType type = last.type();
+    int64_t delta = Simple8bTypeUtil::decodeInt64(encoded);
+
+    // Delta-of-delta types need to carry the delta forward even if it is zero.
+    if (type == bsonTimestamp) {
+        _lastEncodedValueForDeltaOfDelta = expandDelta(_lastEncodedValueForDeltaOfDelta, delta);
+        uint64_t ts = expandDelta(last.timestamp().asULL(), _lastEncodedValueForDeltaOfDelta);
+        DataView(_allocateDecoded(bsonTimestamp, sizeof(uint64_t)))
+            .write<LittleEndian<uint64_t>>(ts);
+        return;
+    }
+
+    // A zero delta means the value is identical to the previous one; this is the only encoding
+    // possible for types that we can't delta compress.
+    if (delta == 0) {
+        return;
+    }
+
+    switch (type) {
+        case NumberDouble: {
+            _lastEncodedValue64 = expandDelta(_lastEncodedValue64, delta);
+            DataView(_allocateDecoded(NumberDouble, sizeof(double)))
+                .write<LittleEndian<double>>(
+                    Simple8bTypeUtil::decodeDouble(_lastEncodedValue64, _scaleIndex));
+            break;
+        }
+        case NumberInt:
+            DataView(_allocateDecoded(NumberInt, sizeof(int32_t)))
+                .write<LittleEndian<int32_t>>(
+                    static_cast<int32_t>(expandDelta(last._numberInt(), delta)));
+            break;
+        case NumberLong:
+            DataView(_allocateDecoded(NumberLong, sizeof(int64_t)))
+                .write<LittleEndian<int64_t>>(expandDelta(last._numberLong(), delta));
+            break;
+        case jstOID: {
+            _lastEncodedValue64 = expandDelta(_lastEncodedValue64, delta);
+            OID oid = Simple8bTypeUtil::decodeObjectId(_lastEncodedValue64,
+                                                       last.__oid().getInstanceUnique());
+            memcpy(_allocateDecoded(jstOID, OID::kOIDSize), oid.view().view(), OID::kOIDSize);
+            break;
+        }
+        case Date:
+            DataView(_allocateDecoded(Date, sizeof(int64_t)))
+                .write<LittleEndian<int64_t>>(
+                    expandDelta(last.date().toMillisSinceEpoch(), delta));
+            break;
+        case Bool:
+            *_allocateDecoded(Bool, 1) = static_cast<char>(last.boolean() + delta);
+            break;
+        default:
+            uasserted(6100106,
+                      str::stream() << "Invalid BSON Column encoding, non-zero delta for type "
+                                    << typeName(type));
+    }
+}
+
+void BSONColumn::Iterator::_applyDelta128(uint128_t encoded) {
+    uassert(6100107, "Invalid BSON Column encoding, delta without base value", _lastLiteral);
+
+    BSONElement last = _last();
+    BSONType type = last.type();
+    int128_t delta = Simple8bTypeUtil::decodeInt128(encoded);
+
+    if (delta == 0) {
+        return;
+    }
+
+    // Add as unsigned to get overflow defined to wrap around.
+    _lastEncodedValue128 = static_cast<int128_t>(static_cast<uint128_t>(_lastEncodedValue128) +
+                                                 static_cast<uint128_t>(delta));
+    switch (type) {
+        case NumberDecimal: {
+            Decimal128 dec = Simple8bTypeUtil::decodeDecimal128(_lastEncodedValue128);
+            Decimal128::Value val = dec.getValue();
+            DataView(_allocateDecoded(NumberDecimal, sizeof(val)))
+                .write<LittleEndian<uint64_t>>(val.low64)
+                .write<LittleEndian<uint64_t>>(val.high64, sizeof(uint64_t));
+            break;
+        }
+        case BinData: {
+            int len = last.valuestrsize();
+            uassert(6100108, "Invalid BSON Column encoding, BinData delta too large", len <= 16);
+
+            // BinData is stored as <int32 len> <subtype> <data>, keep length and subtype from the
+            // previous value.
+            char subtype = *(last.value() + 4);
+            char* value = _allocateDecoded(BinData, 5 + len);
+            DataView(value).write<LittleEndian<int32_t>>(len);
+            value[4] = subtype;
+            Simple8bTypeUtil::decodeBinary(_lastEncodedValue128, value + 5, len);
+            break;
+        }
+        default:
+            uasserted(6100109,
+                      str::stream() << "Invalid BSON Column encoding, non-zero delta for type "
+                                    << typeName(type));
+    }
+}
+
+BSONColumn::BSONColumn(BSONElement bin) : _name(bin.fieldNameStringData()) {
+    uassert(6100110,
+            "Invalid BSON type for column",
+            bin.type() == BSONType::BinData && bin.binDataType() == BinDataType::Column);
+
+    _binary = bin.binData(_size);
+    uassert(6100111, "Invalid BSON Column encoding", _size > 0);
+}
+
+BSONColumn::BSONColumn(const char* buffer, int size, StringData name)
+    : _binary(buffer), _size(size), _name(name) {
+    uassert(6100112, "Invalid BSON Column encoding", _size > 0);
+}
+
+BSONColumn::Iterator BSONColumn::begin() const {
+    return {_binary, _binary + _size};
+}
+
+BSONColumn::Iterator BSONColumn::end() const {
+    return {_binary + _size, _binary + _size};
+}
+
+BSONColumn::Iterator BSONColumn::seek(size_t index) const {
+    auto it = begin();
+    it.advance(index);
+    return it;
+}
+
+size_t BSONColumn::size() const {
+    size_t num = 0;
+    bool blocks128 = false;
+    const char* control = _binary;
+    const char* end = _binary + _size;
+    while (control < end && *control != EOO) {
+        uint8_t byte = *control;
+        if (!isSimple8bControl(byte)) {
+            BSONElement literal(control, 1, -1, BSONElement::CachedSizeTag{});
+            uassert(6100113,
+                    "Invalid BSON Column encoding, literal out of bounds",
+                    literal.size() <= end - control);
+            // Literals determine the width of the following Simple-8b blocks.
+            blocks128 = uses128bit(literal.type());
+            control += literal.size();
+            ++num;
+            continue;
+        }
+
+        int size = numSimple8bBlocks(byte) * sizeof(uint64_t);
+        uassert(6100114,
+                "Invalid BSON Column encoding, Simple-8b blocks out of bounds",
+                end - (control + 1) >= size);
+
+        // Only the selectors need to be inspected to count the values in each block.
+        num += blocks128 ? numValuesInSimple8bBlocks<uint128_t>(control + 1, size)
+                         : numValuesInSimple8bBlocks<uint64_t>(control + 1, size);
+        control += 1 + size;
+    }
+    return num;
+}
+
+}  // namespace mongo
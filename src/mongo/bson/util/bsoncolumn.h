@@ -28,3 +28,194 @@
  */
 
 #pragma once
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/util/simple8b.h"
+#include "mongo/platform/int128.h"
+
+namespace mongo {
+
+/**
+ * The BSONColumn class represents a reference to a BSONElement of BinDataType 7, which can
+ * efficiently store any BSONArray and also allows for missing values. At a high level, two
+ * optimizations are applied:
+ *   - implied field names: do not store decimal keys representing index keys.
+ *   - delta compression using Simple-8b: store difference between subsequent scalars of the same
+ *     type
+ *
+ * The BSONColumn will not take ownership of the BinData element, but otherwise implements an
+ * interface similar to BSONObj. Because iterators over the BSONColumn need to rematerialize
+ * deltas, they use additional storage owned by the iterator. Elements returned by an iterator are
+ * therefore only valid until the iterator is advanced or destroyed.
+ *
+ * Decompression is performed lazily, one element at a time, so reading a column never requires
+ * memory proportional to the number of elements it contains.
+ */
+class BSONColumn {
+public:
+    /**
+     * Constructs a BSONColumn over the BinData element 'bin', which must be of BinDataType Column.
+     * The element must remain valid for the lifetime of this BSONColumn and its iterators.
+     */
+    explicit BSONColumn(BSONElement bin);
+
+    /**
+     * Constructs a BSONColumn over a raw BSON Column binary, as returned by
+     * BSONColumnBuilder::finalize().
+     */
+    BSONColumn(const char* buffer, int size, StringData name = ""_sd);
+
+    /**
+     * Forward iterator type to access BSONElement from BSONColumn.
+     *
+     * Default-constructed BSONElement (EOO type) represent missing value.
+     * Returned BSONElement are owned by the iterator and remain valid until the iterator is
+     * advanced or destroyed. They do not have a field name.
+     */
+    class Iterator {
+    public:
+        friend class BSONColumn;
+
+        // typedefs expected in iterators
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = BSONElement;
+        using pointer = const BSONElement*;
+        using reference = BSONElement;
+
+        /**
+         * Returns the element at the current iterator position. Missing values are returned as
+         * EOO.
+         */
+        reference operator*() const;
+
+        /**
+         * Advance the iterator one step.
+         */
+        Iterator& operator++();
+        Iterator operator++(int);
+
+        /**
+         * Advance the iterator 'n' steps. Skipped positions are decoded but never materialized as
+         * BSONElement.
+         */
+        Iterator& advance(size_t n);
+
+        /**
+         * Returns the zero-based position of this iterator in the column.
+         */
+        size_t index() const {
+            return _index;
+        }
+
+        /**
+         * Returns true if the iterator is not positioned at the end of the column.
+         */
+        bool more() const {
+            return _control != _end;
+        }
+
+        bool operator==(const Iterator& rhs) const;
+        bool operator!=(const Iterator& rhs) const;
+
+    private:
+        Iterator(const char* control, const char* end);
+
+        // Loads the literal or Simple-8b blocks pointed to by '_control' and positions the
+        // iterator on its first value.
+        void _loadControl();
+
+        // Decodes the value at the current Simple-8b position.
+        void _loadDelta();
+        void _applyDelta64(uint64_t encoded);
+        void _applyDelta128(uint128_t encoded);
+
+        // Returns the last non-skipped value, used as base when applying deltas.
+        BSONElement _last() const;
+
+        // Sets the last value to the literal at 'literal', without copying.
+        void _setLiteral(const char* literal, int size);
+
+        // Prepares '_storage' for a decoded value of 'type' that takes 'valueSize' bytes and
+        // returns a pointer to where the value should be written.
+        char* _allocateDecoded(BSONType type, int valueSize);
+
+        // Whether the current run of Simple-8b blocks stores 128bit deltas.
+        bool _uses128bit() const;
+
+        // Total size of a decoded element is at most type byte + empty field name + BinData with
+        // 16 bytes of payload.
+        static constexpr int kMaxDecodedSize = 2 + 4 + 1 + 16;
+
+        // Position of the current control byte or literal, and end of the binary.
+        const char* _control;
+        const char* _end;
+
+        // Zero-based index of the current position.
+        size_t _index = 0;
+
+        // Iterators to the current run of Simple-8b blocks. Only one of them is in use, depending
+        // on the type of the last literal.
+        Simple8b<uint64_t>::Iterator _s8b64;
+        Simple8b<uint64_t>::Iterator _s8b64End;
+        Simple8b<uint128_t>::Iterator _s8b128;
+        Simple8b<uint128_t>::Iterator _s8b128End;
+
+        // Last non-skipped value. Either points to a literal in the binary or to '_storage' when
+        // the value was rematerialized from a delta.
+        const char* _lastLiteral = nullptr;
+        int _lastSize = 1;
+        bool _lastDecoded = false;
+        char _storage[kMaxDecodedSize];
+
+        // True if the current position is a missing value.
+        bool _skip = true;
+
+        // Encoded form of the last value, used for types where deltas are not computed directly
+        // on the value.
+        int64_t _lastEncodedValue64 = 0;
+        int128_t _lastEncodedValue128 = 0;
+
+        // Last delta, used by types using delta-of-delta encoding.
+        int64_t _lastEncodedValueForDeltaOfDelta = 0;
+
+        // Scale index of the current run of Simple-8b blocks, used for doubles.
+        uint8_t _scaleIndex;
+    };
+
+    /**
+     * Forward iterator access.
+     *
+     * Iterator value is EOO when element is skipped.
+     *
+     * Iterators materialize compressed BSONElement as they iterate over the compressed binary
+     * into storage owned by the iterator, so multiple iterators may be advanced independently.
+     */
+    Iterator begin() const;
+    Iterator end() const;
+
+    /**
+     * Returns an iterator positioned at 'index', or end() if the column has fewer elements.
+     */
+    Iterator seek(size_t index) const;
+
+    /**
+     * Number of elements stored in this BSONColumn, including missing values. Computed by walking
+     * the control bytes and Simple-8b selectors, values are not decoded.
+     */
+    size_t size() const;
+
+    /**
+     * Field name that this BSONColumn represents.
+     */
+    StringData name() const {
+        return _name;
+    }
+
+private:
+    const char* _binary;
+    int _size;
+    StringData _name;
+};
+
+}  // namespace mongo
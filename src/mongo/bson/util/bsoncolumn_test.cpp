@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/util/bsoncolumn.h"
 #include "mongo/bson/util/bsoncolumnbuilder.h"
 #include "mongo/bson/util/simple8b_type_util.h"
 
@@ -123,6 +124,20 @@ public:
         return _elementMemory.front().firstElement();
     }
 
+    BSONElement createElementString(StringData val) {
+        BSONObjBuilder ob;
+        ob.append("0"_sd, val);
+        _elementMemory.emplace_front(ob.obj());
+        return _elementMemory.front().firstElement();
+    }
+
+    BSONElement createElementObj(const BSONObj& obj) {
+        BSONObjBuilder ob;
+        ob.append("0"_sd, obj);
+        _elementMemory.emplace_front(ob.obj());
+        return _elementMemory.front().firstElement();
+    }
+
     BSONElement createSymbol(StringData symbol) {
         BSONObjBuilder ob;
         ob.appendSymbol("0"_sd, symbol);
@@ -141,9 +156,12 @@ public:
         if (val.binaryEqualValues(prev)) {
             return 0;
         }
-        return Simple8bTypeUtil::encodeInt128(
-            Simple8bTypeUtil::encodeBinary(val.valuestr(), val.valuestrsize()) -
-            Simple8bTypeUtil::encodeBinary(prev.valuestr(), prev.valuestrsize()));
+        int valSize;
+        int prevSize;
+        const char* valBinary = val.binData(valSize);
+        const char* prevBinary = prev.binData(prevSize);
+        return Simple8bTypeUtil::encodeInt128(Simple8bTypeUtil::encodeBinary(valBinary, valSize) -
+                                              Simple8bTypeUtil::encodeBinary(prevBinary, prevSize));
     }
 
     static uint64_t deltaInt32(BSONElement val, BSONElement prev) {
@@ -318,6 +336,30 @@ public:
         ASSERT_EQ(memcmp(columnBinary.data, buf, columnBinary.length), 0);
     }
 
+    static void verifyDecompression(BSONBinData columnBinary,
+                                    const std::vector<BSONElement>& expected) {
+        BSONColumn col(static_cast<const char*>(columnBinary.data), columnBinary.length);
+        ASSERT_EQ(col.size(), expected.size());
+
+        auto it = col.begin();
+        for (auto&& elem : expected) {
+            ASSERT_TRUE(it != col.end());
+            BSONElement decompressed = *it;
+            ASSERT_EQ(decompressed.type(), elem.type());
+            ASSERT_TRUE(decompressed.binaryEqualValues(elem));
+            ++it;
+        }
+        ASSERT_TRUE(it == col.end());
+
+        // Seeking needs to produce the same elements as iterating.
+        for (size_t i = 0; i < expected.size(); ++i) {
+            auto seeked = col.seek(i);
+            ASSERT_EQ(seeked.index(), i);
+            ASSERT_TRUE((*seeked).binaryEqualValues(expected[i]));
+        }
+        ASSERT_TRUE(col.seek(expected.size()) == col.end());
+    }
+
     const boost::optional<uint64_t> kDeltaForBinaryEqualValues = Simple8bTypeUtil::encodeInt64(0);
 
 private:
@@ -1558,6 +1600,28 @@ TEST_F(BSONColumnTest, SymbolAfterChangeBack) {
     verifyBinary(cb.finalize(), expected);
 }
 
+TEST_F(BSONColumnTest, StringAndObjectChangesStoredAsLiterals) {
+    BSONColumnBuilder cb("test"_sd);
+
+    auto first = createElementString("a");
+    auto second = createElementString("b");
+    auto obj = createElementObj(BSON("x" << 1));
+    cb.append(first);
+    cb.append(second);
+    cb.append(second);
+    cb.append(obj);
+
+    BufBuilder expected;
+    appendLiteral(expected, first);
+    appendLiteral(expected, second);
+    appendSimple8bControl(expected, 0b1000, 0b0000);
+    appendSimple8bBlock64(expected, kDeltaForBinaryEqualValues);
+    appendLiteral(expected, obj);
+    appendEOO(expected);
+
+    verifyBinary(cb.finalize(), expected);
+}
+
 TEST_F(BSONColumnTest, BinDataBase) {
     BSONColumnBuilder cb("test"_sd);
     std::vector<uint8_t> input{'1', '2', '3', '4'};
@@ -1637,12 +1701,12 @@ TEST_F(BSONColumnTest, BinDataDeltaCheckSkips) {
 
     BufBuilder expected;
     appendLiteral(expected, elemBinData);
-    appendSimple8bControl(expected, 0b1000, 0b0000);
+    appendSimple8bControl(expected, 0b1000, 0b0001);
     std::vector<boost::optional<uint128_t>> expectedValues = {
         deltaBinData(elemBinDataLong, elemBinData),
         boost::none,
         deltaBinData(elemBinData, elemBinDataLong)};
-    appendSimple8bBlocks128(expected, expectedValues, 1);
+    appendSimple8bBlocks128(expected, expectedValues, 2);
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
@@ -1709,5 +1773,219 @@ TEST_F(BSONColumnTest, BinDataLargerThan16SameValue) {
     verifyBinary(cb.finalize(), expected);
 }
 
+TEST_F(BSONColumnTest, DecompressBasicValue) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems = {
+        createElementInt32(1), createElementInt32(1), createElementInt32(2), createElementInt32(0)};
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressWithSkips) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems;
+    for (int i = 0; i < 200; ++i) {
+        elems.push_back(i % 3 == 0 ? BSONElement() : createElementInt64(i * 1000));
+    }
+    for (auto elem : elems) {
+        if (elem.eoo()) {
+            cb.skip();
+        } else {
+            cb.append(elem);
+        }
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressLeadingSkips) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems = {
+        BSONElement(), BSONElement(), createElementInt32(5), createElementInt32(5)};
+    cb.skip();
+    cb.skip();
+    cb.append(elems[2]);
+    cb.append(elems[3]);
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressDoubleRescale) {
+    BSONColumnBuilder cb("test"_sd);
+
+    // Mix values needing different scale factors so blocks are written with several scale
+    // indexes and pending values get re-scaled.
+    std::vector<BSONElement> elems;
+    for (int i = 0; i < 300; ++i) {
+        double val = static_cast<double>((i * 7919) % 10000) / std::pow(10, i % 5);
+        elems.push_back(i % 11 == 0 ? BSONElement() : createElementDouble(val));
+    }
+    for (auto elem : elems) {
+        if (elem.eoo()) {
+            cb.skip();
+        } else {
+            cb.append(elem);
+        }
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressTimestampDeltaOfDelta) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems;
+    for (int i = 0; i < 100; ++i) {
+        elems.push_back(createTimestamp(Timestamp(1000 + i * 2, i % 3)));
+    }
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressObjectIdDateBool) {
+    BSONColumnBuilder cb("test"_sd);
+
+    OID oid("112233445566778899AABBCC");
+    std::vector<BSONElement> elems;
+    for (int i = 0; i < 20; ++i) {
+        OID next = oid;
+        next.setTimestamp(oid.getTimestamp() + i);
+        elems.push_back(createObjectId(next));
+    }
+    for (int i = 0; i < 20; ++i) {
+        elems.push_back(createDate(Date_t::fromMillisSinceEpoch(1000000 + i * 100)));
+    }
+    for (int i = 0; i < 20; ++i) {
+        elems.push_back(createBool(i % 3 == 0));
+    }
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressBinData) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems = {createElementBinData({'1', '2', '3', '4'}),
+                                      createElementBinData({'1', '2', '3', '3'}),
+                                      createElementBinData({'1', '2', '3', '3'}),
+                                      createElementBinData({'2', '2', '3', '4'})};
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressTypeChanges) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems = {createElementInt32(1),
+                                      createElementInt32(2),
+                                      createElementDouble(1.5),
+                                      createNull(),
+                                      createNull(),
+                                      createElementInt64(3),
+                                      createElementInt64(3)};
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressStringAndObject) {
+    BSONColumnBuilder cb("test"_sd);
+
+    std::vector<BSONElement> elems = {createElementString("a"),
+                                      createElementString("a"),
+                                      createElementString("b"),
+                                      createElementObj(BSON("x" << 1)),
+                                      createElementObj(BSON("x" << 1))};
+    for (auto elem : elems) {
+        cb.append(elem);
+    }
+
+    verifyDecompression(cb.finalize(), elems);
+}
+
+TEST_F(BSONColumnTest, DecompressIteratorsAreIndependent) {
+    BSONColumnBuilder cb("test"_sd);
+
+    for (int i = 0; i < 10; ++i) {
+        cb.append(createElementInt32(i));
+    }
+    auto binData = cb.finalize();
+    BSONColumn col(static_cast<const char*>(binData.data), binData.length);
+
+    auto first = col.begin();
+    auto second = first;
+    second.advance(5);
+    ASSERT_EQ((*first).Int(), 0);
+    ASSERT_EQ((*second).Int(), 5);
+    ++first;
+    ASSERT_EQ((*first).Int(), 1);
+    ASSERT_EQ((*second).Int(), 5);
+}
+
+TEST_F(BSONColumnTest, DecompressFromBinDataElement) {
+    BSONColumnBuilder cb("test"_sd);
+    cb.append(createElementInt32(1));
+    cb.append(createElementInt32(2));
+    auto binData = cb.finalize();
+
+    BSONObjBuilder ob;
+    ob.appendBinData("test"_sd, binData.length, BinDataType::Column, binData.data);
+    BSONObj obj = ob.obj();
+
+    BSONColumn col(obj.firstElement());
+    ASSERT_EQ(col.name(), "test"_sd);
+    ASSERT_EQ(col.size(), 2U);
+    ASSERT_EQ((*col.seek(1)).Int(), 2);
+
+    BSONObj notColumn = BSON("test" << 1);
+    ASSERT_THROWS(BSONColumn(notColumn.firstElement()), DBException);
+}
+
+TEST_F(BSONColumnTest, DecompressInvalid) {
+    // Simple-8b control byte without any blocks following it.
+    {
+        BufBuilder buffer;
+        appendSimple8bControl(buffer, 0b1000, 0b0000);
+        BSONColumn col(buffer.buf(), buffer.len());
+        ASSERT_THROWS(col.begin(), DBException);
+    }
+
+    // Missing EOO terminator.
+    {
+        BufBuilder buffer;
+        appendLiteral(buffer, createElementInt32(1));
+        BSONColumn col(buffer.buf(), buffer.len());
+        auto it = col.begin();
+        ASSERT_THROWS(++it, DBException);
+    }
+
+    // Delta without a literal to apply it to.
+    {
+        BufBuilder buffer;
+        appendSimple8bControl(buffer, 0b1000, 0b0000);
+        appendSimple8bBlock64(buffer, deltaInt64(createElementInt64(1), createElementInt64(0)));
+        appendEOO(buffer);
+        BSONColumn col(buffer.buf(), buffer.len());
+        ASSERT_THROWS(col.begin(), DBException);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
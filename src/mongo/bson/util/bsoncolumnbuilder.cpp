@@ -116,8 +116,9 @@ BSONColumnBuilder& BSONColumnBuilder::append(BSONElement elem) {
                         elem.valuestrsize() == previous.valuestrsize() && elem.valuestrsize() <= 16;
                     if (!encodingPossible)
                         break;
-                    int128_t curEncoded =
-                        Simple8bTypeUtil::encodeBinary(elem.valuestr(), elem.valuestrsize());
+                    int size;
+                    const char* binary = elem.binData(size);
+                    int128_t curEncoded = Simple8bTypeUtil::encodeBinary(binary, size);
                     delta = curEncoded - _prevEncoded128;
                     _prevEncoded128 = curEncoded;
                 } break;
@@ -127,8 +128,9 @@ BSONColumnBuilder& BSONColumnBuilder::append(BSONElement elem) {
                     _prevEncoded128 = curEncoded;
                 } break;
                 default:
-                    // Nothing else is implemented yet
-                    invariant(false);
+                    // Types without a delta encoding are stored as literals when they change.
+                    encodingPossible = false;
+                    break;
             };
             if (encodingPossible) {
                 compressed = _simple8bBuilder128.append(Simple8bTypeUtil::encodeInt128(delta));
@@ -167,15 +169,10 @@ BSONColumnBuilder& BSONColumnBuilder::append(BSONElement elem) {
                 case jstNULL:
                     value = 0;
                     break;
-                case RegEx:
-                case DBRef:
-                case CodeWScope:
-                case Symbol:
+                default:
+                    // Types without a delta encoding are stored as literals when they change.
                     encodingPossible = false;
                     break;
-                default:
-                    // Nothing else is implemented yet
-                    invariant(false);
             };
             if (encodingPossible) {
                 compressed = _simple8bBuilder64.append(Simple8bTypeUtil::encodeInt64(value));
@@ -294,34 +291,47 @@ bool BSONColumnBuilder::_appendDouble(double value, double previous) {
             Simple8bTypeUtil::encodeInt64(calcDelta(encoded, _prevEncoded64))))
         return false;
 
+    _prevEncoded64 = encoded;
     if (_bufBuilder.len() != before) {
-        // Reset the scale factor to 0 and append all pending values to a new Simple8bBuilder. In
-        // the worse case we will end up with an identical scale factor.
-        auto prevScale = _scaleIndex;
-        std::tie(_prevEncoded64, _scaleIndex) = scaleAndEncodeDouble(_lastValueInPrevBlock, 0);
+        _rescalePendingAfterWrite();
+    }
+    return true;
+}
 
-        // Create a new Simple8bBuilder.
-        Simple8bBuilder<uint64_t> builder(_createBufferWriter());
-        std::swap(_simple8bBuilder64, builder);
-
-        // Iterate over previous pending values and re-add them recursively. That will increase the
-        // scale factor as needed.
-        auto prev = _lastValueInPrevBlock;
-        auto prevEncoded = *Simple8bTypeUtil::encodeDouble(prev, prevScale);
-        for (const auto& pending : builder) {
-            if (pending) {
-                prevEncoded = expandDelta(prevEncoded, Simple8bTypeUtil::decodeInt64(*pending));
-                auto val = Simple8bTypeUtil::decodeDouble(prevEncoded, prevScale);
-                _appendDouble(val, prev);
-                prev = val;
-            } else {
-                _simple8bBuilder64.skip();
-            }
+void BSONColumnBuilder::_rescalePendingAfterWrite() {
+    // The written block may not contain all values that were pending, revert the deltas of the
+    // values that are still pending from the last appended value to find the last value in the
+    // written block. This is the value the pending deltas are based on.
+    auto prevScale = _scaleIndex;
+    int64_t prevEncoded = _prevEncoded64;
+    for (const auto& pending : _simple8bBuilder64) {
+        if (pending) {
+            prevEncoded = calcDelta(prevEncoded, Simple8bTypeUtil::decodeInt64(*pending));
+        }
+    }
+    _lastValueInPrevBlock = Simple8bTypeUtil::decodeDouble(prevEncoded, prevScale);
+
+    // Reset the scale factor to 0 and append all pending values to a new Simple8bBuilder. In the
+    // worse case we will end up with an identical scale factor.
+    std::tie(_prevEncoded64, _scaleIndex) = scaleAndEncodeDouble(_lastValueInPrevBlock, 0);
+
+    // Create a new Simple8bBuilder.
+    Simple8bBuilder<uint64_t> builder(_createBufferWriter());
+    std::swap(_simple8bBuilder64, builder);
+
+    // Iterate over previous pending values and re-add them recursively. That will increase the
+    // scale factor as needed.
+    auto prev = _lastValueInPrevBlock;
+    for (const auto& pending : builder) {
+        if (pending) {
+            prevEncoded = expandDelta(prevEncoded, Simple8bTypeUtil::decodeInt64(*pending));
+            auto val = Simple8bTypeUtil::decodeDouble(prevEncoded, prevScale);
+            _appendDouble(val, prev);
+            prev = val;
+        } else {
+            _simple8bBuilder64.skip();
         }
     }
-
-    _prevEncoded64 = encoded;
-    return true;
 }
 
 BSONColumnBuilder& BSONColumnBuilder::skip() {
@@ -331,9 +341,9 @@ BSONColumnBuilder& BSONColumnBuilder::skip() {
     } else {
         _simple8bBuilder64.skip();
     }
-    // Rescale previous known value if this skip caused Simple-8b blocks to be written
+    // Rescale pending values if this skip caused Simple-8b blocks to be written
     if (before != _bufBuilder.len() && _previous().type() == NumberDouble) {
-        std::tie(_prevEncoded64, _scaleIndex) = scaleAndEncodeDouble(_lastValueInPrevBlock, 0);
+        _rescalePendingAfterWrite();
     }
     return *this;
 }
@@ -378,11 +388,13 @@ void BSONColumnBuilder::_writeLiteralFromPrevious() {
     // There is no previous timestamp delta. Set to default.
     _prevDelta = 0;
     switch (prevElem.type()) {
-        case BinData:
-            if (prevElem.valuestrsize() <= 16)
-                _prevEncoded128 =
-                    Simple8bTypeUtil::encodeBinary(prevElem.valuestr(), prevElem.valuestrsize());
+        case BinData: {
+            int size;
+            const char* binary = prevElem.binData(size);
+            if (size <= 16)
+                _prevEncoded128 = Simple8bTypeUtil::encodeBinary(binary, size);
             break;
+        }
         case NumberDecimal:
             _prevEncoded128 = Simple8bTypeUtil::encodeDecimal128(prevElem._numberDecimal());
             break;
@@ -92,6 +92,11 @@ private:
     boost::optional<Simple8bBuilder<uint64_t>> _tryRescalePending(int64_t encoded,
                                                                   uint8_t newScaleIndex);
 
+    // Called after Simple-8b blocks containing doubles were written. Computes the last value that
+    // was written to a block and re-appends all pending values with the lowest possible scale
+    // factor.
+    void _rescalePendingAfterWrite();
+
     Simple8bWriteFn _createBufferWriter();
 
     // Storage for the previously appended BSONElement
@@ -61,6 +61,16 @@ Query& Query::hint(BSONObj keyPattern) {
     return *this;
 }
 
+Query& Query::minKey(const BSONObj& val) {
+    appendComplex("$min", val);
+    return *this;
+}
+
+Query& Query::maxKey(const BSONObj& val) {
+    appendComplex("$max", val);
+    return *this;
+}
+
 bool Query::isComplex(const BSONObj& obj, bool* hasDollar) {
     if (obj.hasElement("query")) {
         if (hasDollar)
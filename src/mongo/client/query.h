@@ -86,6 +86,14 @@ public:
     */
     Query& hint(BSONObj keyPattern);
 
+    /**
+     * Provide min and/or max index limits for the query. The query runs over the hinted index,
+     * starting at 'min' (inclusive) and stopping before 'max' (exclusive). Both take an object
+     * with the fields of the hinted index's key pattern, e.g. minKey(BSON("_id" << 100)).
+     */
+    Query& minKey(const BSONObj& val);
+    Query& maxKey(const BSONObj& val);
+
     /**
      * Sets the read preference for this query.
      *
@@ -414,14 +414,16 @@ public:
     /**
      * Inserts a document into the record store for a bulk loader that manages the index building
      * outside this Collection. The bulk loader is notified with the RecordId of the document
-     * inserted into the RecordStore.
+     * inserted into the RecordStore. If 'recordStoreBulkBuilder' is not null, the document is
+     * appended through it rather than inserted into the record store directly.
      *
-     * NOTE: It is up to caller to commit the indexes.
+     * NOTE: It is up to caller to commit the indexes and the 'recordStoreBulkBuilder'.
      */
     virtual Status insertDocumentForBulkLoader(
         OperationContext* opCtx,
         const BSONObj& doc,
-        const OnRecordInsertedFn& onRecordInserted) const = 0;
+        const OnRecordInsertedFn& onRecordInserted,
+        RecordStoreBulkBuilderInterface* recordStoreBulkBuilder) const = 0;
 
     /**
      * Updates the document @ oldLocation with newDoc.
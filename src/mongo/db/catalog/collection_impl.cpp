@@ -715,7 +715,10 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
 }
 
 Status CollectionImpl::insertDocumentForBulkLoader(
-    OperationContext* opCtx, const BSONObj& doc, const OnRecordInsertedFn& onRecordInserted) const {
+    OperationContext* opCtx,
+    const BSONObj& doc,
+    const OnRecordInsertedFn& onRecordInserted,
+    RecordStoreBulkBuilderInterface* recordStoreBulkBuilder) const {
 
     auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
     if (!status.isOK()) {
@@ -737,8 +740,10 @@ Status CollectionImpl::insertDocumentForBulkLoader(
 
     // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
     // timestamp to use.
-    StatusWith<RecordId> loc = _shared->_recordStore->insertRecord(
-        opCtx, recordId, doc.objdata(), doc.objsize(), Timestamp());
+    StatusWith<RecordId> loc = recordStoreBulkBuilder
+        ? recordStoreBulkBuilder->addRecord(doc.objdata(), doc.objsize())
+        : _shared->_recordStore->insertRecord(
+              opCtx, recordId, doc.objdata(), doc.objsize(), Timestamp());
 
     if (!loc.isOK())
         return loc.getStatus();
@@ -159,9 +159,11 @@ public:
         std::abort();
     }
 
-    Status insertDocumentForBulkLoader(OperationContext* opCtx,
-                                       const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) const {
+    Status insertDocumentForBulkLoader(
+        OperationContext* opCtx,
+        const BSONObj& doc,
+        const OnRecordInsertedFn& onRecordInserted,
+        RecordStoreBulkBuilderInterface* recordStoreBulkBuilder) const {
         std::abort();
     }
 
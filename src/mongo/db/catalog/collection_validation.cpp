@@ -39,6 +39,7 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/validate_adaptor.h"
+#include "mongo/db/catalog/validate_gen.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
@@ -114,20 +115,34 @@ void _validateIndexes(OperationContext* opCtx,
                       ValidateState* validateState,
                       ValidateAdaptor* indexValidator,
                       ValidateResults* results) {
+    // Foreground validation holds an exclusive lock and never yields, so its indexes can be
+    // traversed concurrently unless it has to repair them.
+    boost::optional<std::map<std::string, int64_t>> numTraversedKeysPerIndex;
+    const size_t numThreads = gMaxValidateIndexTraversalThreads.load();
+    if (numThreads > 1 && validateState->getIndexes().size() > 1 &&
+        !validateState->isBackground() && !validateState->fixErrors()) {
+        numTraversedKeysPerIndex =
+            indexValidator->traverseIndexesInParallel(opCtx, numThreads, results);
+    }
+
     // Validate Indexes, checking for mismatch between index entries and collection records.
     for (const auto& index : validateState->getIndexes()) {
         opCtx->checkForInterrupt();
 
         const IndexDescriptor* descriptor = index->descriptor();
 
-        LOGV2_OPTIONS(20296,
-                      {LogComponent::kIndex},
-                      "Validating index consistency",
-                      "index"_attr = descriptor->indexName(),
-                      "namespace"_attr = validateState->nss());
-
         int64_t numTraversedKeys;
-        indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        if (numTraversedKeysPerIndex) {
+            numTraversedKeys = numTraversedKeysPerIndex->at(descriptor->indexName());
+        } else {
+            LOGV2_OPTIONS(20296,
+                          {LogComponent::kIndex},
+                          "Validating index consistency",
+                          "index"_attr = descriptor->indexName(),
+                          "namespace"_attr = validateState->nss());
+
+            indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        }
 
         auto& curIndexResults = (results->indexResultsMap)[descriptor->indexName()];
         curIndexResults.keysTraversed = numTraversedKeys;
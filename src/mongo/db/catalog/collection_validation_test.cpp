@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
@@ -266,6 +267,25 @@ TEST_F(CollectionValidationTest, ValidateEnforceFastCount) {
                        {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
 }
 
+// Verify that traversing the indexes on several threads reaches the same results as doing so
+// serially.
+TEST_F(CollectionValidationTest, ValidateIndexesInParallel) {
+    auto opCtx = operationContext();
+    std::vector<BSONObj> indexSpecs;
+    for (auto&& field : {"a", "b", "c"}) {
+        indexSpecs.push_back(BSON("v" << 2 << "key" << BSON(field << 1) << "name"
+                                      << std::string(field) + "_1"));
+    }
+    ASSERT_OK(storageInterface()->createIndexesOnEmptyCollection(opCtx, kNss, indexSpecs));
+
+    RAIIServerParameterControllerForTest controller("maxValidateIndexTraversalThreads", 2);
+    foregroundValidate(opCtx,
+                       /*valid*/ true,
+                       /*numRecords*/ insertDataRange(opCtx, 0, 5000),
+                       /*numInvalidDocuments*/ 0,
+                       /*numErrors*/ 0);
+}
+
 /**
  * Waits for a parallel running collection validation operation to start and then hang at a
  * failpoint.
@@ -355,6 +355,35 @@ void IndexConsistency::addDocKey(OperationContext* opCtx,
     }
 }
 
+IndexConsistency::IndexKeyCounts::IndexKeyCounts() : _buckets(kNumHashBuckets) {}
+
+void IndexConsistency::addIndexKey(const KeyString::Value& ks,
+                                   IndexInfo* indexInfo,
+                                   IndexKeyCounts* counts) {
+    invariant(_firstPhase);
+
+    auto rawHash = ks.hash(indexInfo->indexNameHash);
+    auto hashLower = rawHash % kNumHashBuckets;
+    auto hashUpper = (rawHash / kNumHashBuckets) % kNumHashBuckets;
+    auto& lower = counts->_buckets[hashLower];
+    auto& upper = counts->_buckets[hashUpper];
+
+    lower.indexKeyCount--;
+    lower.bucketSizeBytes += ks.getSize();
+    upper.indexKeyCount--;
+    upper.bucketSizeBytes += ks.getSize();
+    indexInfo->numKeys++;
+}
+
+void IndexConsistency::mergeIndexKeyCounts(const IndexKeyCounts& counts) {
+    invariant(_firstPhase);
+
+    for (size_t i = 0; i < kNumHashBuckets; i++) {
+        _indexKeyBuckets[i].indexKeyCount += counts._buckets[i].indexKeyCount;
+        _indexKeyBuckets[i].bucketSizeBytes += counts._buckets[i].bucketSizeBytes;
+    }
+}
+
 void IndexConsistency::addIndexKey(OperationContext* opCtx,
                                    const KeyString::Value& ks,
                                    IndexInfo* indexInfo,
@@ -96,7 +96,26 @@ class IndexConsistency final {
     using IndexInfoMap = std::map<std::string, IndexInfo>;
     using IndexKey = std::pair<std::string, std::string>;
 
+    struct IndexKeyBucket {
+        uint32_t indexKeyCount;
+        uint32_t bucketSizeBytes;
+    };
+
 public:
+    /**
+     * First phase index key counts gathered by a thread traversing an index concurrently with
+     * others. Merged into the shared buckets with mergeIndexKeyCounts() once the traversal is done.
+     */
+    class IndexKeyCounts {
+    public:
+        IndexKeyCounts();
+
+    private:
+        friend class IndexConsistency;
+
+        std::vector<IndexKeyBucket> _buckets;
+    };
+
     IndexConsistency(OperationContext* opCtx, CollectionValidation::ValidateState* validateState);
 
     /**
@@ -122,6 +141,18 @@ public:
                      RecordId recordId,
                      ValidateResults* results);
 
+    /**
+     * First phase counterpart of addIndexKey() that records the index entry's KeyString in
+     * 'counts' instead of the shared buckets, so that several indexes can be traversed at once.
+     */
+    void addIndexKey(const KeyString::Value& ks, IndexInfo* indexInfo, IndexKeyCounts* counts);
+
+    /**
+     * Folds the counts gathered by a concurrent index traversal into the shared buckets. Callers
+     * must not merge concurrently with each other or with any other use of this object.
+     */
+    void mergeIndexKeyCounts(const IndexKeyCounts& counts);
+
     /**
      * During the first phase of validation, tracks the multikey paths for every observed document.
      */
@@ -178,11 +209,6 @@ public:
     bool limitMemoryUsageForSecondPhase(ValidateResults* result);
 
 private:
-    struct IndexKeyBucket {
-        uint32_t indexKeyCount;
-        uint32_t bucketSizeBytes;
-    };
-
     IndexConsistency() = delete;
 
     CollectionValidation::ValidateState* _validateState;
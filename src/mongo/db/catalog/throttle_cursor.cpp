@@ -122,6 +122,7 @@ boost::optional<KeyStringEntry> SortedDataInterfaceThrottleCursor::nextKeyString
 }
 
 void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize) {
+    stdx::unique_lock<Latch> lk(_mutex);
     int64_t currentMillis =
         opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
 
@@ -169,15 +170,17 @@ void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize
     // read one 5 MB document and maxValidateBytesPerSec is 1, we should not be waiting until the
     // next 1 second period. We should wait 5 seconds to maintain proper throughput.
     int64_t maxWaitMs = 1000 * std::max(1.0, double(_bytesProcessed) / maxValidateBytesPerSec);
+    const int64_t startMillis = _startMillis;
+    lk.unlock();
 
     do {
-        int64_t millisToSleep = maxWaitMs - (currentMillis - _startMillis);
+        int64_t millisToSleep = maxWaitMs - (currentMillis - startMillis);
         invariant(millisToSleep >= 0);
 
         opCtx->sleepFor(Milliseconds(millisToSleep));
         currentMillis =
             opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch();
-    } while (currentMillis < _startMillis + maxWaitMs);
+    } while (currentMillis < startMillis + maxWaitMs);
 }
 
 }  // namespace mongo
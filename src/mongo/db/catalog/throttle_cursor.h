@@ -34,6 +34,7 @@
 
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -120,6 +121,9 @@ private:
  * Throttles the amount of data processed within a unit of time. Puts the thread to sleep via an
  * opCtx -- so it is interruptible -- whenever the data limit set by the 'maxValidateMBperSec'
  * server parameter is exceeded before the time unit is done.
+ *
+ * A single instance may be shared by cursors used concurrently from several threads, in which case
+ * the limit applies to the data they process combined.
  */
 class DataThrottle {
 public:
@@ -145,10 +149,14 @@ public:
     void awaitIfNeeded(OperationContext* opCtx, int64_t dataSize);
 
     void turnThrottlingOff() {
+        stdx::lock_guard<Latch> lk(_mutex);
         _shouldNotThrottle = true;
     }
 
 private:
+    // Protects the members below. Not held while sleeping.
+    Mutex _mutex = MONGO_MAKE_LATCH("DataThrottle::_mutex");
+
     // Point-in-time (milliseconds) when tracking for the current second has started.
     int64_t _startMillis;
 
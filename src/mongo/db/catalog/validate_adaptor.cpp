@@ -33,11 +33,17 @@
 
 #include "mongo/db/catalog/validate_adaptor.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/throttle_cursor.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
@@ -52,7 +58,10 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/object_check.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/testing_proctor.h"
 
 namespace mongo {
@@ -261,14 +270,176 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
                                     const IndexCatalogEntry* index,
                                     int64_t* numTraversedKeys,
                                     ValidateResults* results) {
-    const IndexDescriptor* descriptor = index->descriptor();
-    auto indexName = descriptor->indexName();
-    auto& indexResults = results->indexResultsMap[indexName];
-    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
-    int64_t numKeys = 0;
+    const std::string& indexName = index->descriptor()->indexName();
 
-    bool isFirstEntry = true;
+    _startIndexProgress(opCtx);
+
+    // Ensure that this index has an open index cursor.
+    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
+    invariant(indexCursorIt != _validateState->getIndexCursors().end());
+
+    const int64_t numKeys = _traverseIndexEntries(opCtx,
+                                                  index,
+                                                  indexCursorIt->second.get(),
+                                                  results,
+                                                  /*keyCounts=*/nullptr);
+
+    _validateMultikeyMetadata(opCtx, index, results);
+
+    if (numTraversedKeys) {
+        *numTraversedKeys = numKeys;
+    }
+}
+
+std::map<std::string, int64_t> ValidateAdaptor::traverseIndexesInParallel(
+    OperationContext* opCtx, size_t numThreads, ValidateResults* results) {
+    // Without yields or concurrent writes, every thread reads the same data as 'opCtx' would.
+    invariant(!_validateState->isBackground());
+    invariant(!_validateState->fixErrors());
+    invariant(opCtx->lockState()->isCollectionLockedForMode(_validateState->nss(), MODE_X));
+
+    _startIndexProgress(opCtx);
+
+    struct IndexTraversal {
+        const IndexCatalogEntry* index;
+        ValidateResults results;
+        int64_t numKeys = 0;
+    };
+    std::vector<IndexTraversal> traversals;
+    for (const auto& index : _validateState->getIndexes()) {
+        traversals.push_back({index.get()});
+    }
+    numThreads = std::min(numThreads, traversals.size());
+
+    // Worker threads claim whole indexes in order, gathering their key counts separately so that
+    // the shared buckets are only touched once all of them are done.
+    AtomicWord<size_t> nextTraversal{0};
+    std::vector<IndexConsistency::IndexKeyCounts> keyCounts(numThreads);
+    std::vector<Status> workerStatuses(numThreads, Status::OK());
+
+    auto mutex = MONGO_MAKE_LATCH("ValidateAdaptor::traverseIndexesInParallel::mutex");
+    stdx::condition_variable workerFinished;
+    size_t numFinished = 0;
+    std::vector<OperationContext*> workerOpCtxs;
+    boost::optional<ErrorCodes::Error> killCode;
+
+    auto runWorker = [&](size_t worker) {
+        ThreadClient tc("ValidateIndexTraversal", opCtx->getServiceContext());
+        auto workerOpCtx = tc->makeOperationContext();
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(mutex);
+            workerOpCtxs.erase(
+                std::find(workerOpCtxs.begin(), workerOpCtxs.end(), workerOpCtx.get()));
+            ++numFinished;
+            workerFinished.notify_all();
+        });
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            workerOpCtxs.push_back(workerOpCtx.get());
+            if (killCode) {
+                return;
+            }
+        }
+
+        if (opCtx->hasDeadline()) {
+            workerOpCtx->setDeadlineByDate(opCtx->getDeadline(), opCtx->getTimeoutError());
+        }
+        workerOpCtx->recoveryUnit()->setPrepareConflictBehavior(
+            PrepareConflictBehavior::kIgnoreConflicts);
+
+        try {
+            // The collection lock held by 'opCtx' keeps the indexes in place, so reading them only
+            // requires access to the storage engine. Readers queued behind that exclusive lock may
+            // hold every read ticket, so waiting for one here could deadlock the validate.
+            SkipTicketAcquisitionForLock skipTicketAcquisition(workerOpCtx.get());
+            Lock::GlobalLock globalLock(workerOpCtx.get(), MODE_IS);
+
+            for (size_t i = nextTraversal.fetchAndAdd(1); i < traversals.size();
+                 i = nextTraversal.fetchAndAdd(1)) {
+                auto& traversal = traversals[i];
+
+                LOGV2_OPTIONS(6101900,
+                              {logv2::LogComponent::kIndex},
+                              "Validating index consistency in parallel",
+                              "index"_attr = traversal.index->descriptor()->indexName(),
+                              "namespace"_attr = _validateState->nss());
+
+                SortedDataInterfaceThrottleCursor indexCursor(workerOpCtx.get(),
+                                                              traversal.index->accessMethod(),
+                                                              _validateState->getDataThrottle());
+                traversal.numKeys = _traverseIndexEntries(workerOpCtx.get(),
+                                                          traversal.index,
+                                                          &indexCursor,
+                                                          &traversal.results,
+                                                          &keyCounts[worker]);
+            }
+        } catch (const DBException& ex) {
+            workerStatuses[worker] = ex.toStatus();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t worker = 0; worker < numThreads; worker++) {
+        threads.emplace_back([&runWorker, worker] { runWorker(worker); });
+    }
+
+    try {
+        stdx::unique_lock<Latch> lk(mutex);
+        opCtx->waitForConditionOrInterrupt(
+            workerFinished, lk, [&] { return numFinished == threads.size(); });
+    } catch (const DBException& ex) {
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            killCode = ex.code();
+            for (auto workerOpCtx : workerOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                opCtx->getServiceContext()->killOperation(clientLock, workerOpCtx, *killCode);
+            }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
 
+    for (const auto& status : workerStatuses) {
+        uassertStatusOK(status);
+    }
+
+    for (const auto& counts : keyCounts) {
+        _indexConsistency->mergeIndexKeyCounts(counts);
+    }
+
+    std::map<std::string, int64_t> numTraversedKeys;
+    for (auto& traversal : traversals) {
+        for (auto& [indexName, workerIndexResults] : traversal.results.indexResultsMap) {
+            auto& indexResults = results->indexResultsMap[indexName];
+            indexResults.valid = indexResults.valid && workerIndexResults.valid;
+            std::move(workerIndexResults.errors.begin(),
+                      workerIndexResults.errors.end(),
+                      std::back_inserter(indexResults.errors));
+            std::move(workerIndexResults.warnings.begin(),
+                      workerIndexResults.warnings.end(),
+                      std::back_inserter(indexResults.warnings));
+        }
+        std::move(traversal.results.errors.begin(),
+                  traversal.results.errors.end(),
+                  std::back_inserter(results->errors));
+        results->valid = results->valid && traversal.results.valid;
+
+        _progress->hit(traversal.numKeys);
+        numTraversedKeys[traversal.index->descriptor()->indexName()] = traversal.numKeys;
+
+        _validateMultikeyMetadata(opCtx, traversal.index, results);
+    }
+
+    return numTraversedKeys;
+}
+
+void ValidateAdaptor::_startIndexProgress(OperationContext* opCtx) {
     // The progress meter will be inactive after traversing the record store to allow the message
     // and the total to be set to different values.
     if (!_progress->isActive()) {
@@ -276,6 +447,20 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         stdx::unique_lock<Client> lk(*opCtx->getClient());
         _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, _totalIndexKeys));
     }
+}
+
+int64_t ValidateAdaptor::_traverseIndexEntries(OperationContext* opCtx,
+                                               const IndexCatalogEntry* index,
+                                               SortedDataInterfaceThrottleCursor* indexCursor,
+                                               ValidateResults* results,
+                                               IndexConsistency::IndexKeyCounts* keyCounts) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    auto indexName = descriptor->indexName();
+    auto& indexResults = results->indexResultsMap[indexName];
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
+    int64_t numKeys = 0;
+
+    bool isFirstEntry = true;
 
     const KeyString::Version version =
         index->accessMethod()->getSortedDataInterface()->getKeyStringVersion();
@@ -289,12 +474,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
     KeyString::Value firstKeyString = firstKeyStringBuilder.release();
     KeyString::Value prevIndexKeyStringValue;
 
-    // Ensure that this index has an open index cursor.
-    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
-    invariant(indexCursorIt != _validateState->getIndexCursors().end());
-
-    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor = indexCursorIt->second;
-
     boost::optional<KeyStringEntry> indexEntry;
     try {
         indexEntry = indexCursor->seekForKeyString(opCtx, firstKeyString);
@@ -323,8 +502,12 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             _indexConsistency->removeMultikeyMetadataPath(indexEntry->keyString, &indexInfo);
         } else {
             try {
-                _indexConsistency->addIndexKey(
-                    opCtx, indexEntry->keyString, &indexInfo, indexEntry->loc, results);
+                if (keyCounts) {
+                    _indexConsistency->addIndexKey(indexEntry->keyString, &indexInfo, keyCounts);
+                } else {
+                    _indexConsistency->addIndexKey(
+                        opCtx, indexEntry->keyString, &indexInfo, indexEntry->loc, results);
+                }
             } catch (const DBException& e) {
                 StringBuilder ss;
                 ss << "Parsing index key for " << indexInfo.indexName << " recId "
@@ -334,15 +517,21 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             }
         }
 
-        _progress->hit();
+        // Concurrent traversals report their progress once they are done.
+        if (!keyCounts) {
+            _progress->hit();
+        }
         numKeys++;
         isFirstEntry = false;
         prevIndexKeyStringValue = indexEntry->keyString;
 
         if (numKeys % kInterruptIntervalNumRecords == 0) {
-            // Periodically checks for interrupts and yields.
+            // Periodically checks for interrupts and yields. Concurrent traversals run under the
+            // exclusive lock of a foreground validation, which never yields.
             opCtx->checkForInterrupt();
-            _validateState->yield(opCtx);
+            if (!keyCounts) {
+                _validateState->yield(opCtx);
+            }
         }
 
         try {
@@ -359,6 +548,15 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         }
     }
 
+    return numKeys;
+}
+
+void ValidateAdaptor::_validateMultikeyMetadata(OperationContext* opCtx,
+                                                const IndexCatalogEntry* index,
+                                                ValidateResults* results) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
+
     if (results && _indexConsistency->getMultikeyMetadataPathCount(&indexInfo) > 0) {
         results->errors.push_back(str::stream()
                                   << "Index '" << descriptor->indexName()
@@ -431,10 +629,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             }
         }
     }
-
-    if (numTraversedKeys) {
-        *numTraversedKeys = numKeys;
-    }
 }
 
 void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
@@ -29,12 +29,15 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
+#include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/validate_state.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
 
-class IndexConsistency;
 class IndexDescriptor;
 class OperationContext;
 
@@ -68,6 +71,17 @@ public:
                        int64_t* numTraversedKeys,
                        ValidateResults* results);
 
+    /**
+     * Does the work of traverseIndex() for every index being validated, spreading the traversals
+     * over up to 'numThreads' threads that each read whole indexes through their own cursors.
+     * Only allowed during the first phase of a foreground validation that does not repair
+     * anything, where the collection's exclusive lock guarantees that every thread reads the same
+     * data. Returns the number of keys traversed for each index, by index name.
+     */
+    std::map<std::string, int64_t> traverseIndexesInParallel(OperationContext* opCtx,
+                                                             size_t numThreads,
+                                                             ValidateResults* results);
+
     /**
      * Traverses the record store to retrieve every record and go through its document key
      * set to keep track of the index consistency during a validation.
@@ -85,6 +99,26 @@ public:
                                IndexValidateResults& results);
 
 private:
+    void _startIndexProgress(OperationContext* opCtx);
+
+    /**
+     * Validates the order of the entries of 'index' read through 'indexCursor' and adds them to
+     * the index consistency, in 'keyCounts' if provided. Returns the number of entries traversed.
+     */
+    int64_t _traverseIndexEntries(OperationContext* opCtx,
+                                  const IndexCatalogEntry* index,
+                                  SortedDataInterfaceThrottleCursor* indexCursor,
+                                  ValidateResults* results,
+                                  IndexConsistency::IndexKeyCounts* keyCounts);
+
+    /**
+     * Checks the multikey metadata of a fully traversed index against its documents, adjusting it
+     * when allowed.
+     */
+    void _validateMultikeyMetadata(OperationContext* opCtx,
+                                   const IndexCatalogEntry* index,
+                                   ValidateResults* results);
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
 
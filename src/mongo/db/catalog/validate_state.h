@@ -127,6 +127,13 @@ public:
         return _indexCursors;
     }
 
+    /**
+     * The throttle shared by every cursor reading data for this validation.
+     */
+    DataThrottle* getDataThrottle() {
+        return &_dataThrottle;
+    }
+
     const std::unique_ptr<SeekableRecordThrottleCursor>& getTraverseRecordStoreCursor() const {
         return _traverseRecordStoreCursor;
     }
@@ -542,6 +542,13 @@ public:
                     // Add result to output buffer.
                     firstBatch.append(obj);
                     numResults++;
+
+                    // Once a few results are buffered, size the reply for the rest of the batch
+                    // rather than growing it repeatedly as the results are appended.
+                    if (auto bytesToReserve = FindCommon::getBytesToReserveForFirstBatch(
+                            originalFC, numResults, firstBatch.bytesUsed())) {
+                        result->reserveBytes(bytesToReserve);
+                    }
                     docUnitsReturned.observeOne(obj.objsize());
                 }
             } catch (DBException& exception) {
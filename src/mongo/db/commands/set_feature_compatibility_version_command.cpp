@@ -65,6 +65,8 @@
 #include "mongo/db/s/resharding/resharding_coordinator_service.h"
 #include "mongo/db/s/resharding/resharding_donor_recipient_common.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/db/vector_clock.h"
 #include "mongo/db/views/view_catalog.h"
@@ -485,6 +487,13 @@ private:
             Lock::GlobalLock lk(opCtx, MODE_S);
         }
 
+        // Compressed time-series buckets can only be read by 5.1 binaries. No buckets are
+        // compressed once the barrier above has been passed, so the remaining ones can be
+        // decompressed safely.
+        if (requestedVersion < FeatureCompatibility::Version::kVersion51) {
+            _decompressTimeseriesBuckets(opCtx);
+        }
+
         uassert(ErrorCodes::Error(549181),
                 "Failing upgrade due to 'failDowngrading' failpoint set",
                 !failDowngrading.shouldFail());
@@ -524,6 +533,59 @@ private:
               "last_continuous_version"_attr = FCVP::kLastContinuous);
     }
 
+    /**
+     * Rewrites every compressed (control.version 2) time-series bucket in the uncompressed format.
+     * A bucket is only replaced if it is unchanged since it was read; buckets which were modified
+     * concurrently are read again on the next pass.
+     */
+    void _decompressTimeseriesBuckets(OperationContext* opCtx) {
+        std::vector<NamespaceString> bucketsNamespaces;
+        for (const auto& dbName : DatabaseHolder::get(opCtx)->getNames()) {
+            Lock::DBLock dbLock(opCtx, dbName, MODE_IS);
+            catalog::forEachCollectionFromDb(
+                opCtx,
+                dbName,
+                MODE_IS,
+                [&](const CollectionPtr& collection) {
+                    bucketsNamespaces.push_back(collection->ns());
+                    return true;
+                },
+                [&](const CollectionPtr& collection) {
+                    return collection->getTimeseriesOptions() != boost::none;
+                });
+        }
+
+        const std::string controlVersionField = str::stream()
+            << timeseries::kBucketControlFieldName << "."
+            << timeseries::kBucketControlVersionFieldName;
+        const auto compressedFilter =
+            BSON(controlVersionField << timeseries::kTimeseriesControlCompressedVersion);
+
+        DBDirectClient client(opCtx);
+        for (const auto& bucketsNs : bucketsNamespaces) {
+            bool bucketChanged = true;
+            while (bucketChanged) {
+                bucketChanged = false;
+                auto cursor = client.query(bucketsNs, compressedFilter);
+                while (cursor->more()) {
+                    auto bucketDoc = cursor->nextSafe().getOwned();
+
+                    BSONObjBuilder filter;
+                    filter.append(bucketDoc[timeseries::kBucketIdFieldName]);
+                    filter.append(bucketDoc[timeseries::kBucketControlFieldName]);
+                    filter.append(bucketDoc[timeseries::kBucketDataFieldName]);
+
+                    auto result = client.updateAcknowledged(
+                        bucketsNs.ns(), filter.obj(), timeseries::decompressBucket(bucketDoc));
+                    uassertStatusOK(getStatusFromWriteCommandReply(result));
+                    if (result["n"].numberLong() == 0) {
+                        bucketChanged = true;
+                    }
+                }
+            }
+        }
+    }
+
     /**
      * Kills all tenant migrations active on this node, for both donors and recipients.
      * Called after reaching an upgrading or downgrading state.
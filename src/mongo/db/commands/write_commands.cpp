@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/mutable/document.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/doc_validation_error.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -65,11 +68,15 @@
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/db/timeseries/timeseries_update_delete_util.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/logv2/log.h"
 #include "mongo/logv2/redaction.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
@@ -123,9 +130,6 @@ bool isTimeseries(OperationContext* opCtx, const NamespaceString& ns) {
         .get();
 }
 
-// Default for control.version in time-series bucket collection.
-const int kTimeseriesControlVersion = 1;
-
 /**
  * Transforms a single time-series insert to an update request on an existing bucket.
  */
@@ -222,7 +226,8 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     builder.append("_id", batch->bucket()->id());
     {
         BSONObjBuilder bucketControlBuilder(builder.subobjStart("control"));
-        bucketControlBuilder.append("version", kTimeseriesControlVersion);
+        bucketControlBuilder.append(timeseries::kBucketControlVersionFieldName,
+                                    timeseries::kTimeseriesControlDefaultVersion);
         bucketControlBuilder.append("min", batch->min());
         bucketControlBuilder.append("max", batch->max());
     }
@@ -628,6 +633,83 @@ public:
                 OperationSource::kTimeseriesInsert));
         }
 
+        /**
+         * Rewrites a bucket which has been closed by the bucket catalog in the compressed column
+         * format. Compression is best effort: if the bucket cannot be read or compressed, or the
+         * replacement fails, the bucket is left uncompressed and remains fully readable.
+         *
+         * Compressed buckets can only be read by 5.1 binaries, so nothing is compressed unless the
+         * FCV is fully upgraded. setFCV decompresses them again on downgrade.
+         */
+        void _performTimeseriesBucketCompression(
+            OperationContext* opCtx, const BucketCatalog::ClosedBucket& closedBucket) const {
+            if (!gTimeseriesBucketCompression.load() || closedBucket.numMeasurements <= 1) {
+                return;
+            }
+
+            auto bucketsNs = ns().makeTimeseriesBucketsNamespace();
+            auto query = BSON(timeseries::kBucketIdFieldName << closedBucket.bucketId);
+
+            try {
+                // Holding the global lock in IX mode across the FCV check and the replacement
+                // ensures that setFCV's global S barrier waits for this compression to finish
+                // before it decompresses buckets for downgrade.
+                Lock::GlobalLock globalLock(opCtx, MODE_IX);
+                if (!serverGlobalParams.featureCompatibility.isVersionInitialized() ||
+                    !serverGlobalParams.featureCompatibility.isGreaterThanOrEqualTo(
+                        ServerGlobalParams::FeatureCompatibility::Version::kVersion51)) {
+                    return;
+                }
+
+                BSONObj bucketDoc;
+                {
+                    AutoGetCollection bucketsColl(opCtx, bucketsNs, MODE_IS);
+                    if (!bucketsColl ||
+                        !Helpers::findOne(opCtx, bucketsColl.getCollection(), query, bucketDoc)) {
+                        return;
+                    }
+                }
+
+                auto compressed = timeseries::compressBucket(bucketDoc, closedBucket.timeField);
+                if (!compressed) {
+                    return;
+                }
+
+                // The bucket is read and replaced under separate locks, so the replacement only
+                // applies to the exact version that was compressed. If anything wrote to the
+                // bucket in between, the update matches nothing and the newer bucket is kept.
+                BSONObjBuilder filter;
+                filter.append(bucketDoc[timeseries::kBucketIdFieldName]);
+                filter.append(bucketDoc[timeseries::kBucketControlFieldName]);
+                filter.append(bucketDoc[timeseries::kBucketDataFieldName]);
+
+                write_ops::UpdateOpEntry update(
+                    filter.obj(),
+                    write_ops::UpdateModification::parseFromClassicUpdate(*compressed));
+                write_ops::UpdateCommandRequest op(bucketsNs, {update});
+
+                // The compression is not part of any user statement, so it must not be recorded
+                // as one for retryable writes.
+                op.setWriteCommandRequestBase(
+                    _makeTimeseriesWriteOpBase(std::vector<StmtId>{kUninitializedStmtId}));
+                write_ops_exec::performUpdates(opCtx, op, OperationSource::kTimeseriesInsert);
+            } catch (const DBException& ex) {
+                // An interrupted operation or a lost primary must still fail the insert, as any
+                // later write would. Any other failure leaves the bucket in its uncompressed form.
+                if (ErrorCodes::isInterruption(ex.code()) ||
+                    ErrorCodes::isNotPrimaryError(ex.code())) {
+                    throw;
+                }
+                opCtx->checkForInterrupt();
+                LOGV2_DEBUG(6100200,
+                            1,
+                            "Failed to compress time-series bucket",
+                            "bucketId"_attr = closedBucket.bucketId,
+                            "namespace"_attr = bucketsNs,
+                            "error"_attr = redact(ex.toStatus()));
+            }
+        }
+
         void _commitTimeseriesBucket(OperationContext* opCtx,
                                      std::shared_ptr<BucketCatalog::WriteBatch> batch,
                                      size_t start,
@@ -639,7 +721,7 @@ public:
                                      std::vector<size_t>* docsToRetry) const {
             auto& bucketCatalog = BucketCatalog::get(opCtx);
 
-            auto metadata = bucketCatalog.getMetadata(batch->bucket());
+            auto metadata = bucketCatalog.getMetadata(batch);
             bool prepared = bucketCatalog.prepareCommit(batch);
             if (!prepared) {
                 invariant(batch->finished());
@@ -689,8 +771,13 @@ public:
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
-            bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+            auto closedBucket =
+                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
             batchGuard.dismiss();
+
+            if (closedBucket) {
+                _performTimeseriesBucketCompression(opCtx, *closedBucket);
+            }
         }
 
         bool _commitTimeseriesBucketsAtomically(OperationContext* opCtx,
@@ -723,7 +810,7 @@ public:
             std::vector<write_ops::UpdateCommandRequest> updateOps;
 
             for (auto batch : batchesToCommit) {
-                auto metadata = bucketCatalog.getMetadata(batch.get()->bucket());
+                auto metadata = bucketCatalog.getMetadata(batch.get());
                 if (!bucketCatalog.prepareCommit(batch)) {
                     for (auto batchToAbort : batchesToCommit) {
                         bucketCatalog.abort(batchToAbort);
@@ -753,11 +840,19 @@ public:
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
+            std::vector<BucketCatalog::ClosedBucket> closedBuckets;
             for (auto batch : batchesToCommit) {
-                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                if (auto closedBucket = bucketCatalog.finish(
+                        batch, BucketCatalog::CommitInfo{*opTime, *electionId})) {
+                    closedBuckets.push_back(std::move(*closedBucket));
+                }
                 batch.get().reset();
             }
 
+            for (const auto& closedBucket : closedBuckets) {
+                _performTimeseriesBucketCompression(opCtx, closedBucket);
+            }
+
             return true;
         }
 
@@ -933,24 +1028,54 @@ public:
 
             std::vector<size_t> docsToRetry;
 
-            for (auto& [batch, index] : batches) {
-                if (batch->claimCommitRights()) {
-                    auto stmtIds = isTimeseriesWriteRetryable(opCtx)
-                        ? std::move(bucketStmtIds[batch->bucket()])
-                        : std::vector<StmtId>{};
-
-                    _commitTimeseriesBucket(opCtx,
-                                            batch,
-                                            start,
-                                            index,
-                                            std::move(stmtIds),
-                                            errors,
-                                            opTime,
-                                            electionId,
-                                            &docsToRetry);
-                    batch.reset();
+            // Claim the batches up front and give concurrent inserts from other clients a chance
+            // to join them, so that they are written by a single bucket update. Those clients
+            // will then wait for our commit rather than committing themselves.
+            auto& bucketCatalog = BucketCatalog::get(opCtx);
+            std::vector<size_t> claimedBatches;
+            Microseconds groupCommitDelay{0};
+            for (size_t i = 0; i < batches.size(); ++i) {
+                if (batches[i].first->claimCommitRights()) {
+                    claimedBatches.push_back(i);
+                    groupCommitDelay = std::max(
+                        groupCommitDelay, bucketCatalog.getGroupCommitDelay(batches[i].first));
                 }
             }
+            if (groupCommitDelay > Microseconds{0}) {
+                // The sleep must not be interrupted, since the batches cannot be committed by
+                // anyone else once we hold their commit rights.
+                sleepFor(groupCommitDelay);
+            }
+
+            // If we throw, release the batches we claimed but did not get to, so the clients
+            // which joined them are not left waiting.
+            auto claimedBatchesGuard = makeGuard([&] {
+                for (auto i : claimedBatches) {
+                    auto& batch = batches[i].first;
+                    if (batch && !batch->finished()) {
+                        bucketCatalog.abort(batch);
+                    }
+                }
+            });
+
+            for (auto i : claimedBatches) {
+                auto& [batch, index] = batches[i];
+                auto stmtIds = isTimeseriesWriteRetryable(opCtx)
+                    ? std::move(bucketStmtIds[batch->bucket()])
+                    : std::vector<StmtId>{};
+
+                _commitTimeseriesBucket(opCtx,
+                                        batch,
+                                        start,
+                                        index,
+                                        std::move(stmtIds),
+                                        errors,
+                                        opTime,
+                                        electionId,
+                                        &docsToRetry);
+                batch.reset();
+            }
+            claimedBatchesGuard.dismiss();
 
             _getTimeseriesBatchResults(opCtx, batches, 0, errors, opTime, electionId, &docsToRetry);
 
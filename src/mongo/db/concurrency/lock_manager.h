@@ -34,6 +34,8 @@
 #include <map>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/config.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
@@ -175,7 +177,7 @@ private:
 
     struct LockBucket {
         SimpleMutex mutex;
-        typedef stdx::unordered_map<ResourceId, LockHead*> Map;
+        typedef absl::flat_hash_map<ResourceId, LockHead*> Map;
         Map data;
         LockHead* findOrInsert(ResourceId resId);
     };
@@ -186,7 +188,7 @@ private:
     struct Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
-        typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
+        typedef absl::flat_hash_map<ResourceId, PartitionedLockHead*> Map;
         SimpleMutex mutex;
         Map data;
     };
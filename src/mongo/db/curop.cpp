@@ -912,6 +912,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("writeConcern", writeConcern->toBSON());
     }
 
+    if (waitForWriteConcernDurationMillis > Milliseconds::zero()) {
+        pAttrs->add("waitForWriteConcernDuration", waitForWriteConcernDurationMillis);
+    }
+
     if (storageStats) {
         pAttrs->add("storage", storageStats->toBSON());
     }
@@ -1056,6 +1060,11 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("writeConcern", writeConcern->toBSON());
     }
 
+    if (waitForWriteConcernDurationMillis > Milliseconds::zero()) {
+        b.append("waitForWriteConcernDurationMillis",
+                 durationCount<Milliseconds>(waitForWriteConcernDurationMillis));
+    }
+
     if (storageStats) {
         b.append("storage", storageStats->toBSON());
     }
@@ -1326,6 +1335,12 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("waitForWriteConcernDurationMillis", [](auto field, auto args, auto& b) {
+        if (args.op.waitForWriteConcernDurationMillis > Milliseconds::zero()) {
+            b.append(field, durationCount<Milliseconds>(args.op.waitForWriteConcernDurationMillis));
+        }
+    });
+
     addIfNeeded("storage", [](auto field, auto args, auto& b) {
         if (args.op.storageStats) {
             b.append(field, args.op.storageStats->toBSON());
@@ -288,6 +288,9 @@ public:
     // because it's only set while the Command itself executes.)
     boost::optional<WriteConcernOptions> writeConcern;
 
+    // Stores the duration of time spent in waitForWriteConcern after the command ran.
+    Milliseconds waitForWriteConcernDurationMillis{0};
+
     // Whether this is an oplog getMore operation for replication oplog fetching.
     bool isReplOplogGetMore{false};
 
@@ -292,12 +292,13 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // WSM with no record id.
         invariant(member->hasRecordId());
 
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        DataMap::iterator it = _dataMap.find(member->recordId);
+        if (_dataMap.end() == it) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
             _seenMap.insert(member->recordId);
-            WorkingSetID olderMemberID = _dataMap[member->recordId];
+            WorkingSetID olderMemberID = it->second;
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
 
@@ -30,9 +30,113 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/bucket_unpacker.h"
+
+#include <cmath>
+#include <functional>
+
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 
 namespace mongo {
+namespace {
+
+// Integers up to this magnitude convert to double without loss of precision.
+constexpr long long kMaxExactDoubleInteger = 1LL << 53;
+
+template <typename T, typename Compare>
+void selectRowsWith(Compare cmp,
+                    const std::vector<T>& operands,
+                    const std::vector<uint8_t>& compared,
+                    T constant,
+                    std::vector<uint8_t>* selected) {
+    // Kept branch-free so that the compiler can vectorize the loop. Rows which do not take part in
+    // the comparison keep their current selection.
+    auto n = selected->size();
+    auto sel = selected->data();
+    for (size_t i = 0; i < n; ++i) {
+        sel[i] &= static_cast<uint8_t>(!compared[i] | cmp(operands[i], constant));
+    }
+}
+
+template <typename T>
+void selectRows(BucketUnpackerColumnFilter::Op op,
+                const std::vector<T>& operands,
+                const std::vector<uint8_t>& compared,
+                T constant,
+                std::vector<uint8_t>* selected) {
+    switch (op) {
+        case BucketUnpackerColumnFilter::Op::kEq:
+            return selectRowsWith(std::equal_to<T>{}, operands, compared, constant, selected);
+        case BucketUnpackerColumnFilter::Op::kLt:
+            return selectRowsWith(std::less<T>{}, operands, compared, constant, selected);
+        case BucketUnpackerColumnFilter::Op::kLte:
+            return selectRowsWith(std::less_equal<T>{}, operands, compared, constant, selected);
+        case BucketUnpackerColumnFilter::Op::kGt:
+            return selectRowsWith(std::greater<T>{}, operands, compared, constant, selected);
+        case BucketUnpackerColumnFilter::Op::kGte:
+            return selectRowsWith(std::greater_equal<T>{}, operands, compared, constant, selected);
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool satisfies(BucketUnpackerColumnFilter::Op op, int cmp) {
+    switch (op) {
+        case BucketUnpackerColumnFilter::Op::kEq:
+            return cmp == 0;
+        case BucketUnpackerColumnFilter::Op::kLt:
+            return cmp < 0;
+        case BucketUnpackerColumnFilter::Op::kLte:
+            return cmp <= 0;
+        case BucketUnpackerColumnFilter::Op::kGt:
+            return cmp > 0;
+        case BucketUnpackerColumnFilter::Op::kGte:
+            return cmp >= 0;
+    }
+    MONGO_UNREACHABLE;
+}
+
+/**
+ * Returns the value of a numeric element as a double if the conversion is exact and preserves
+ * its ordering against other numbers.
+ */
+boost::optional<double> exactDouble(const Value& value) {
+    switch (value.getType()) {
+        case NumberInt:
+            return value.getInt();
+        case NumberLong: {
+            auto l = value.getLong();
+            if (l < -kMaxExactDoubleInteger || l > kMaxExactDoubleInteger) {
+                return boost::none;
+            }
+            return static_cast<double>(l);
+        }
+        case NumberDouble: {
+            auto d = value.getDouble();
+            if (std::isnan(d)) {
+                return boost::none;
+            }
+            return d;
+        }
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+bool BucketUnpackerColumnFilter::isSupportedConstant(const BSONElement& constant) {
+    switch (constant.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+            return exactDouble(Value{constant}).has_value();
+        case Date:
+        case jstOID:
+            return true;
+        default:
+            return false;
+    }
+}
 
 /**
  * Erase computed meta projection fields if they are present in the exclusion field set.
@@ -85,12 +189,50 @@ int BucketUnpacker::computeMeasurementCount(int targetTimestampObjSize) {
         ((targetTimestampObjSize - currentInterval->second) / (10 + nDigitsInRowKey));
 }
 
+BucketUnpacker::ColumnCursor::ColumnCursor(BSONElement column, bool compressed, int32_t numRows)
+    : _compressed(compressed), _rowsRemaining(numRows) {
+    if (_compressed) {
+        _columnIter = BSONColumn(column).begin();
+    } else {
+        _objIter = BSONObjIterator{column.Obj()};
+    }
+}
+
+BSONElement BucketUnpacker::ColumnCursor::next() {
+    if (!_compressed) {
+        return _objIter->next();
+    }
+    return nextForRow(""_sd);
+}
+
+BSONElement BucketUnpacker::ColumnCursor::nextForRow(StringData rowKey) {
+    if (!_compressed) {
+        if (auto&& elem = **_objIter; _objIter->more() && elem.fieldNameStringData() == rowKey) {
+            _objIter->advance(elem);
+            return elem;
+        }
+        return BSONElement();
+    }
+
+    if (_rowsRemaining <= 0) {
+        return BSONElement();
+    }
+    if (_advancePending) {
+        ++*_columnIter;
+    }
+    _advancePending = true;
+    --_rowsRemaining;
+    return _columnIter->more() ? **_columnIter : BSONElement();
+}
+
 void BucketUnpacker::reset(BSONObj&& bucket) {
-    _fieldIters.clear();
-    _timeFieldIter = boost::none;
+    _fieldColumns.clear();
+    _timeColumn = boost::none;
+    _rowsRead = 0;
 
     _bucket = std::move(bucket);
     uassert(5346510, "An empty bucket cannot be unpacked", !_bucket.isEmpty());
+    _compressed = timeseries::isCompressedBucket(_bucket);
 
     auto&& dataRegion = _bucket.getField(timeseries::kBucketDataFieldName).Obj();
     if (dataRegion.isEmpty()) {
@@ -104,7 +246,12 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
             "The $_internalUnpackBucket stage requires the data region to have a timeField object",
             timeFieldElem);
 
-    _timeFieldIter = BSONObjIterator{timeFieldElem.Obj()};
+    // Save the measurement count for the bucket. Compressed columns do not store row keys, so their
+    // length is read from the Simple-8b selectors instead of being derived from the object size.
+    _numberOfMeasurements = _compressed ? BSONColumn(timeFieldElem).size()
+                                        : computeMeasurementCount(timeFieldElem.Obj().objsize());
+
+    _timeColumn.emplace(timeFieldElem, _compressed, _numberOfMeasurements);
 
     _metaValue = _bucket[timeseries::kBucketMetaFieldName];
     if (_spec.metaField) {
@@ -137,7 +284,10 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         // Includes a field when '_unpackerBehavior' is 'kInclude' and it's found in 'fieldSet' or
         // _unpackerBehavior is 'kExclude' and it's not found in 'fieldSet'.
         if (determineIncludeField(colName, _unpackerBehavior, _spec)) {
-            _fieldIters.emplace_back(colName.toString(), BSONObjIterator{elem.Obj()});
+            _fieldColumns.emplace_back(
+                std::piecewise_construct,
+                std::forward_as_tuple(colName.toString()),
+                std::forward_as_tuple(elem, _compressed, _numberOfMeasurements));
         }
     }
 
@@ -148,8 +298,6 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         }
     }
 
-    // Save the measurement count for the bucket.
-    _numberOfMeasurements = computeMeasurementCount(timeFieldElem.objsize());
 }
 
 void BucketUnpacker::setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior) {
@@ -178,12 +326,22 @@ void BucketUnpacker::addComputedMetaProjFields(const std::vector<StringData>& co
     }
 }
 
+int BucketUnpacker::_currentRowIndex(StringData timeRowKey) const {
+    if (_compressed) {
+        return _rowsRead - 1;
+    }
+    int rowIndex;
+    uassertStatusOK(NumberParser()(timeRowKey, &rowIndex));
+    return rowIndex;
+}
+
 Document BucketUnpacker::getNext() {
     tassert(5521503, "'getNext()' requires the bucket to be owned", _bucket.isOwned());
     tassert(5422100, "'getNext()' was called after the bucket has been exhausted", hasNext());
 
     auto measurement = MutableDocument{};
-    auto&& timeElem = _timeFieldIter->next();
+    auto&& timeElem = _timeColumn->next();
+    ++_rowsRead;
     if (_includeTimeField) {
         measurement.addField(_spec.timeField, Value{timeElem});
     }
@@ -194,10 +352,9 @@ Document BucketUnpacker::getNext() {
     }
 
     auto& currentIdx = timeElem.fieldNameStringData();
-    for (auto&& [colName, colIter] : _fieldIters) {
-        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
+    for (auto&& [colName, column] : _fieldColumns) {
+        if (auto&& elem = column.nextForRow(currentIdx)) {
             measurement.addField(colName, Value{elem});
-            colIter.advance(elem);
         }
     }
 
@@ -209,15 +366,172 @@ Document BucketUnpacker::getNext() {
     if (_spec.includeBucketIdAndRowIndex) {
         MutableDocument nestedMeasurement{};
         nestedMeasurement.addField("bucketId", Value{_bucket[timeseries::kBucketIdFieldName]});
-        int rowIndex;
-        uassertStatusOK(NumberParser()(currentIdx, &rowIndex));
-        nestedMeasurement.addField("rowIndex", Value{rowIndex});
+        nestedMeasurement.addField("rowIndex", Value{_currentRowIndex(currentIdx)});
         nestedMeasurement.addField("rowData", measurement.freezeToValue());
         return nestedMeasurement.freeze();
     }
     return measurement.freeze();
 }
 
+size_t BucketUnpacker::getNextBatch(size_t maxBatchSize, std::vector<Document>* batch) {
+    tassert(6100300, "'getNextBatch()' requires the bucket to be owned", _bucket.isOwned());
+    tassert(6100301, "'getNextBatch()' was called after the bucket has been exhausted", hasNext());
+
+    // Decode the time column first, as it determines the rows making up this batch. The row keys
+    // point into the owned bucket and remain valid while the other columns are read.
+    _batchTimeValues.clear();
+    _batchRowKeys.clear();
+    while (_batchTimeValues.size() < maxBatchSize && _timeColumn->more()) {
+        auto&& timeElem = _timeColumn->next();
+        _batchTimeValues.emplace_back(timeElem);
+        _batchRowKeys.push_back(timeElem.fieldNameStringData());
+    }
+    auto numRows = _batchTimeValues.size();
+    auto firstRowIndex = _rowsRead;
+    _rowsRead += numRows;
+
+    // Decode every unpacked column for the rows of this batch. Missing values stay missing and are
+    // not materialized in the Documents.
+    _batchFieldValues.resize(_fieldColumns.size());
+    for (size_t col = 0; col < _fieldColumns.size(); ++col) {
+        auto& column = _fieldColumns[col].second;
+        auto& values = _batchFieldValues[col];
+        values.clear();
+        values.reserve(numRows);
+        for (size_t row = 0; row < numRows; ++row) {
+            auto&& elem = column.nextForRow(_batchRowKeys[row]);
+            values.push_back(elem ? Value{elem} : Value{});
+        }
+    }
+
+    // Evaluate the column filters over the decoded values, so that only selected measurements
+    // are materialized.
+    _batchSelected.assign(numRows, 1);
+    for (auto&& filter : _columnFilters) {
+        _applyColumnFilter(filter);
+    }
+
+    size_t numAppended = 0;
+    for (size_t row = 0; row < numRows; ++row) {
+        if (!_batchSelected[row]) {
+            continue;
+        }
+        ++numAppended;
+
+        auto measurement = MutableDocument{};
+        if (_includeTimeField) {
+            measurement.addField(_spec.timeField, std::move(_batchTimeValues[row]));
+        }
+
+        // Includes metaField when we're instructed to do so and metaField value exists.
+        if (_includeMetaField && _metaValue) {
+            measurement.addField(*_spec.metaField, Value{_metaValue});
+        }
+
+        for (size_t col = 0; col < _fieldColumns.size(); ++col) {
+            if (auto& value = _batchFieldValues[col][row]; !value.missing()) {
+                measurement.addField(_fieldColumns[col].first, std::move(value));
+            }
+        }
+
+        // Add computed meta projections.
+        for (auto&& name : _spec.computedMetaProjFields) {
+            measurement.addField(name, Value{_computedMetaProjections[name]});
+        }
+
+        if (_spec.includeBucketIdAndRowIndex) {
+            MutableDocument nestedMeasurement{};
+            nestedMeasurement.addField("bucketId", Value{_bucket[timeseries::kBucketIdFieldName]});
+            auto rowIndex = _compressed ? static_cast<int>(firstRowIndex + row)
+                                        : _currentRowIndex(_batchRowKeys[row]);
+            nestedMeasurement.addField("rowIndex", Value{rowIndex});
+            nestedMeasurement.addField("rowData", measurement.freezeToValue());
+            batch->push_back(nestedMeasurement.freeze());
+        } else {
+            batch->push_back(measurement.freeze());
+        }
+    }
+    return numAppended;
+}
+
+void BucketUnpacker::_applyColumnFilter(const BucketUnpackerColumnFilter& filter) {
+    // Locate the decoded values of the filtered field. A field which is not materialized in the
+    // unpacked measurements is missing from all of them, so none of them can match.
+    const std::vector<Value>* values = nullptr;
+    if (filter.fieldName == _spec.timeField) {
+        if (_includeTimeField) {
+            values = &_batchTimeValues;
+        }
+    } else {
+        for (size_t col = 0; col < _fieldColumns.size(); ++col) {
+            if (_fieldColumns[col].first == filter.fieldName) {
+                values = &_batchFieldValues[col];
+                break;
+            }
+        }
+    }
+    if (!values) {
+        std::fill(_batchSelected.begin(), _batchSelected.end(), 0);
+        return;
+    }
+
+    // Arrays may match through one of their elements, and some numbers cannot be compared exactly
+    // as doubles, so such rows are kept for the full predicate. Other values of a different type
+    // than the constant never match a comparison.
+    auto numRows = _batchSelected.size();
+    _batchCompared.assign(numRows, 0);
+    switch (filter.constant.getType()) {
+        case jstOID: {
+            auto constant = filter.constant.getOid();
+            for (size_t row = 0; row < numRows; ++row) {
+                auto& value = (*values)[row];
+                if (value.getType() == jstOID) {
+                    _batchSelected[row] &= satisfies(filter.op, value.getOid().compare(constant));
+                } else if (value.getType() != Array) {
+                    _batchSelected[row] = 0;
+                }
+            }
+            return;
+        }
+        case Date: {
+            _batchLongOperands.assign(numRows, 0);
+            for (size_t row = 0; row < numRows; ++row) {
+                auto& value = (*values)[row];
+                if (value.getType() == Date) {
+                    _batchLongOperands[row] = value.getDate().toMillisSinceEpoch();
+                    _batchCompared[row] = 1;
+                } else if (value.getType() != Array) {
+                    _batchSelected[row] = 0;
+                }
+            }
+            selectRows(filter.op,
+                       _batchLongOperands,
+                       _batchCompared,
+                       filter.constant.getDate().toMillisSinceEpoch(),
+                       &_batchSelected);
+            return;
+        }
+        default: {
+            _batchDoubleOperands.assign(numRows, 0);
+            for (size_t row = 0; row < numRows; ++row) {
+                auto& value = (*values)[row];
+                if (auto d = exactDouble(value)) {
+                    _batchDoubleOperands[row] = *d;
+                    _batchCompared[row] = 1;
+                } else if (!value.numeric() && value.getType() != Array) {
+                    _batchSelected[row] = 0;
+                }
+            }
+            selectRows(filter.op,
+                       _batchDoubleOperands,
+                       _batchCompared,
+                       *exactDouble(filter.constant),
+                       &_batchSelected);
+            return;
+        }
+    }
+}
+
 Document BucketUnpacker::extractSingleMeasurement(int j) {
     tassert(5422101,
             "'extractSingleMeasurment' expects j to be greater than or equal to zero and less than "
@@ -239,6 +553,13 @@ Document BucketUnpacker::extractSingleMeasurement(int j) {
         if (!determineIncludeField(colName, _unpackerBehavior, _spec)) {
             continue;
         }
+        if (_compressed) {
+            auto it = BSONColumn(dataElem).seek(j);
+            if (it.more() && *it) {
+                measurement.addField(colName, Value{*it});
+            }
+            continue;
+        }
         auto value = dataElem[targetIdx];
         if (value) {
             measurement.addField(dataElem.fieldNameStringData(), Value{value});
@@ -33,6 +33,7 @@
 #include <set>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/bsoncolumn.h"
 #include "mongo/db/exec/document_value/document.h"
 
 namespace mongo {
@@ -61,6 +62,25 @@ struct BucketSpec {
     bool includeBucketIdAndRowIndex = false;
 };
 
+/**
+ * A comparison of a top-level measurement field against a numeric, date or ObjectId constant,
+ * which the BucketUnpacker evaluates on decoded column values before materializing measurements.
+ * Evaluation is conservative: a measurement is only discarded when the comparison cannot be
+ * satisfied under match semantics, so the original predicate must still be applied afterwards.
+ */
+struct BucketUnpackerColumnFilter {
+    enum class Op { kEq, kLt, kLte, kGt, kGte };
+
+    /**
+     * Returns true if a comparison against 'constant' can be evaluated by the BucketUnpacker.
+     */
+    static bool isSupportedConstant(const BSONElement& constant);
+
+    std::string fieldName;
+    Op op;
+    Value constant;
+};
+
 /**
  * BucketUnpacker will unpack bucket fields for metadata and the provided fields.
  */
@@ -105,6 +125,16 @@ public:
      */
     Document getNext();
 
+    /**
+     * Reads up to 'maxBatchSize' of the remaining measurements in the bucket and appends those
+     * passing the column filters to 'batch'. The values of each unpacked field are first decoded
+     * column by column into per-field arrays, the column filters are evaluated over these arrays,
+     * and only the selected measurements are assembled into Documents. Returns the number of
+     * measurements appended, which may be zero even if measurements were read. A precondition of
+     * this method is that 'hasNext()' must be true.
+     */
+    size_t getNextBatch(size_t maxBatchSize, std::vector<Document>* batch);
+
     /**
      * This method will extract the j-th measurement from the bucket. A precondition of this method
      * is that j >= 0 && j <= the number of measurements within the underlying bucket.
@@ -112,7 +142,7 @@ public:
     Document extractSingleMeasurement(int j);
 
     bool hasNext() const {
-        return _timeFieldIter && _timeFieldIter->more();
+        return _timeColumn && _timeColumn->more();
     }
 
     /**
@@ -149,12 +179,73 @@ public:
     // Add computed meta projection names to the bucket specification.
     void addComputedMetaProjFields(const std::vector<StringData>& computedFieldNames);
 
+    /**
+     * Adds a filter evaluated by 'getNextBatch()' on the measurements it materializes. Filters are
+     * not applied by 'getNext()' or 'extractSingleMeasurement()'.
+     */
+    void addColumnFilter(BucketUnpackerColumnFilter filter) {
+        _columnFilters.push_back(std::move(filter));
+    }
+
+    const std::vector<BucketUnpackerColumnFilter>& columnFilters() const {
+        return _columnFilters;
+    }
+
 private:
+    /**
+     * Reads the values of a single data column in row order. An uncompressed bucket stores a
+     * column as an object keyed by row index which omits missing values, while a compressed bucket
+     * stores it as a BSONColumn binary where every row is present and missing values are EOO.
+     */
+    class ColumnCursor {
+    public:
+        ColumnCursor(BSONElement column, bool compressed, int32_t numRows);
+
+        bool more() const {
+            return _compressed ? _rowsRemaining > 0 : _objIter->more();
+        }
+
+        /**
+         * Returns the value of the next row and advances the cursor. Only used for the time
+         * column, which holds a value for every row.
+         */
+        BSONElement next();
+
+        /**
+         * Returns the value of the row identified by 'rowKey', or EOO if the column is missing a
+         * value for this row. Rows must be requested in the order of the time column. The row key
+         * is only used for uncompressed columns, as compressed columns store every row.
+         */
+        BSONElement nextForRow(StringData rowKey);
+
+    private:
+        bool _compressed;
+        boost::optional<BSONObjIterator> _objIter;
+        boost::optional<BSONColumn::Iterator> _columnIter;
+
+        // Elements returned by a BSONColumn iterator are only valid until it is advanced, so the
+        // compressed cursor advances lazily on the next read.
+        bool _advancePending = false;
+        int32_t _rowsRemaining = 0;
+    };
+
+    // Returns the row index of the measurement that was just read from the time column.
+    int _currentRowIndex(StringData timeRowKey) const;
+
+    // Clears '_batchSelected' for the rows of the current batch that fail 'filter'.
+    void _applyColumnFilter(const BucketUnpackerColumnFilter& filter);
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
-    // Iterates the timestamp section of the bucket to drive the unpacking iteration.
-    boost::optional<BSONObjIterator> _timeFieldIter;
+    // Reads the timestamp section of the bucket to drive the unpacking iteration.
+    boost::optional<ColumnCursor> _timeColumn;
+
+    // Whether the bucket being unpacked stores its data fields as compressed BSONColumn binaries.
+    bool _compressed = false;
+
+    // The number of measurements that have been read from the time column of the bucket.
+    int32_t _rowsRead = 0;
 
     // A flag used to mark that the timestamp value should be materialized in measurements.
     bool _includeTimeField;
@@ -170,9 +261,23 @@ private:
     // measurement.
     BSONElement _metaValue;
 
-    // Iterators used to unpack the columns of the above bucket that are populated during the reset
+    // Cursors used to unpack the columns of the above bucket that are populated during the reset
     // phase according to the provided 'Behavior' and 'BucketSpec'.
-    std::vector<std::pair<std::string, BSONObjIterator>> _fieldIters;
+    std::vector<std::pair<std::string, ColumnCursor>> _fieldColumns;
+
+    // Per-field value arrays filled by 'getNextBatch()', kept across calls to reuse their memory.
+    std::vector<Value> _batchTimeValues;
+    std::vector<StringData> _batchRowKeys;
+    std::vector<std::vector<Value>> _batchFieldValues;
+
+    // Filters evaluated on the decoded values of a batch, and the scratch space used to evaluate
+    // them: whether each row is still selected, whether its value takes part in the comparison,
+    // and the comparison operands.
+    std::vector<BucketUnpackerColumnFilter> _columnFilters;
+    std::vector<uint8_t> _batchSelected;
+    std::vector<uint8_t> _batchCompared;
+    std::vector<double> _batchDoubleOperands;
+    std::vector<long long> _batchLongOperands;
 
     // Map <name, BSONElement> for the computed meta field projections. Updated for
     // every bucket upon reset().
@@ -32,6 +32,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -77,6 +78,37 @@ public:
     void assertGetNext(BucketUnpacker& unpacker, const Document& expected) {
         ASSERT_DOCUMENT_EQ(unpacker.getNext(), expected);
     }
+
+    /**
+     * Unpacks 'bucket' one measurement at a time with 'getNext()' and in batches of 'batchSize'
+     * with 'getNextBatch()', and asserts that both produce the 'expected' measurements.
+     */
+    void assertUnpacksTo(const BucketSpec& spec,
+                         BucketUnpacker::Behavior behavior,
+                         const BSONObj& bucket,
+                         const std::vector<Document>& expected,
+                         size_t batchSize = 2) {
+        BucketUnpacker rowUnpacker{spec, behavior};
+        rowUnpacker.reset(bucket.getOwned());
+        for (auto&& doc : expected) {
+            ASSERT_TRUE(rowUnpacker.hasNext());
+            assertGetNext(rowUnpacker, doc);
+        }
+        ASSERT_FALSE(rowUnpacker.hasNext());
+
+        BucketUnpacker batchUnpacker{spec, behavior};
+        batchUnpacker.reset(bucket.getOwned());
+        std::vector<Document> batch;
+        while (batchUnpacker.hasNext()) {
+            auto numUnpacked = batchUnpacker.getNextBatch(batchSize, &batch);
+            ASSERT_GT(numUnpacked, 0u);
+            ASSERT_LTE(numUnpacked, batchSize);
+        }
+        ASSERT_EQ(batch.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_DOCUMENT_EQ(batch[i], expected[i]);
+        }
+    }
 };
 
 TEST_F(BucketUnpackerTest, UnpackBasicIncludeAllMeasurementFields) {
@@ -386,6 +418,141 @@ TEST_F(BucketUnpackerTest, UnpackerResetThrowsOnEmptyBucket) {
                              5346510);
 }
 
+TEST_F(BucketUnpackerTest, GetNextBatchMatchesGetNext) {
+    auto bucket = fromjson(
+        "{meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2, '2':3}, time: {'0':1, '1':2, "
+        "'2':3}, a:{'0':1, '2':3}, b:{'1':1}}}");
+    auto meta = Document{{"m1", 999}, {"m2", 9999}};
+
+    auto includeSpec = BucketSpec{kUserDefinedTimeName.toString(),
+                                  kUserDefinedMetaName.toString(),
+                                  {kUserDefinedTimeName.toString(), "b"}};
+    assertUnpacksTo(includeSpec,
+                    BucketUnpacker::Behavior::kInclude,
+                    bucket,
+                    {Document{{"time", 1}}, Document{{"time", 2}, {"b", 1}}, Document{{"time", 3}}});
+
+    auto excludeSpec = BucketSpec{
+        kUserDefinedTimeName.toString(), kUserDefinedMetaName.toString(), {"_id", "b"}};
+    assertUnpacksTo(excludeSpec,
+                    BucketUnpacker::Behavior::kExclude,
+                    bucket,
+                    {Document{{"time", 1}, {"myMeta", meta}, {"a", 1}},
+                     Document{{"time", 2}, {"myMeta", meta}},
+                     Document{{"time", 3}, {"myMeta", meta}, {"a", 3}}});
+}
+
+TEST_F(BucketUnpackerTest, GetNextBatchIncludeBucketIdRowIndex) {
+    auto spec = BucketSpec{kUserDefinedTimeName.toString(), boost::none, {"a"}};
+    spec.includeBucketIdAndRowIndex = true;
+    auto bucket = fromjson("{_id: 0, data: {time: {'0':1, '1':2}, a:{'1':5}}}");
+
+    assertUnpacksTo(spec,
+                    BucketUnpacker::Behavior::kInclude,
+                    bucket,
+                    {Document{{"bucketId", 0}, {"rowIndex", 0}, {"rowData", Document{}}},
+                     Document{{"bucketId", 0}, {"rowIndex", 1}, {"rowData", Document{{"a", 5}}}}},
+                    10);
+}
+
+TEST_F(BucketUnpackerTest, UnpackCompressedBucket) {
+    auto d1 = dateFromISOString("2020-02-17T00:00:00.000Z").getValue();
+    auto d2 = dateFromISOString("2020-02-17T01:00:00.000Z").getValue();
+    auto d3 = dateFromISOString("2020-02-17T02:00:00.000Z").getValue();
+    auto bucket = BSON("_id" << 0 << "control" << BSON("version" << 1) << "meta"
+                             << BSON("m1" << 999) << "data"
+                             << BSON("time" << BSON("0" << d1 << "1" << d2 << "2" << d3) << "a"
+                                            << BSON("0" << 1 << "1" << 2 << "2" << 3) << "b"
+                                            << BSON("1"
+                                                    << "x")
+                                            << "c" << BSON("2" << 1.5)));
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT_TRUE(compressed);
+    ASSERT_TRUE(timeseries::isCompressedBucket(*compressed));
+
+    auto meta = Document{{"m1", 999}};
+    std::vector<Document> expected{
+        Document{{"time", d1}, {"myMeta", meta}, {"a", 1}},
+        Document{{"time", d2}, {"myMeta", meta}, {"a", 2}, {"b", "x"_sd}},
+        Document{{"time", d3}, {"myMeta", meta}, {"a", 3}}};
+    auto spec =
+        BucketSpec{kUserDefinedTimeName.toString(), kUserDefinedMetaName.toString(), {"c"}};
+    assertUnpacksTo(spec, BucketUnpacker::Behavior::kExclude, bucket, expected);
+    assertUnpacksTo(spec, BucketUnpacker::Behavior::kExclude, *compressed, expected);
+
+    // Single measurements are extracted by position from the columns.
+    spec.includeBucketIdAndRowIndex = true;
+    BucketUnpacker unpacker{spec, BucketUnpacker::Behavior::kExclude};
+    unpacker.reset(compressed->getOwned());
+    ASSERT_EQ(unpacker.numberOfMeasurements(), 3);
+    ASSERT_DOCUMENT_EQ(
+        unpacker.extractSingleMeasurement(1),
+        (Document{{"bucketId", 0},
+                  {"rowIndex", 1},
+                  {"rowData", Document{{"myMeta", meta}, {"time", d2}, {"a", 2}, {"b", "x"_sd}}}}));
+
+    unpacker.getNext();
+    ASSERT_DOCUMENT_EQ(unpacker.getNext(),
+                       (Document{{"bucketId", 0}, {"rowIndex", 1}, {"rowData", expected[1]}}));
+}
+
+TEST_F(BucketUnpackerTest, GetNextBatchAppliesColumnFilters) {
+    auto bucket = fromjson(
+        "{data: {time: {'0':1, '1':2, '2':3, '3':4, '4':5, '5':6}, "
+        "a:{'0':1, '1':5.5, '2':[1, 10], '3':'str', '4':{$numberLong: '7'}}}}");
+    auto spec = BucketSpec{kUserDefinedTimeName.toString(), boost::none, {}};
+
+    // Rows without 'a' or with a string are dropped, arrays are kept for the full predicate.
+    BucketUnpacker unpacker{spec, BucketUnpacker::Behavior::kExclude};
+    unpacker.addColumnFilter({"a", BucketUnpackerColumnFilter::Op::kGt, Value{2}});
+    unpacker.reset(bucket.getOwned());
+
+    std::vector<Document> batch;
+    ASSERT_EQ(unpacker.getNextBatch(3, &batch), 2u);
+    ASSERT_EQ(unpacker.getNextBatch(3, &batch), 1u);
+    ASSERT_FALSE(unpacker.hasNext());
+    ASSERT_EQ(batch.size(), 3u);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"time", 2}, {"a", 5.5}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"time", 3}, {"a", BSON_ARRAY(1 << 10)}}));
+    ASSERT_DOCUMENT_EQ(batch[2], (Document{{"time", 5}, {"a", 7LL}}));
+}
+
+TEST_F(BucketUnpackerTest, GetNextBatchCombinesColumnFilters) {
+    auto d1 = dateFromISOString("2020-02-17T00:00:00.000Z").getValue();
+    auto d2 = dateFromISOString("2020-02-17T01:00:00.000Z").getValue();
+    auto d3 = dateFromISOString("2020-02-17T02:00:00.000Z").getValue();
+    auto bucket = BSON("_id" << 0 << "control" << BSON("version" << 1) << "data"
+                             << BSON("time" << BSON("0" << d1 << "1" << d2 << "2" << d3) << "a"
+                                            << BSON("0" << 1 << "1" << 2 << "2" << 3)));
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT_TRUE(compressed);
+
+    for (auto&& b : {bucket, *compressed}) {
+        BucketUnpacker unpacker{BucketSpec{kUserDefinedTimeName.toString(), boost::none, {}},
+                                BucketUnpacker::Behavior::kExclude};
+        unpacker.addColumnFilter({"time", BucketUnpackerColumnFilter::Op::kGte, Value{d2}});
+        unpacker.addColumnFilter({"a", BucketUnpackerColumnFilter::Op::kLt, Value{3.0}});
+        unpacker.reset(b.getOwned());
+
+        std::vector<Document> batch;
+        ASSERT_EQ(unpacker.getNextBatch(10, &batch), 1u);
+        ASSERT_FALSE(unpacker.hasNext());
+        ASSERT_DOCUMENT_EQ(batch[0], (Document{{"time", d2}, {"a", 2}}));
+    }
+}
+
+TEST_F(BucketUnpackerTest, ColumnFilterOnExcludedFieldDropsAllMeasurements) {
+    auto bucket = fromjson("{data: {time: {'0':1, '1':2}, a:{'0':1, '1':2}}}");
+    BucketUnpacker unpacker{BucketSpec{kUserDefinedTimeName.toString(), boost::none, {"a"}},
+                            BucketUnpacker::Behavior::kExclude};
+    unpacker.addColumnFilter({"a", BucketUnpackerColumnFilter::Op::kEq, Value{1}});
+    unpacker.reset(bucket.getOwned());
+
+    std::vector<Document> batch;
+    ASSERT_EQ(unpacker.getNextBatch(10, &batch), 0u);
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
 TEST_F(BucketUnpackerTest, EraseMetaFromFieldSetAndDetermineIncludeMeta) {
     // Tests a missing 'metaField' in the spec.
     std::set<std::string> empFields{};
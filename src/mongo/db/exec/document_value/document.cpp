@@ -127,28 +127,30 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
     return false;
 }
 
-Position DocumentStorage::findFieldInCache(StringData requested) const {
-    int reqSize = requested.size();  // get size calculation out of the way if needed
+Position DocumentStorage::findFieldInHashTable(StringData requested, unsigned hash) const {
+    const int reqSize = requested.size();
+    const unsigned bucket = hash & _hashTabMask;
+
+    Position pos = _hashTab[bucket];
+    while (pos.found()) {
+        const ValueElement& elem = getField(pos);
+        if (elem.nameLen == reqSize && memcmp(requested.rawData(), elem._name, reqSize) == 0) {
+            return pos;
+        }
 
-    if (_numFields >= HASH_TAB_MIN) {  // hash lookup
-        const unsigned hash = hashKey(requested);
-        const unsigned bucket = hash & _hashTabMask;
+        // possible collision
+        pos = elem.nextCollision;
+    }
 
-        Position pos = _hashTab[bucket];
-        while (pos.found()) {
-            const ValueElement& elem = getField(pos);
-            if (elem.nameLen == reqSize && memcmp(requested.rawData(), elem._name, reqSize) == 0) {
-                return pos;
-            }
+    // if we got here, there's no such field
+    return Position();
+}
 
-            // possible collision
-            pos = elem.nextCollision;
-        }
-    } else {  // linear scan
-        for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
-            if (it->nameLen == reqSize && memcmp(requested.rawData(), it->_name, reqSize) == 0) {
-                return it.position();
-            }
+Position DocumentStorage::findFieldByScan(StringData requested) const {
+    const int reqSize = requested.size();
+    for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
+        if (it->nameLen == reqSize && memcmp(requested.rawData(), it->_name, reqSize) == 0) {
+            return it.position();
         }
     }
 
@@ -156,11 +158,35 @@ Position DocumentStorage::findFieldInCache(StringData requested) const {
     return Position();
 }
 
+Position DocumentStorage::findFieldInCache(StringData requested) const {
+    if (_numFields >= HASH_TAB_MIN) {
+        return findFieldInHashTable(requested, hashKey(requested));
+    }
+    return findFieldByScan(requested);
+}
+
+Position DocumentStorage::findFieldInCache(HashedFieldName requested) const {
+    if (_numFields >= HASH_TAB_MIN) {
+        return findFieldInHashTable(requested.key(), requested.hash());
+    }
+    return findFieldByScan(requested.key());
+}
+
 Position DocumentStorage::findField(StringData requested, LookupPolicy policy) const {
     if (auto pos = findFieldInCache(requested); pos.found() || policy == LookupPolicy::kCacheOnly) {
         return pos;
     }
+    return findFieldInBson(requested);
+}
+
+Position DocumentStorage::findField(HashedFieldName requested, LookupPolicy policy) const {
+    if (auto pos = findFieldInCache(requested); pos.found() || policy == LookupPolicy::kCacheOnly) {
+        return pos;
+    }
+    return findFieldInBson(requested.key());
+}
 
+Position DocumentStorage::findFieldInBson(StringData requested) const {
     for (auto&& bsonElement : _bson) {
         if (requested == bsonElement.fieldNameStringData()) {
             return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
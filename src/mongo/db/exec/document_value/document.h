@@ -143,6 +143,11 @@ public:
         return storage().getField(key);
     }
 
+    /// Same as getField(StringData), but uses the precomputed hash of the field name.
+    const Value getField(HashedFieldName key) const {
+        return storage().getField(key);
+    }
+
     /// Look up a field by Position. See positionOf and getNestedField.
     const Value operator[](Position pos) const {
         return getField(pos);
@@ -29,14 +29,13 @@
 
 #pragma once
 
-#include <third_party/murmurhash3/MurmurHash3.h>
-
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/stdx/variant.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -335,6 +334,7 @@ public:
 
     /// Returns the position of the named field or Position()
     Position findField(StringData name, LookupPolicy policy) const;
+    Position findField(HashedFieldName field, LookupPolicy policy) const;
 
     // Document uses these
     const ValueElement& getField(Position pos) const {
@@ -347,6 +347,12 @@ public:
             return Value();
         return getField(pos).val;
     }
+    Value getField(HashedFieldName field) const {
+        Position pos = findField(field, LookupPolicy::kCacheAndBSON);
+        if (!pos.found())
+            return Value();
+        return getField(pos).val;
+    }
 
     // MutableDocument uses these
     ValueElement& getField(Position pos) {
@@ -488,10 +494,7 @@ public:
     }
 
     static unsigned hashKey(StringData name) {
-        // TODO consider FNV-1a once we have a better benchmark corpus
-        unsigned out;
-        MurmurHash3_x86_32(name.rawData(), name.size(), 0, &out);
-        return out;
+        return FieldNameHasher()(name);
     }
 
     const ValueElement* begin() const {
@@ -520,6 +523,15 @@ public:
 private:
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
+    Position findFieldInCache(HashedFieldName field) const;
+
+    /// Helpers for findFieldInCache(): look the field up in the hash table or by a linear scan
+    Position findFieldInHashTable(StringData name, unsigned hash) const;
+    Position findFieldByScan(StringData name) const;
+
+    /// Returns the position of the named field after bringing it into the cache from the backing
+    /// BSON, or Position() if the BSON does not have it
+    Position findFieldInBson(StringData name) const;
 
     /// Allocates space in _cache. Copies existing data if there is any.
     void alloc(unsigned newSize);
@@ -231,6 +231,28 @@ TEST(DocumentGetFieldNonCaching, CachedTopLevelFields) {
     }
 }
 
+TEST(DocumentGetField, ByHashedFieldName) {
+    auto hashed = [](StringData name) { return HashedFieldName{name, FieldNameHasher()(name)}; };
+
+    // A narrow document is searched linearly, a wide one through its hash table.
+    BSONObjBuilder narrow;
+    narrow << "a" << 1 << "b" << 2;
+    BSONObjBuilder wide;
+    for (int i = 0; i < 20; ++i) {
+        wide << ("f" + std::to_string(i)) << i;
+    }
+
+    for (auto&& bson : {narrow.obj(), wide.obj()}) {
+        Document document = fromBson(bson);
+        for (auto&& elt : bson) {
+            // The first lookup brings the field in from the BSON, the second finds it cached.
+            ASSERT_VALUE_EQ(document.getField(hashed(elt.fieldNameStringData())), Value(elt));
+            ASSERT_VALUE_EQ(document.getField(hashed(elt.fieldNameStringData())), Value(elt));
+        }
+        ASSERT_TRUE(document.getField(hashed("doesnotexist")).missing());
+    }
+}
+
 TEST(DocumentGetFieldNonCaching, NonArrayDottedPaths) {
     BSONObj bson = BSON("address" << BSON("zip" << 123 << "street"
                                                 << "foo"));
@@ -2281,6 +2303,15 @@ const Decimal128 kDoubleMinAsDecimal = Decimal128(kDoubleMin);
 
 }  // namespace
 
+TEST(ValueString, StoresStringsOfUpToThirteenBytesInline) {
+    for (size_t len = 0; len <= 16; ++len) {
+        const std::string str(len, 'x');
+        Value value(str);
+        ASSERT_EQ(value.getStringData(), str);
+        ASSERT_EQ(value.getApproximateSize() == sizeof(Value), len <= 13);
+    }
+}
+
 TEST(ValueIntegral, CorrectlyIdentifiesValidIntegralValues) {
     ASSERT_TRUE(Value(kIntMax).integral());
     ASSERT_TRUE(Value(kIntMin).integral());
@@ -323,9 +323,10 @@ public:
 
             // bytes[1]
             struct {
-                uint8_t refCounter : 1;  // bit 0: true if we need to refCount
-                uint8_t shortStr : 1;    // bit 1: true if we are using short strings
-                uint8_t reservedFlags : 6;
+                uint8_t refCounter : 1;    // bit 0: true if we need to refCount
+                uint8_t shortStr : 1;      // bit 1: true if we are using short strings
+                uint8_t shortStrSize : 4;  // bits 2-5: length of the short string
+                uint8_t reservedFlags : 2;
             };
 
             // bytes[2:15]
@@ -333,8 +334,7 @@ public:
                 unsigned char oid[12];
 
                 struct {
-                    char shortStrSize;  // TODO Consider moving into flags union (4 bits)
-                    char shortStrStorage[sizeof(bytes) - 3 /*offset*/ - 1 /*NUL byte*/];
+                    char shortStrStorage[sizeof(bytes) - 2 /*offset*/ - 1 /*NUL byte*/];
                     union {
                         char nulTerminator;
                     };
@@ -374,5 +374,6 @@ public:
     };
 };
 MONGO_STATIC_ASSERT(sizeof(ValueStorage) == 16);
+MONGO_STATIC_ASSERT(sizeof(ValueStorage::shortStrStorage) < (1 << 4));  // Fits 'shortStrSize'.
 MONGO_STATIC_ASSERT(alignof(ValueStorage) >= alignof(void*));
 }  // namespace mongo
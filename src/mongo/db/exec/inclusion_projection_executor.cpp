@@ -42,6 +42,12 @@ Document FastPathEligibleInclusionNode::applyToDocument(const Document& inputDoc
     // If we can get the backing BSON object off the input document without allocating an owned
     // copy, then we can apply a fast-path BSON-to-BSON inclusion projection.
     if (auto bson = inputDoc.toBsonIfTriviallyConvertible()) {
+        // Documents that already consist of projected fields only, for instance because an earlier
+        // stage applied the same projection, can be passed through without building a copy.
+        if (_includesAllFields(*bson)) {
+            return inputDoc;
+        }
+
         BSONObjBuilder bob;
         _applyProjections(*bson, &bob);
 
@@ -59,6 +65,20 @@ Document FastPathEligibleInclusionNode::applyToDocument(const Document& inputDoc
     return InclusionNode::applyToDocument(inputDoc);
 }
 
+bool FastPathEligibleInclusionNode::_includesAllFields(const BSONObj& bson) const {
+    // _applyProjections() keeps at most this many fields, so a document with more fields than
+    // that, e.g. one with duplicate field names, must go through it.
+    auto nFieldsNeeded = _projectedFields.size() + _children.size();
+    for (auto&& bsonElement : bson) {
+        if (nFieldsNeeded == 0 ||
+            _projectedFields.find(bsonElement.fieldNameStringData()) == _projectedFields.end()) {
+            return false;
+        }
+        --nFieldsNeeded;
+    }
+    return true;
+}
+
 void FastPathEligibleInclusionNode::_applyProjections(BSONObj bson, BSONObjBuilder* bob) const {
     auto nFieldsNeeded = _projectedFields.size() + _children.size();
 
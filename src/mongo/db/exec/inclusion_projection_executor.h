@@ -158,6 +158,11 @@ protected:
     }
 
 private:
+    /**
+     * Returns true if every top-level field of 'bson' is a projected leaf of this node, in which
+     * case the projection would reproduce 'bson' unchanged.
+     */
+    bool _includesAllFields(const BSONObj& bson) const;
     void _applyProjections(BSONObj bson, BSONObjBuilder* bob) const;
     void _applyProjectionsToArray(BSONObj array, BSONArrayBuilder* bab) const;
 };
@@ -449,6 +449,25 @@ TEST_F(InclusionProjectionExecutionTestWithoutFallBackToDefault, ShouldIncludeTo
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+TEST_F(InclusionProjectionExecutionTestWithoutFallBackToDefault,
+       ShouldPassThroughDocumentWithOnlyProjectedFields) {
+    auto inclusion = makeInclusionProjectionWithDefaultPolicies(BSON("a" << true << "b" << true));
+
+    // All fields are projected, possibly in a different order than in the specification.
+    auto input = Document{BSON("b" << 2 << "_id" << 0 << "a" << 1)};
+    auto result = inclusion->applyTransformation(input);
+    ASSERT_DOCUMENT_EQ(result, input);
+
+    // A subset of the projected fields.
+    input = Document{BSON("a" << 1)};
+    result = inclusion->applyTransformation(input);
+    ASSERT_DOCUMENT_EQ(result, input);
+
+    // A field which is not projected.
+    result = inclusion->applyTransformation(Document{BSON("a" << 1 << "c" << 3)});
+    ASSERT_DOCUMENT_EQ(result, (Document{{"a", 1}}));
+}
+
 TEST_F(InclusionProjectionExecutionTestWithFallBackToDefault, ShouldAddComputedTopLevelField) {
     auto inclusion = makeInclusionProjectionWithDefaultPolicies(
         BSON("newField" << wrapInLiteral("computedVal")));
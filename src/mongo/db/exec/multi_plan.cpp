@@ -50,8 +50,10 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -166,6 +168,8 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 
     size_t numWorks = trial_period::getTrialPeriodMaxWorks(opCtx(), collection());
     size_t numResults = trial_period::getTrialPeriodNumToReturn(*_query);
+    const Milliseconds maxTrialTime{internalQueryPlanEvaluationMaxTimeMS.load()};
+    Timer trialTimer;
 
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
@@ -174,6 +178,17 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+
+            // Every candidate has been worked at least once by now, so the ranker has something
+            // to go on if the trial period runs out of time.
+            if (maxTrialTime > Milliseconds{0} && trialTimer.elapsed() >= maxTrialTime) {
+                LOGV2_DEBUG(6104000,
+                            2,
+                            "Multi-planner trial period exceeded its time limit",
+                            "maxTrialTime"_attr = maxTrialTime,
+                            "numWorks"_attr = ix + 1);
+                break;
+            }
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -989,6 +989,16 @@ value::SlotAccessor* CompileCtx::getAccessor(value::SlotId slot) {
     return env->getAccessor(slot);
 }
 
+bool CompileCtx::isContextSlot(value::SlotId slot) const {
+    for (auto&& [correlatedSlot, _] : correlated) {
+        if (correlatedSlot == slot) {
+            return true;
+        }
+    }
+
+    return env->isSlotRegistered(slot);
+}
+
 std::shared_ptr<SpoolBuffer> CompileCtx::getSpoolBuffer(SpoolId spool) {
     if (spoolBuffers.find(spool) == spoolBuffers.end()) {
         spoolBuffers.emplace(spool, std::make_shared<SpoolBuffer>());
@@ -155,6 +155,13 @@ public:
      */
     Accessor* getAccessor(value::SlotId slot);
 
+    /**
+     * Returns true if the given SlotId has been registered within this environment.
+     */
+    bool isSlotRegistered(value::SlotId slot) const {
+        return _accessors.count(slot) > 0;
+    }
+
     /**
      * Make a copy of his environment. The new environment will have its own set of SlotAccessors
      * pointing to the same shared data holding slot values.
@@ -217,6 +224,12 @@ struct CompileCtx {
 
     value::SlotAccessor* getAccessor(value::SlotId slot);
 
+    /**
+     * Returns true if the given slot is provided by this context, either as a correlated slot or
+     * by the runtime environment, rather than by a plan stage.
+     */
+    bool isContextSlot(value::SlotId slot) const;
+
     RuntimeEnvironment::Accessor* getRuntimeEnvAccessor(value::SlotId slotId) {
         return env->getAccessor(slotId);
     }
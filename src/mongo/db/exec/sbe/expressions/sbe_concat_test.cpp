@@ -110,6 +110,34 @@ TEST_F(SBEConcatTest, ComputesStringConcat) {
     runAndAssertExpression(compiledExpr.get(), "bson string");
 }
 
+TEST_F(SBEConcatTest, ComputesConcatAroundSmallStringLimit) {
+    value::OwnedValueAccessor slotAccessor1;
+    value::OwnedValueAccessor slotAccessor2;
+    auto argSlot1 = bindAccessor(&slotAccessor1);
+    auto argSlot2 = bindAccessor(&slotAccessor2);
+    auto concatExpr = sbe::makeE<sbe::EFunction>(
+        "concat", sbe::makeEs(makeE<EVariable>(argSlot1), makeE<EVariable>(argSlot2)));
+    auto compiledExpr = compileExpression(*concatExpr);
+
+    auto runConcat = [&](StringData lhs, StringData rhs) {
+        auto [tag1, val1] = value::makeNewString(lhs);
+        auto [tag2, val2] = value::makeNewString(rhs);
+        slotAccessor1.reset(tag1, val1);
+        slotAccessor2.reset(tag2, val2);
+        auto [tag, val] = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard guard(tag, val);
+        ASSERT(value::isString(tag));
+        ASSERT_EQUALS(value::getStringView(tag, val), lhs.toString() + rhs);
+        return tag;
+    };
+
+    ASSERT_EQUALS(runConcat("abc", "defg"), value::TypeTags::StringSmall);
+    ASSERT_EQUALS(runConcat("abcd", "efgh"), value::TypeTags::StringBig);
+
+    // Short results with embedded null bytes cannot be stored as small strings.
+    ASSERT_EQUALS(runConcat("a"_sd, StringData("\0b", 2)), value::TypeTags::StringBig);
+}
+
 TEST_F(SBEConcatTest, ComputesManyStringsConcat) {
     value::OwnedValueAccessor slotAccessor1;
     value::OwnedValueAccessor slotAccessor2;
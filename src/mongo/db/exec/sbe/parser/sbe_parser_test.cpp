@@ -361,6 +361,7 @@ protected:
                 sbe::makeSV(),
                 true,
                 boost::none, /* optional collator slot */
+                false, /* allowDiskUse */
                 planNodeId),
             // GROUP with a collator slot.
             sbe::makeS<sbe::HashAggStage>(
@@ -375,6 +376,7 @@ protected:
                 sbe::makeSV(),
                 true,
                 sbe::value::SlotId{4}, /* optional collator slot */
+                false, /* allowDiskUse */
                 planNodeId),
             // LIMIT
             sbe::makeS<sbe::LimitSkipStage>(
@@ -423,6 +425,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            boost::none, /* optional collator slot */
+                                           false, /* allowDiskUse */
                                            planNodeId),
             // HJOIN with a collator slot.
             sbe::makeS<sbe::HashJoinStage>(sbe::makeS<sbe::CoScanStage>(planNodeId),
@@ -432,6 +435,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            sbe::value::SlotId{7}, /* optional collator slot */
+                                           false, /* allowDiskUse */
                                            planNodeId),
             // FILTER
             sbe::makeS<sbe::FilterStage<false>>(
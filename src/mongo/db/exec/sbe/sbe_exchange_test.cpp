@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::ExchangeConsumer and sbe::ExchangeProducer.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/exchange.h"
+
+namespace mongo::sbe {
+
+class ExchangeStageTest : public PlanStageTestFixture {
+public:
+    // Enough values for every producer to fill more than its share of the exchange buffers.
+    static constexpr int kNumValues = 20000;
+
+    /**
+     * Makes an exchange, over a virtual scan of the values [0, kNumValues), with 'numProducers'
+     * producers. Returns the exchange and its output slot.
+     */
+    std::pair<value::SlotId, std::unique_ptr<PlanStage>> makeExchange(size_t numProducers) {
+        BSONArrayBuilder bab;
+        for (int i = 0; i < kNumValues; ++i) {
+            bab.append(i);
+        }
+        auto [scanSlot, scanStage] = generateVirtualScan(bab.arr());
+
+        auto exchange = makeS<ExchangeConsumer>(std::move(scanStage),
+                                                numProducers,
+                                                makeSV(scanSlot),
+                                                ExchangePolicy::roundrobin,
+                                                nullptr /* partition */,
+                                                nullptr /* orderLess */,
+                                                kEmptyPlanNodeId);
+        return {scanSlot, std::move(exchange)};
+    }
+
+    /**
+     * Every producer runs its own clone of the virtual scan, so each value must be returned exactly
+     * once per producer.
+     */
+    void assertEveryProducerRowReturned(PlanStage* exchange,
+                                        value::SlotAccessor* accessor,
+                                        size_t numProducers) {
+        std::vector<size_t> counts(kNumValues, 0);
+        while (exchange->getNext() == PlanState::ADVANCED) {
+            auto [tag, val] = accessor->getViewOfValue();
+            ASSERT_TRUE(tag == value::TypeTags::NumberInt32);
+            auto value = value::bitcastTo<int32_t>(val);
+            ASSERT_GTE(value, 0);
+            ASSERT_LT(value, kNumValues);
+            ++counts[value];
+        }
+
+        for (int i = 0; i < kNumValues; ++i) {
+            ASSERT_EQ(counts[i], numProducers) << "value " << i;
+        }
+    }
+};
+
+// The producers run on a thread pool whose threads keep the Client, and so the ServiceContext, of
+// the test which first used them. All exchange cases therefore share a single test.
+TEST_F(ExchangeStageTest, ExchangeRunsProducersAndPassesOnInterruption) {
+    for (size_t numProducers : {1, 2, 4}) {
+        auto [outputSlot, exchange] = makeExchange(numProducers);
+        auto ctx = makeCompileCtx();
+        auto accessor = prepareTree(ctx.get(), exchange.get(), outputSlot);
+        assertEveryProducerRowReturned(exchange.get(), accessor, numProducers);
+
+        auto stats = exchange->getStats(false /* includeDebugInfo */);
+        ASSERT_EQ(stats->children.size(), 1U);
+
+        // A closed exchange can be opened again, which starts a new run of its producers.
+        exchange->close();
+        exchange->open(false);
+        assertEveryProducerRowReturned(exchange.get(), accessor, numProducers);
+        exchange->close();
+    }
+
+    // Nothing is consumed, so the producers block once the exchange buffers are full. Interrupting
+    // the consumer's operation must stop the consumer, and must not leave close() waiting for the
+    // producers.
+    auto [outputSlot, exchange] = makeExchange(4);
+    auto ctx = makeCompileCtx();
+    prepareTree(ctx.get(), exchange.get(), outputSlot);
+
+    opCtx()->markKilled(ErrorCodes::Interrupted);
+    ASSERT_THROWS_CODE(exchange->getNext(), DBException, ErrorCodes::Interrupted);
+
+    // The producers which were killed rethrow their interruption from close().
+    try {
+        exchange->close();
+    } catch (const ExceptionFor<ErrorCodes::Interrupted>&) {
+    }
+}
+
+}  // namespace mongo::sbe
@@ -37,6 +37,8 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo::sbe {
@@ -47,14 +49,16 @@ public:
         BSONArray inputArr,
         BSONArray expectedOutputArray,
         bool shouldSpill = false,
-        std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator = nullptr);
+        std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator = nullptr,
+        bool allowDiskUse = false);
 };
 
 void HashAggStageTest::performHashAggWithSpillChecking(
     BSONArray inputArr,
     BSONArray expectedOutputArray,
     bool shouldSpill,
-    std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator) {
+    std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator,
+    bool allowDiskUse) {
     using namespace std::literals;
 
     auto [inputTag, inputVal] = stage_builder::makeValue(inputArr);
@@ -66,7 +70,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto collatorSlot = generateSlotId();
     auto shouldUseCollator = optionalCollator.get() != nullptr;
 
-    auto makeStageFn = [this, collatorSlot, shouldUseCollator](
+    auto makeStageFn = [this, collatorSlot, shouldUseCollator, allowDiskUse](
                            value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
         auto countsSlot = generateSlotId();
 
@@ -80,6 +84,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
             makeSV(),
             true,
             boost::optional<value::SlotId>{shouldUseCollator, collatorSlot},
+            allowDiskUse,
             kEmptyPlanNodeId);
 
         return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -99,7 +104,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
 
     // Prepare the tree and get the 'SlotAccessor' for the output slot.
-    if (shouldSpill) {
+    if (shouldSpill && !allowDiskUse) {
         auto hashAggStage = makeStageFn(scanSlot, std::move(scanStage));
         // 'prepareTree()' also opens the tree after preparing it thus the spilling error should
         // occur in 'prepareTree()'.
@@ -116,6 +121,9 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessor);
     value::ValueGuard resultsGuard{resultsTag, resultsVal};
 
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_EQ(stats->usedDisk, shouldSpill);
+
     // Sort results for stable compare, since the counts could come out in any order.
     using ValuePair = std::pair<value::TypeTags, value::Value>;
     std::vector<ValuePair> resultsContents;
@@ -189,6 +197,7 @@ TEST_F(HashAggStageTest, HashAggMinMaxTest) {
             makeSV(),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         auto outSlot = generateSlotId();
@@ -245,6 +254,7 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
             makeSV(),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         return std::make_pair(hashAggSlot, std::move(hashAggStage));
@@ -342,6 +352,7 @@ TEST_F(HashAggStageTest, HashAggSeekKeysTest) {
             makeSV(seekSlot),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -420,4 +431,132 @@ TEST_F(HashAggStageTest, HashAggMemUsageTest) {
     performHashAggWithSpillChecking(spillInputArr, expectedOutputArr, true);
 }
 
+TEST_F(HashAggStageTest, HashAggSpillToDiskTest) {
+    // Spill as soon as the estimated hash table size is >= 128 * 5, as in HashAggMemUsageTest.
+    auto defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(128 * 5);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(
+            defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill);
+    });
+    auto defaultInternalQuerySBEAggMemoryUseSampleRate =
+        internalQuerySBEAggMemoryUseSampleRate.load();
+    internalQuerySBEAggMemoryUseSampleRate.store(1.0);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEAggMemoryUseSampleRate.store(defaultInternalQuerySBEAggMemoryUseSampleRate);
+    });
+
+    unittest::TempDir tempDir("HashAggStageTest");
+    auto defaultDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = defaultDbPath; });
+
+    auto entry = [](char c) {
+        return std::string(256, c);
+    };
+    auto inputArr = BSON_ARRAY(entry('A') << entry('a') << entry('b') << entry('c') << entry('B')
+                                          << entry('a') << entry('c') << entry('A') << entry('a'));
+
+    // Groups the values as: ["a", "a", "a"], ["A", "A"], ["c", "c"], ["B"], ["b"]. Most of the
+    // groups only fit on disk, so they are aggregated from the spilled rows.
+    performHashAggWithSpillChecking(
+        inputArr, BSON_ARRAY(3 << 2 << 2 << 1 << 1), true, nullptr, true /* allowDiskUse */);
+
+    // Collator groups the values as: ["A", "a", "a", "A", "a"], ["b", "B"], ["c", "c"]. The spilled
+    // rows must be merged using the collation as well.
+    performHashAggWithSpillChecking(
+        inputArr,
+        BSON_ARRAY(5 << 2 << 2),
+        true,
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString),
+        true /* allowDiskUse */);
+}
+
+TEST_F(HashAggStageTest, HashAggSpilledRowsFeedAggregatesTest) {
+    // Re-estimate the hash table size for every row and spill after the first group.
+    auto defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(1);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(
+            defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill);
+    });
+    auto defaultInternalQuerySBEAggMemoryUseSampleRate =
+        internalQuerySBEAggMemoryUseSampleRate.load();
+    internalQuerySBEAggMemoryUseSampleRate.store(1.0);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEAggMemoryUseSampleRate.store(defaultInternalQuerySBEAggMemoryUseSampleRate);
+    });
+
+    unittest::TempDir tempDir("HashAggStageTest");
+    auto defaultDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = defaultDbPath; });
+
+    // Group the [1,2,...,5,1,2,...,5] input by 'value % 2' and sum up the values of each group.
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 10; ++i) {
+        bab.append(i % 5 + 1);
+    }
+    auto [inputTag, inputVal] = stage_builder::makeValue(bab.arr());
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    auto keySlot = generateSlotId();
+    auto sumSlot = generateSlotId();
+    auto projectStage = makeProjectStage(
+        std::move(scanStage),
+        kEmptyPlanNodeId,
+        keySlot,
+        stage_builder::makeFunction("mod",
+                                    makeE<EVariable>(scanSlot),
+                                    makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                     value::bitcastFrom<int32_t>(2))));
+    auto hashAggStage =
+        makeS<HashAggStage>(std::move(projectStage),
+                            makeSV(keySlot),
+                            makeEM(sumSlot,
+                                   stage_builder::makeFunction("sum", makeE<EVariable>(scanSlot))),
+                            makeSV(),
+                            true,
+                            boost::none,
+                            true /* allowDiskUse */,
+                            kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto accessors = prepareTree(ctx.get(), hashAggStage.get(), makeSV(keySlot, sumSlot));
+
+    // The odd values add up to 2 * (1 + 3 + 5) and the even ones to 2 * (2 + 4).
+    auto assertGroups = [&]() {
+        size_t numGroups = 0;
+        while (hashAggStage->getNext() == PlanState::ADVANCED) {
+            ++numGroups;
+            auto [keyTag, keyVal] = accessors[0]->getViewOfValue();
+            ASSERT_TRUE(keyTag == value::TypeTags::NumberInt32);
+            auto expectedSum = value::bitcastTo<int32_t>(keyVal) ? 18 : 12;
+            auto [sumTag, sumVal] = accessors[1]->getViewOfValue();
+            assertValuesEqual(sumTag,
+                              sumVal,
+                              value::TypeTags::NumberInt32,
+                              value::bitcastFrom<int32_t>(expectedSum));
+        }
+        ASSERT_EQ(numGroups, 2U);
+
+        // Asking for more results once the spilled groups are drained stays at EOF.
+        ASSERT_TRUE(hashAggStage->getNext() == PlanState::IS_EOF);
+    };
+    assertGroups();
+
+    auto stats = static_cast<const HashAggStats*>(hashAggStage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_EQ(stats->spilledRecords, 5U);
+
+    // Reopening rebuilds the hash table and spills the same rows again.
+    hashAggStage->open(true /* reOpen */);
+    assertGroups();
+    ASSERT_EQ(stats->spilledRecords, 10U);
+
+    hashAggStage->close();
+}
+
 }  // namespace mongo::sbe
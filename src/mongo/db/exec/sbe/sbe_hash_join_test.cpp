@@ -37,6 +37,8 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
 
 namespace mongo::sbe {
 
@@ -79,6 +81,7 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
                                      makeSV(innerCondSlot),
                                      makeSV(),
                                      boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                     false /* allowDiskUse */,
                                      kEmptyPlanNodeId);
 
             return std::make_pair(makeSV(innerCondSlot, outerCondSlot), std::move(hashJoinStage));
@@ -137,4 +140,81 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
     }
 }
 
+TEST_F(HashJoinStageTest, HashJoinSpillToDiskTest) {
+    unittest::TempDir tempDir("HashJoinStageTest");
+    auto defaultDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = defaultDbPath; });
+
+    // The outer side holds the keys 0 to 99, where the multiples of 10 appear twice. The inner side
+    // holds the keys 50 to 149. Each row also carries a string derived from its key.
+    BSONArrayBuilder outerBab;
+    for (int key = 0; key < 100; ++key) {
+        outerBab.append(BSON_ARRAY(key << ("o" + std::to_string(key))));
+        if (key % 10 == 0) {
+            outerBab.append(BSON_ARRAY(key << ("o" + std::to_string(key))));
+        }
+    }
+    auto outerArr = outerBab.arr();
+    BSONArrayBuilder innerBab;
+    for (int key = 50; key < 150; ++key) {
+        innerBab.append(BSON_ARRAY(key << ("i" + std::to_string(key))));
+    }
+    auto innerArr = innerBab.arr();
+
+    // A limit of 1 byte spills every partition, the larger one keeps some of them in memory.
+    for (auto memoryLimit : {1LL, 2048LL}) {
+        auto defaultMemoryLimit = internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(memoryLimit);
+        ON_BLOCK_EXIT([&] {
+            internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(defaultMemoryLimit);
+        });
+
+        auto [outerSlots, outerStage] = generateVirtualScanMulti(2, outerArr);
+        auto [innerSlots, innerStage] = generateVirtualScanMulti(2, innerArr);
+        auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                          std::move(innerStage),
+                                          makeSV(outerSlots[0]),
+                                          makeSV(outerSlots[1]),
+                                          makeSV(innerSlots[0]),
+                                          makeSV(innerSlots[1]),
+                                          boost::none,
+                                          true /* allowDiskUse */,
+                                          kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        auto accessors =
+            prepareTree(ctx.get(),
+                        stage.get(),
+                        makeSV(outerSlots[0], outerSlots[1], innerSlots[0], innerSlots[1]));
+
+        // Every outer key from 50 to 99 matches once, and the multiples of 10 twice.
+        size_t numResults = 0;
+        while (stage->getNext() == PlanState::ADVANCED) {
+            ++numResults;
+            auto [outerKeyTag, outerKeyVal] = accessors[0]->getViewOfValue();
+            auto [innerKeyTag, innerKeyVal] = accessors[2]->getViewOfValue();
+            ASSERT_TRUE(outerKeyTag == value::TypeTags::NumberInt32);
+            assertValuesEqual(outerKeyTag, outerKeyVal, innerKeyTag, innerKeyVal);
+
+            auto key = std::to_string(value::bitcastTo<int32_t>(outerKeyVal));
+            auto [outerProjectTag, outerProjectVal] = accessors[1]->getViewOfValue();
+            ASSERT_EQ(value::getStringView(outerProjectTag, outerProjectVal), "o" + key);
+            auto [innerProjectTag, innerProjectVal] = accessors[3]->getViewOfValue();
+            ASSERT_EQ(value::getStringView(innerProjectTag, innerProjectVal), "i" + key);
+        }
+        ASSERT_EQ(numResults, 55U);
+
+        auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+        ASSERT_TRUE(stats->usedDisk);
+        ASSERT_GT(stats->spilledPartitions, 0U);
+        ASSERT_GT(stats->spilledInnerRecords, 0U);
+        if (memoryLimit == 1) {
+            ASSERT_EQ(stats->spilledOuterRecords, 110U);
+        }
+
+        stage->close();
+    }
+}
+
 }  // namespace mongo::sbe
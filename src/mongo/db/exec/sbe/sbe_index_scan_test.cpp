@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::IndexScanStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/ix_scan.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+
+const NamespaceString kNss("test.sbe_index_scan");
+
+class IndexScanStageTest : public CatalogTestFixture {
+protected:
+    void setUp() override {
+        CatalogTestFixture::setUp();
+        ASSERT_OK(storageInterface()->createCollection(
+            operationContext(), kNss, CollectionOptions()));
+    }
+
+    void tearDown() override {
+        _stage.reset();
+        _ctx.reset();
+        CatalogTestFixture::tearDown();
+    }
+
+    void insertIds(const std::vector<int>& ids) {
+        AutoGetCollection coll(operationContext(), kNss, MODE_IX);
+        for (auto id : ids) {
+            WriteUnitOfWork wuow(operationContext());
+            ASSERT_OK(coll->insertDocument(
+                operationContext(), InsertStatement(BSON("_id" << id)), nullptr));
+            wuow.commit();
+        }
+    }
+
+    /**
+     * Creates a scan of the _id index in the given direction, whose bounds are read from two
+     * runtime environment slots on every open, and which projects out the _id of each entry.
+     */
+    void makeStage(bool forward) {
+        auto opCtx = operationContext();
+        AutoGetCollection coll(opCtx, kNss, MODE_IS);
+        auto indexCatalog = coll->getIndexCatalog();
+        auto sdi = indexCatalog->getEntry(indexCatalog->findIdIndex(opCtx))
+                       ->accessMethod()
+                       ->getSortedDataInterface();
+        _version = sdi->getKeyStringVersion();
+        _forward = forward;
+
+        auto env = std::make_unique<RuntimeEnvironment>();
+        _env = env.get();
+        _lowSlot = _env->registerSlot(value::TypeTags::Nothing, 0, false, &_slotIdGenerator);
+        _highSlot = _env->registerSlot(value::TypeTags::Nothing, 0, false, &_slotIdGenerator);
+        _ctx = std::make_unique<CompileCtx>(std::move(env));
+        const auto idSlot = _slotIdGenerator.generate();
+
+        IndexKeysInclusionSet indexKeysToInclude;
+        indexKeysToInclude.set(0);
+        _stage = std::make_unique<IndexScanStage>(coll->uuid(),
+                                                  "_id_"_sd,
+                                                  forward,
+                                                  boost::none,
+                                                  boost::none,
+                                                  boost::none,
+                                                  indexKeysToInclude,
+                                                  value::SlotVector{idSlot},
+                                                  _lowSlot,
+                                                  _highSlot,
+                                                  nullptr /* yieldPolicy */,
+                                                  kEmptyPlanNodeId);
+        _stage->attachToOperationContext(opCtx);
+        _stage->prepare(*_ctx);
+        _idAccessor = _stage->getAccessor(*_ctx, idSlot);
+    }
+
+    /**
+     * Opens, or reopens, the scan over the interval from 'start' to 'end' in the direction of the
+     * scan, and returns the _id of every entry it produces.
+     */
+    std::vector<int> scan(int start, bool startInclusive, int end, bool endInclusive) {
+        // A bound which sorts just before or just after the key, in index order.
+        const auto before = KeyString::Discriminator::kExclusiveBefore;
+        const auto after = KeyString::Discriminator::kExclusiveAfter;
+        setBound(_lowSlot, start, startInclusive == _forward ? before : after);
+        setBound(_highSlot, end, endInclusive == _forward ? after : before);
+
+        _stage->open(_open);
+        _open = true;
+
+        std::vector<int> ids;
+        while (_stage->getNext() == PlanState::ADVANCED) {
+            auto [tag, val] = _idAccessor->getViewOfValue();
+            ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+            ids.push_back(value::bitcastTo<int32_t>(val));
+        }
+        return ids;
+    }
+
+    /**
+     * Yields the scan, running 'duringYield' while it is yielded.
+     */
+    void yield(std::function<void()> duringYield) {
+        _stage->saveState();
+        operationContext()->recoveryUnit()->abandonSnapshot();
+        duringYield();
+        _stage->restoreState();
+    }
+
+    const IndexScanStats& stats() const {
+        return *static_cast<const IndexScanStats*>(_stage->getSpecificStats());
+    }
+
+private:
+    void setBound(value::SlotId slot, int id, KeyString::Discriminator discriminator) {
+        KeyString::Builder kb(_version, BSON("" << id), Ordering::make(BSON("_id" << 1)));
+        kb.appendDiscriminator(discriminator);
+        auto [tag, val] = value::makeCopyKeyString(kb.getValueCopy());
+        _env->resetSlot(slot, tag, val, true);
+    }
+
+    value::SlotIdGenerator _slotIdGenerator;
+    std::unique_ptr<CompileCtx> _ctx;
+    RuntimeEnvironment* _env{nullptr};
+    std::unique_ptr<IndexScanStage> _stage;
+    value::SlotId _lowSlot;
+    value::SlotId _highSlot;
+    value::SlotAccessor* _idAccessor{nullptr};
+    KeyString::Version _version{KeyString::Version::kLatestVersion};
+    bool _forward{true};
+    bool _open{false};
+};
+
+TEST_F(IndexScanStageTest, ForwardPointIntervalsReuseLookAheadEntry) {
+    insertIds({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    AutoGetCollection coll(operationContext(), kNss, MODE_IX);
+    makeStage(true /* forward */);
+
+    // The first interval seeks, and then reads the entry past its end.
+    ASSERT(scan(2, true, 2, true) == std::vector<int>({2}));
+    ASSERT_EQ(stats().seeks, 1U);
+    ASSERT_EQ(stats().numReads, 2U);
+
+    // Each following interval starts on the entry the previous one stopped on, so neither a seek
+    // nor a read is needed to find its first entry.
+    ASSERT(scan(3, true, 3, true) == std::vector<int>({3}));
+    ASSERT(scan(4, true, 4, true) == std::vector<int>({4}));
+    ASSERT_EQ(stats().seeks, 1U);
+    ASSERT_EQ(stats().numReads, 4U);
+    ASSERT_EQ(stats().keysExamined, 3U);
+
+    // An interval which starts past the entry the scan stopped on must seek.
+    ASSERT(scan(7, true, 7, true) == std::vector<int>({7}));
+    ASSERT_EQ(stats().seeks, 2U);
+    ASSERT_EQ(stats().keysExamined, 4U);
+}
+
+TEST_F(IndexScanStageTest, ReversePointIntervalsReuseLookAheadEntry) {
+    insertIds({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    AutoGetCollection coll(operationContext(), kNss, MODE_IX);
+    makeStage(false /* forward */);
+
+    ASSERT(scan(7, true, 7, true) == std::vector<int>({7}));
+    ASSERT(scan(6, true, 6, true) == std::vector<int>({6}));
+    ASSERT(scan(5, true, 5, true) == std::vector<int>({5}));
+    ASSERT_EQ(stats().seeks, 1U);
+    ASSERT_EQ(stats().numReads, 4U);
+    ASSERT_EQ(stats().keysExamined, 3U);
+
+    ASSERT(scan(2, true, 2, true) == std::vector<int>({2}));
+    ASSERT_EQ(stats().seeks, 2U);
+}
+
+TEST_F(IndexScanStageTest, ExclusiveBoundsAreNotSkippedByLookAheadEntry) {
+    insertIds({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    AutoGetCollection coll(operationContext(), kNss, MODE_IX);
+    makeStage(true /* forward */);
+
+    // The first interval stops on 5, which the next interval excludes, so it must seek past it.
+    ASSERT(scan(2, false, 5, false) == std::vector<int>({3, 4}));
+    ASSERT(scan(5, false, 8, false) == std::vector<int>({6, 7}));
+    ASSERT_EQ(stats().seeks, 2U);
+
+    // An inclusive start equal to the previous exclusive end still finds its first entry.
+    ASSERT(scan(8, true, 9, true) == std::vector<int>({8, 9}));
+    ASSERT_EQ(stats().keysExamined, 6U);
+}
+
+TEST_F(IndexScanStageTest, YieldDropsLookAheadEntry) {
+    insertIds({0, 2, 4});
+    AutoGetCollection coll(operationContext(), kNss, MODE_IX);
+    makeStage(true /* forward */);
+
+    // The scan stops on 4. An entry inserted while yielded lands in front of it, so the next
+    // interval must seek rather than reuse 4.
+    ASSERT(scan(2, true, 2, true) == std::vector<int>({2}));
+    yield([&] { insertIds({3}); });
+    ASSERT(scan(3, true, 3, true) == std::vector<int>({3}));
+    ASSERT_EQ(stats().seeks, 2U);
+
+    // Yielding without any concurrent write still forces a seek.
+    yield([] {});
+    ASSERT(scan(4, true, 4, true) == std::vector<int>({4}));
+    ASSERT_EQ(stats().seeks, 3U);
+}
+
+}  // namespace
+}  // namespace mongo::sbe
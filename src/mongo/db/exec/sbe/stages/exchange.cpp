@@ -31,8 +31,13 @@
 
 #include "mongo/db/exec/sbe/stages/exchange.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
 #include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 std::unique_ptr<ThreadPool> s_globalThreadPool;
@@ -68,10 +73,11 @@ void ExchangePipe::close() {
     _cond.notify_all();
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _emptyCount > 0; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _emptyCount > 0; });
 
     if (_closed) {
         return nullptr;
@@ -82,10 +88,11 @@ std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
     return std::move(_emptyBuffers[_emptyCount]);
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _fullCount != _fullPosition; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _fullCount != _fullPosition; });
 
     if (_closed) {
         return nullptr;
@@ -132,12 +139,37 @@ ExchangePipe* ExchangeState::pipe(size_t consumerTid, size_t producerTid) {
     return _consumers[consumerTid]->pipe(producerTid);
 }
 
+void ExchangeState::addProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard lock(_producerOpCtxsMutex);
+    _producerOpCtxs.push_back(opCtx);
+}
+
+void ExchangeState::removeProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard lock(_producerOpCtxsMutex);
+    _producerOpCtxs.erase(std::find(_producerOpCtxs.begin(), _producerOpCtxs.end(), opCtx));
+}
+
+void ExchangeState::killProducers(ErrorCodes::Error killCode) {
+    stdx::lock_guard lock(_producerOpCtxsMutex);
+    for (auto opCtx : _producerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, killCode);
+    }
+}
+
 ExchangeBuffer* ExchangeConsumer::getBuffer(size_t producerId) {
     if (_fullBuffers[producerId]) {
         return _fullBuffers[producerId].get();
     }
 
-    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer();
+    try {
+        _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer(_opCtx);
+    } catch (const DBException& ex) {
+        // The producers do not run on this operation context, so killOp or an expired maxTimeMS
+        // has to be passed on to them.
+        _state->killProducers(ex.code());
+        throw;
+    }
 
     return _fullBuffers[producerId].get();
 }
@@ -160,8 +192,7 @@ ExchangeConsumer::ExchangeConsumer(std::unique_ptr<PlanStage> input,
                                    std::unique_ptr<EExpression> partition,
                                    std::unique_ptr<EExpression> orderLess,
                                    PlanNodeId planNodeId)
-    : PlanStage("exchange"_sd, planNodeId) {
-    _children.emplace_back(std::move(input));
+    : PlanStage("exchange"_sd, planNodeId), _masterSubTree(std::move(input)) {
     _state = std::make_shared<ExchangeState>(
         numOfProducers, std::move(fields), policy, std::move(partition), std::move(orderLess));
 
@@ -220,7 +251,10 @@ void ExchangeConsumer::open(bool reOpen) {
         stdx::unique_lock lock(_state->consumerOpenMutex());
         bool allConsumers = (++_state->consumerOpen()) == _state->numOfConsumers();
 
-        // Create all pipes.
+        // Create all pipes, dropping those of a previous run.
+        _pipes.clear();
+        _fullBuffers.clear();
+        _bufferPos.clear();
         if (_orderPreserving) {
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 _pipes.emplace_back(std::make_unique<ExchangePipe>(2));
@@ -243,21 +277,16 @@ void ExchangeConsumer::open(bool reOpen) {
                     lock, [this]() { return _state->consumerOpen() == _state->numOfConsumers(); });
             }
 
-            // Clone n copies of the subtree for every producer.
-
-            PlanStage* masterSubTree = _children[0].get();
-            masterSubTree->detachFromOperationContext();
+            // Any producers of a previous run have finished when it was closed. All other
+            // consumers are waiting in open(), so none of them is still in close().
+            _state->resetProducers();
+            _state->consumerClose() = 0;
 
+            // Clone a copy of the subtree for every producer. The master subtree itself is never
+            // run, so that it can be cloned again if the exchange is reopened.
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
-                if (idx == 0) {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        std::move(_children[0]), _state, _commonStats.nodeId));
-                    // We have moved the child to the producer so clear the children vector.
-                    _children.clear();
-                } else {
-                    _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
-                        masterSubTree->clone(), _state, _commonStats.nodeId));
-                }
+                _state->producerPlans().emplace_back(std::make_unique<ExchangeProducer>(
+                    _masterSubTree->clone(), _state, _commonStats.nodeId));
             }
 
             // Start n producers.
@@ -269,6 +298,8 @@ void ExchangeConsumer::open(bool reOpen) {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
+                        _state->addProducerOpCtx(opCtx.get());
+                        ON_BLOCK_EXIT([&] { _state->removeProducerOpCtx(opCtx.get()); });
 
                         promise.setWith([&] {
                             ExchangeProducer::start(opCtx.get(),
@@ -378,7 +409,9 @@ void ExchangeConsumer::close() {
 
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
-    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    if (_masterSubTree) {
+        ret->children.emplace_back(_masterSubTree->getStats(includeDebugInfo));
+    }
     return ret;
 }
 
@@ -417,8 +450,10 @@ std::vector<DebugPrinter::Block> ExchangeConsumer::debugPrint() const {
             uasserted(4822835, "policy not yet implemented");
     }
 
-    DebugPrinter::addNewLine(ret);
-    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    if (_masterSubTree) {
+        DebugPrinter::addNewLine(ret);
+        DebugPrinter::addBlocks(ret, _masterSubTree->debugPrint());
+    }
 
     return ret;
 }
@@ -436,7 +471,7 @@ ExchangeBuffer* ExchangeProducer::getBuffer(size_t consumerId) {
         return _emptyBuffers[consumerId].get();
     }
 
-    _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer();
+    _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer(_opCtx);
 
     if (!_emptyBuffers[consumerId]) {
         closePipes();
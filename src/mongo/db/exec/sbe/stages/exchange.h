@@ -122,8 +122,18 @@ public:
     ExchangePipe(size_t size);
 
     void close();
-    std::unique_ptr<ExchangeBuffer> getEmptyBuffer();
-    std::unique_ptr<ExchangeBuffer> getFullBuffer();
+
+    /**
+     * Waits for an empty buffer. Returns nullptr if the pipe is closed. Throws if 'opCtx' is
+     * interrupted.
+     */
+    std::unique_ptr<ExchangeBuffer> getEmptyBuffer(OperationContext* opCtx);
+
+    /**
+     * Waits for a full buffer. Returns nullptr if the pipe is closed. Throws if 'opCtx' is
+     * interrupted.
+     */
+    std::unique_ptr<ExchangeBuffer> getFullBuffer(OperationContext* opCtx);
     void putEmptyBuffer(std::unique_ptr<ExchangeBuffer>);
     void putFullBuffer(std::unique_ptr<ExchangeBuffer>);
 
@@ -173,6 +183,24 @@ public:
         _producerResults.emplace_back(std::move(f));
     }
 
+    /**
+     * Forgets the producers of a previous run, which must all have finished, so that the exchange
+     * can be opened again.
+     */
+    void resetProducers() {
+        _producers.clear();
+        _producerPlans.clear();
+        _producerResults.clear();
+    }
+
+    /**
+     * Producers run on their own operation contexts. They register them here so that an
+     * interruption of the consumer's operation can be passed on to them.
+     */
+    void addProducerOpCtx(OperationContext* opCtx);
+    void removeProducerOpCtx(OperationContext* opCtx);
+    void killProducers(ErrorCodes::Error killCode);
+
     auto& consumerOpenMutex() {
         return _consumerOpenMutex;
     }
@@ -249,6 +277,9 @@ private:
     mongo::Mutex _consumerCloseMutex;
     stdx::condition_variable _consumerCloseCond;
     size_t _consumerClose{0};
+
+    mongo::Mutex _producerOpCtxsMutex;
+    std::vector<OperationContext*> _producerOpCtxs;
 };
 
 class ExchangeConsumer final : public PlanStage {
@@ -284,6 +315,10 @@ private:
     std::shared_ptr<ExchangeState> _state;
     size_t _tid{0};
 
+    // The subtree which every producer runs a clone of. It is kept by consumer ID 0 only, and is
+    // never opened itself, so the exchange can be closed and opened again.
+    std::unique_ptr<PlanStage> _masterSubTree;
+
     // Accessors for the outgoing values (from the exchange buffers).
     std::vector<ExchangeBuffer::Accessor> _outgoing;
 
@@ -33,6 +33,15 @@
 
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
@@ -41,12 +50,14 @@ HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector seekKeysSlots,
                            bool optimizedClose,
                            boost::optional<value::SlotId> collatorSlot,
+                           bool allowDiskUse,
                            PlanNodeId planNodeId)
     : PlanStage("group"_sd, planNodeId),
       _gbs(std::move(gbs)),
       _aggs(std::move(aggs)),
       _collatorSlot(collatorSlot),
       _seekKeysSlots(std::move(seekKeysSlots)),
+      _allowDiskUse(allowDiskUse),
       _optimizedClose(optimizedClose) {
     _children.emplace_back(std::move(input));
     invariant(_seekKeysSlots.empty() || _seekKeysSlots.size() == _gbs.size());
@@ -55,6 +66,8 @@ HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
             _seekKeysSlots.empty() || _optimizedClose);
 }
 
+HashAggStage::~HashAggStage() {}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
@@ -66,6 +79,7 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
                                           _seekKeysSlots,
                                           _optimizedClose,
                                           _collatorSlot,
+                                          _allowDiskUse,
                                           _commonStats.nodeId);
 }
 
@@ -73,7 +87,7 @@ void HashAggStage::prepare(CompileCtx& ctx) {
     _children[0]->prepare(ctx);
 
     if (_collatorSlot) {
-        _collatorAccessor = getAccessor(ctx, *_collatorSlot);
+        _collatorAccessor = _children[0]->getAccessor(ctx, *_collatorSlot);
         tassert(5402501,
                 "collator accessor should exist if collator slot provided to HashAggStage",
                 _collatorAccessor != nullptr);
@@ -124,6 +138,22 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
         if (auto it = _outAccessors.find(slot); it != _outAccessors.end()) {
             return it->second;
         }
+    } else if (ctx.aggExpression && !ctx.isContextSlot(slot)) {
+        // The aggregate expressions read their inputs either from the input subtree or, while
+        // draining spilled groups, from the spilled row being aggregated.
+        if (auto it = _aggInputAccessors.find(slot); it != _aggInputAccessors.end()) {
+            return it->second.get();
+        }
+
+        _spilledSlots.push_back(slot);
+        _inSpilledSlotAccessors.push_back(_children[0]->getAccessor(ctx, slot));
+        _spilledRowAccessors.emplace_back(
+            std::make_unique<SpilledRowAccessor>(_spilledRowPtr, _spilledSlots.size() - 1));
+        auto [it, _] = _aggInputAccessors.emplace(
+            slot,
+            std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                _inSpilledSlotAccessors.back(), _spilledRowAccessors.back().get()}));
+        return it->second.get();
     } else {
         return _children[0]->getAccessor(ctx, slot);
     }
@@ -144,14 +174,23 @@ void HashAggStage::open(bool reOpen) {
             auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
             uassert(
                 5402503, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
-            auto collatorView = value::getCollatorView(collatorVal);
-            const value::MaterializedRowHasher hasher(collatorView);
-            const value::MaterializedRowEq equator(collatorView);
+            _collator = value::getCollatorView(collatorVal);
+            const value::MaterializedRowHasher hasher(_collator);
+            const value::MaterializedRowEq equator(_collator);
             _ht.emplace(0, hasher, equator);
         } else {
             _ht.emplace();
         }
 
+        _spilling = false;
+        _sorter.reset();
+        _spilledRowsIt.reset();
+        _hasSpilledRow = false;
+        _drainingSpilledRows = false;
+        for (auto&& [_, accessor] : _aggInputAccessors) {
+            accessor->setIndex(0);
+        }
+
         _seekKeys.resize(_seekKeysAccessors.size());
 
         while (_children[0]->getNext() == PlanState::ADVANCED) {
@@ -163,6 +202,28 @@ void HashAggStage::open(bool reOpen) {
                 key.reset(idx++, false, tag, val);
             }
 
+            if (_spilling) {
+                // No new groups are added to the hash table once it is full. Rows of the groups
+                // it already holds are still aggregated in memory, all others are spilled.
+                if (auto it = _ht->find(key); it != _ht->end()) {
+                    _htIt = it;
+                    accumulate();
+                    continue;
+                }
+
+                value::MaterializedRow vals{_inSpilledSlotAccessors.size()};
+                idx = 0;
+                for (auto& p : _inSpilledSlotAccessors) {
+                    auto [tag, val] = p->getViewOfValue();
+                    vals.reset(idx++, false, tag, val);
+                }
+                key.makeOwned();
+                vals.makeOwned();
+                _sorter->emplace(std::move(key), std::move(vals));
+                ++_specificStats.spilledRecords;
+                continue;
+            }
+
             auto [it, inserted] = _ht->try_emplace(std::move(key), value::MaterializedRow{0});
             if (inserted) {
                 // Copy keys.
@@ -173,10 +234,7 @@ void HashAggStage::open(bool reOpen) {
 
             // Accumulate.
             _htIt = it;
-            for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-                auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-                _outAggAccessors[idx]->reset(owned, tag, val);
-            }
+            accumulate();
 
             // Track memory usage.
             auto shouldCalculateEstimatedSize =
@@ -185,12 +243,23 @@ void HashAggStage::open(bool reOpen) {
                 long estimatedSizeForOneRow =
                     it->first.memUsageForSorter() + it->second.memUsageForSorter();
                 long long estimatedTotalSize = _ht->size() * estimatedSizeForOneRow;
-                uassert(5859000,
-                        "Need to spill to disk",
-                        estimatedTotalSize < _approxMemoryUseInBytesBeforeSpill);
+                if (estimatedTotalSize >= _approxMemoryUseInBytesBeforeSpill) {
+                    uassert(5859000,
+                            "Need to spill to disk",
+                            _allowDiskUse && _seekKeysAccessors.empty());
+                    makeSorter();
+                    _spilling = true;
+                    _specificStats.usedDisk = true;
+                }
             }
         }
 
+        if (_sorter) {
+            _spilledRowsIt.reset(_sorter->done());
+            _specificStats.spills += _sorter->numSpills();
+            _sorter.reset();
+        }
+
         if (_optimizedClose) {
             _children[0]->close();
             _childOpened = false;
@@ -209,6 +278,62 @@ void HashAggStage::open(bool reOpen) {
     _htIt = _ht->end();
 }
 
+void HashAggStage::makeSorter() {
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.maxMemoryUsageBytes = _approxMemoryUseInBytesBeforeSpill;
+    opts.extSortAllowed = true;
+    opts.moveSortedDataIntoIterator = true;
+
+    // Any total order works as long as the keys of a group end up next to each other.
+    auto comp = [&](const SpilledRow& lhs, const SpilledRow& rhs) {
+        auto size = lhs.first.size();
+        for (size_t idx = 0; idx < size; ++idx) {
+            auto [lhsTag, lhsVal] = lhs.first.getViewOfValue(idx);
+            auto [rhsTag, rhsVal] = rhs.first.getViewOfValue(idx);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal, _collator);
+
+            auto result = value::bitcastTo<int32_t>(val);
+            if (result) {
+                return result;
+            }
+        }
+
+        return 0;
+    };
+
+    _sorter.reset(SpilledRowSorter::make(opts, comp, {}));
+}
+
+void HashAggStage::accumulate() {
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+}
+
+bool HashAggStage::nextSpilledGroup() {
+    // Clearing the hash table invalidates '_htIt'.
+    _ht->clear();
+    _htIt = _ht->end();
+    if (!_hasSpilledRow) {
+        return false;
+    }
+
+    auto [it, _] = _ht->try_emplace(std::move(_spilledRow.first),
+                                    value::MaterializedRow{_outAggAccessors.size()});
+    _htIt = it;
+    do {
+        accumulate();
+        _hasSpilledRow = _spilledRowsIt->more();
+        if (_hasSpilledRow) {
+            _spilledRow = _spilledRowsIt->next();
+        }
+    } while (_hasSpilledRow && _ht->key_eq()(_spilledRow.first, _htIt->first));
+
+    return true;
+}
+
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -228,7 +353,21 @@ PlanState HashAggStage::getNext() {
     }
 
     if (_htIt == _ht->end()) {
-        return trackPlanState(PlanState::IS_EOF);
+        if (_spilledRowsIt && !_drainingSpilledRows) {
+            // The hash table is exhausted, continue with the groups that were spilled.
+            _drainingSpilledRows = true;
+            for (auto&& [_, accessor] : _aggInputAccessors) {
+                accessor->setIndex(1);
+            }
+            _hasSpilledRow = _spilledRowsIt->more();
+            if (_hasSpilledRow) {
+                _spilledRow = _spilledRowsIt->next();
+            }
+        }
+
+        if (!_drainingSpilledRows || !nextSpilledGroup()) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -236,11 +375,15 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
         BSONObjBuilder bob;
         bob.append("groupBySlots", _gbs);
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
         if (!_aggs.empty()) {
             BSONObjBuilder childrenBob(bob.subobjStart("expressions"));
             for (auto&& [slot, expr] : _aggs) {
@@ -255,7 +398,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -263,6 +406,8 @@ void HashAggStage::close() {
 
     trackClose();
     _ht = boost::none;
+    _sorter.reset();
+    _spilledRowsIt.reset();
 
     if (_childOpened) {
         _children[0]->close();
@@ -29,15 +29,20 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <absl/container/flat_hash_map.h>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/db/query/query_knobs_gen.h"
-#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+
 namespace sbe {
 /**
  * Performs a hash-based aggregation. Appears as the "group" stage in debug output. Groups the input
@@ -60,6 +65,17 @@ namespace sbe {
  * determining whether two group-by keys are equal. For instance, the plan may require us to do a
  * case-insensitive group on a string field.
  *
+ * The hash table is limited by the
+ * 'internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill' knob. If the limit is
+ * exceeded and 'allowDiskUse' is false, this stage throws a query-fatal exception. If
+ * 'allowDiskUse' is true, no more groups are added to the hash table. Input rows that belong to
+ * groups already in the table are still accumulated in memory. All other rows are passed, keyed
+ * by their group-by values, to a Sorter, which writes them to disk as sorted runs. Once the hash
+ * table has been returned, the merged runs are read back in key order and the aggregates are
+ * evaluated one group at a time. Spilling is not supported together with 'seekKeys'. The stage
+ * builders currently only create HashAggStages without group-by slots, which hold a single group
+ * and so never spill.
+ *
  * Debug string representation:
  *
  *  group [<group by slots>] [slot_1 = expr_1, ..., slot_n = expr_n] [<seek slots>]? reopen?
@@ -73,8 +89,11 @@ public:
                  value::SlotVector seekKeysSlots,
                  bool optimizedClose,
                  boost::optional<value::SlotId> collatorSlot,
+                 bool allowDiskUse,
                  PlanNodeId planNodeId);
 
+    ~HashAggStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -88,7 +107,10 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
-    using TableType = stdx::unordered_map<value::MaterializedRow,
+    // An open-addressing table keeps the group-by rows inline so that probes do not chase a
+    // pointer per node. Iterators are invalidated by inserts, so '_htIt' is always re-seated after
+    // an insert and the table is never modified while its results are being returned.
+    using TableType = absl::flat_hash_map<value::MaterializedRow,
                                           value::MaterializedRow,
                                           value::MaterializedRowHasher,
                                           value::MaterializedRowEq>;
@@ -96,10 +118,32 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // A spilled input row: the group-by values and the values of the slots read by the aggregates.
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledRowAccessor = value::MaterializedRowValueAccessor<SpilledRow*>;
+    using SpilledRowSorter = Sorter<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledRowIterator =
+        SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    void makeSorter();
+
+    /**
+     * Runs the aggregate expressions over the current input row, accumulating into the hash table
+     * entry '_htIt' points to.
+     */
+    void accumulate();
+
+    /**
+     * Aggregates the next group of spilled rows into the hash table, which is emptied first, and
+     * points '_htIt' at it. Returns false if there are no spilled rows left.
+     */
+    bool nextSpilledGroup();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
     const boost::optional<value::SlotId> _collatorSlot;
     const value::SlotVector _seekKeysSlots;
+    const bool _allowDiskUse;
     // When this operator does not expect to be reopened (almost always) then it can close the child
     // early.
     const bool _optimizedClose{true};
@@ -123,10 +167,30 @@ private:
 
     // Only set if collator slot provided on construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
+    CollatorInterface* _collator = nullptr;
 
     boost::optional<TableType> _ht;
     TableType::iterator _htIt;
 
+    // The slots from the input subtree read by the aggregate expressions, which are stored in the
+    // spilled rows. The aggregates read them through '_aggInputAccessors', which switch between
+    // the input subtree (index 0) and the spilled row being aggregated (index 1).
+    value::SlotVector _spilledSlots;
+    std::vector<value::SlotAccessor*> _inSpilledSlotAccessors;
+    std::vector<std::unique_ptr<SpilledRowAccessor>> _spilledRowAccessors;
+    value::SlotMap<std::unique_ptr<value::SwitchAccessor>> _aggInputAccessors;
+
+    // Set once the hash table has reached its memory limit and new groups are being spilled.
+    bool _spilling{false};
+    std::unique_ptr<SpilledRowSorter> _sorter;
+    std::unique_ptr<SpilledRowIterator> _spilledRowsIt;
+    SpilledRow _spilledRow;
+    SpilledRow* _spilledRowPtr{&_spilledRow};
+    bool _hasSpilledRow{false};
+    bool _drainingSpilledRows{false};
+
+    HashAggStats _specificStats;
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
@@ -34,6 +34,15 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashJoinFileCounter;
+    return "extsort-hash-join-sbe." + std::to_string(hashJoinFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -43,6 +52,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
                              boost::optional<value::SlotId> collatorSlot,
+                             bool allowDiskUse,
                              PlanNodeId planNodeId)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
@@ -50,6 +60,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
       _collatorSlot(collatorSlot),
+      _allowDiskUse(allowDiskUse),
       _probeKey(0) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
@@ -59,6 +70,8 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
     _children.emplace_back(std::move(inner));
 }
 
+HashJoinStage::~HashJoinStage() {}
+
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
     return std::make_unique<HashJoinStage>(_children[0]->clone(),
                                            _children[1]->clone(),
@@ -67,6 +80,7 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _innerCond,
                                            _innerProjects,
                                            _collatorSlot,
+                                           _allowDiskUse,
                                            _commonStats.nodeId);
 }
 
@@ -111,6 +125,28 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         _outOuterAccessors[slot] = _outOuterProjectAccessors.back().get();
     }
 
+    if (_allowDiskUse) {
+        for (size_t idx = 0; idx < _innerCond.size(); ++idx) {
+            _spilledInnerAccessors.emplace_back(
+                std::make_unique<SpilledKeyAccessor>(_spilledInnerRowPtr, idx));
+            _outInnerAccessors.emplace(
+                _innerCond[idx],
+                std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                    _inInnerKeyAccessors[idx], _spilledInnerAccessors.back().get()}));
+        }
+
+        for (size_t idx = 0; idx < _innerProjects.size(); ++idx) {
+            _inInnerProjectAccessors.emplace_back(
+                _children[1]->getAccessor(ctx, _innerProjects[idx]));
+            _spilledInnerAccessors.emplace_back(
+                std::make_unique<SpilledProjectAccessor>(_spilledInnerRowPtr, idx));
+            _outInnerAccessors.emplace(
+                _innerProjects[idx],
+                std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                    _inInnerProjectAccessors.back(), _spilledInnerAccessors.back().get()}));
+        }
+    }
+
     _probeKey.resize(_inInnerKeyAccessors.size());
 
     _compiled = true;
@@ -122,7 +158,13 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
-        return _children[1]->getAccessor(ctx, slot);
+        if (!_allowDiskUse) {
+            return _children[1]->getAccessor(ctx, slot);
+        }
+
+        if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+            return it->second.get();
+        }
     }
 
     return ctx.getAccessor(slot);
@@ -142,6 +184,16 @@ void HashJoinStage::open(bool reOpen) {
         _ht.emplace();
     }
 
+    _memUsage = 0;
+    _partitions = {};
+    _hasSpilledPartitions = false;
+    _nextSpilledPartition = 0;
+    _probingSpilledRows = false;
+    _spilledInnerIt.reset();
+    for (auto&& [_, accessor] : _outInnerAccessors) {
+        accessor->setIndex(0);
+    }
+
     _commonStats.opens++;
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
@@ -163,7 +215,33 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
+        if (!_allowDiskUse) {
+            _ht->emplace(std::move(key), std::move(project));
+            continue;
+        }
+
+        auto& partition = _partitions[getPartition(key)];
+        if (partition.spilled) {
+            partition.outerWriter->addAlreadySorted(key, project);
+            ++_specificStats.spilledOuterRecords;
+            continue;
+        }
+
+        auto rowMemUsage = key.memUsageForSorter() + project.memUsageForSorter();
         _ht->emplace(std::move(key), std::move(project));
+        partition.memUsage += rowMemUsage;
+        _memUsage += rowMemUsage;
+
+        // Spill the largest partitions still held in memory until the hash table fits again.
+        while (_memUsage > _approxMemoryUseInBytesBeforeSpill) {
+            size_t largest = 0;
+            for (size_t idx = 1; idx < kNumPartitions; ++idx) {
+                if (_partitions[idx].memUsage > _partitions[largest].memUsage) {
+                    largest = idx;
+                }
+            }
+            spillPartition(largest);
+        }
     }
 
     _children[0]->close();
@@ -174,6 +252,87 @@ void HashJoinStage::open(bool reOpen) {
     _htItEnd = _ht->end();
 }
 
+size_t HashJoinStage::getPartition(const value::MaterializedRow& key) const {
+    // The hash table picks its buckets from the same hash, so mix it and use the high bits.
+    uint64_t hash = _ht->hash_function()(key);
+    return (hash * 0x9E3779B97F4A7C15ULL) >> (64 - kNumPartitionsLog2);
+}
+
+void HashJoinStage::spillPartition(size_t partitionIdx) {
+    auto& partition = _partitions[partitionIdx];
+    invariant(!partition.spilled);
+
+    auto opts = SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp");
+    auto makeWriter = [&] {
+        return std::make_unique<SpillFileWriter>(
+            opts,
+            std::make_shared<Sorter<value::MaterializedRow, value::MaterializedRow>::File>(
+                opts.tempDir + "/" + nextFileName()));
+    };
+    partition.outerWriter = makeWriter();
+    partition.innerWriter = makeWriter();
+
+    for (auto it = _ht->begin(); it != _ht->end();) {
+        if (getPartition(it->first) == partitionIdx) {
+            partition.outerWriter->addAlreadySorted(it->first, it->second);
+            ++_specificStats.spilledOuterRecords;
+            it = _ht->erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    _memUsage -= partition.memUsage;
+    partition.memUsage = 0;
+    partition.spilled = true;
+    _hasSpilledPartitions = true;
+    _specificStats.usedDisk = true;
+    ++_specificStats.spilledPartitions;
+}
+
+bool HashJoinStage::loadNextSpilledPartition() {
+    _ht->clear();
+    _htIt = _ht->end();
+    _htItEnd = _ht->end();
+
+    for (; _nextSpilledPartition < kNumPartitions; ++_nextSpilledPartition) {
+        auto& partition = _partitions[_nextSpilledPartition];
+        if (!partition.spilled) {
+            continue;
+        }
+
+        std::unique_ptr<SpillFileIterator> outerIt{partition.outerWriter->done()};
+        partition.outerWriter.reset();
+        _spilledInnerIt.reset(partition.innerWriter->done());
+        partition.innerWriter.reset();
+        if (partition.innerRecords == 0) {
+            // No inner row can match any of the outer rows of this partition.
+            continue;
+        }
+
+        // The spilled partition is loaded as a whole, even if it alone exceeds the memory limit.
+        while (outerIt->more()) {
+            auto row = outerIt->next();
+            _ht->emplace(std::move(row.first), std::move(row.second));
+        }
+        _htIt = _ht->end();
+        _htItEnd = _ht->end();
+
+        if (!_probingSpilledRows) {
+            _probingSpilledRows = true;
+            for (auto&& [_, accessor] : _outInnerAccessors) {
+                accessor->setIndex(1);
+            }
+        }
+
+        ++_nextSpilledPartition;
+        return true;
+    }
+
+    _spilledInnerIt.reset();
+    return false;
+}
+
 PlanState HashJoinStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -181,27 +340,60 @@ PlanState HashJoinStage::getNext() {
         ++_htIt;
     }
 
-    if (_htIt == _htItEnd) {
-        while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
+    while (_htIt == _htItEnd) {
+        if (_probingSpilledRows) {
+            // Probe with the inner rows of the spilled partition currently loaded.
+            if (!_spilledInnerIt || !_spilledInnerIt->more()) {
+                if (!loadNextSpilledPartition()) {
+                    return trackPlanState(PlanState::IS_EOF);
+                }
+                continue;
             }
 
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
-            }
-
-            auto [low, hi] = _ht->equal_range(_probeKey);
+            _spilledInnerRow = _spilledInnerIt->next();
+            auto [low, hi] = _ht->equal_range(_spilledInnerRow.first);
             _htIt = low;
             _htItEnd = hi;
-            // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
-            // should enumerate "non-returned" rows here.
+            continue;
+        }
+
+        auto state = _children[1]->getNext();
+        if (state == PlanState::IS_EOF) {
+            if (_hasSpilledPartitions && loadNextSpilledPartition()) {
+                continue;
+            }
+            // LEFT and OUTER joins should enumerate "non-returned" rows here.
+            return trackPlanState(state);
+        }
+
+        // Copy keys in order to do the lookup.
+        size_t idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _probeKey.reset(idx++, false, tag, val);
+        }
+
+        if (_hasSpilledPartitions) {
+            auto& partition = _partitions[getPartition(_probeKey)];
+            if (partition.spilled) {
+                value::MaterializedRow project{_inInnerProjectAccessors.size()};
+                idx = 0;
+                for (auto& p : _inInnerProjectAccessors) {
+                    auto [tag, val] = p->getViewOfValue();
+                    project.reset(idx++, false, tag, val);
+                }
+                partition.innerWriter->addAlreadySorted(_probeKey, project);
+                ++partition.innerRecords;
+                ++_specificStats.spilledInnerRecords;
+                continue;
+            }
         }
+
+        auto [low, hi] = _ht->equal_range(_probeKey);
+        _htIt = low;
+        _htItEnd = hi;
+        // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
+        // should enumerate "non-returned" rows here.
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -213,17 +405,33 @@ void HashJoinStage::close() {
     trackClose();
     _children[1]->close();
     _ht = boost::none;
+    _partitions = {};
+    _spilledInnerIt.reset();
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo && _allowDiskUse) {
+        BSONObjBuilder bob;
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledPartitions",
+                         static_cast<long long>(_specificStats.spilledPartitions));
+        bob.appendNumber("spilledOuterRecords",
+                         static_cast<long long>(_specificStats.spilledOuterRecords));
+        bob.appendNumber("spilledInnerRecords",
+                         static_cast<long long>(_specificStats.spilledInnerRecords));
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
@@ -29,10 +29,20 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class SortedFileWriter;
+}  // namespace mongo
 
 namespace mongo::sbe {
 /**
@@ -51,6 +61,16 @@ namespace mongo::sbe {
  * for string equality. For example, this can be used to perform a case-insensitive join on string
  * values.
  *
+ * If 'allowDiskUse' is true, the hash table is limited by the
+ * 'internalQuerySlotBasedExecutionHashJoinApproxMemoryUseInBytesBeforeSpill' knob and the join runs
+ * as a hybrid hash join. The rows are split by the hash of their keys into a fixed number of
+ * partitions. When the hash table exceeds its limit, its largest partition is written to a
+ * temporary file, and later rows of that partition from both sides are appended to spill files.
+ * Inner rows of the partitions kept in memory are joined as they arrive. Once the inner side is
+ * exhausted, the spilled partitions are joined one at a time. In this mode only the 'innerCond' and
+ * 'innerProjects' slots of the inner side are visible above this stage, since those are the only
+ * inner values stored in the spill files.
+ *
  * Debug string representation:
  *
  *   hj collatorSlot?
@@ -66,8 +86,11 @@ public:
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
                   boost::optional<value::SlotId> collatorSlot,
+                  bool allowDiskUse,
                   PlanNodeId planNodeId);
 
+    ~HashJoinStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -89,11 +112,47 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // A spilled row holds the join keys and the projections of one side.
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledKeyAccessor = value::MaterializedRowKeyAccessor<SpilledRow*>;
+    using SpilledProjectAccessor = value::MaterializedRowValueAccessor<SpilledRow*>;
+    using SpillFileWriter = SortedFileWriter<value::MaterializedRow, value::MaterializedRow>;
+    using SpillFileIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    static constexpr size_t kNumPartitionsLog2 = 4;
+    static constexpr size_t kNumPartitions = size_t{1} << kNumPartitionsLog2;
+
+    struct Partition {
+        bool spilled{false};
+        // Approximate size of the outer rows of this partition held in the hash table.
+        long long memUsage{0};
+        std::unique_ptr<SpillFileWriter> outerWriter;
+        std::unique_ptr<SpillFileWriter> innerWriter;
+        size_t innerRecords{0};
+    };
+
+    size_t getPartition(const value::MaterializedRow& key) const;
+
+    /**
+     * Moves the outer rows of the given partition from the hash table to a spill file. Any further
+     * rows of this partition from either side are spilled as well.
+     */
+    void spillPartition(size_t partitionIdx);
+
+    /**
+     * Loads the outer rows of the next spilled partition into the hash table and positions
+     * '_spilledInnerIt' on its inner rows. Returns false once all spilled partitions are joined.
+     */
+    bool loadNextSpilledPartition();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
     const boost::optional<value::SlotId> _collatorSlot;
+    const bool _allowDiskUse;
+    const long long _approxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -113,6 +172,15 @@ private:
     // Accessors of input condition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of inner projection values, only used when spilling is allowed.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // When spilling is allowed, the inner 'cond' and 'projects' slots are read through these
+    // accessors. They switch from the inner subtree (index 0) to the spilled inner row being probed
+    // (index 1) once the spilled partitions are joined.
+    std::vector<std::unique_ptr<value::SlotAccessor>> _spilledInnerAccessors;
+    value::SlotMap<std::unique_ptr<value::SwitchAccessor>> _outInnerAccessors;
+
     // Accessor for collator. Only set if collatorSlot provided during construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
 
@@ -123,6 +191,18 @@ private:
     TableType::iterator _htIt;
     TableType::iterator _htItEnd;
 
+    // Spilling state.
+    long long _memUsage{0};
+    std::array<Partition, kNumPartitions> _partitions;
+    bool _hasSpilledPartitions{false};
+    size_t _nextSpilledPartition{0};
+    bool _probingSpilledRows{false};
+    std::unique_ptr<SpillFileIterator> _spilledInnerIt;
+    SpilledRow _spilledInnerRow;
+    SpilledRow* _spilledInnerRowPtr{&_spilledInnerRow};
+
+    HashJoinStats _specificStats;
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
@@ -115,6 +115,7 @@ private:
 
     const KeyString::Value& getSeekKeyLow() const;
     const KeyString::Value* getSeekKeyHigh() const;
+    bool canReuseLookAheadEntry() const;
 
     const CollectionUUID _collUuid;
     const std::string _indexName;
@@ -154,6 +155,12 @@ private:
     boost::optional<Ordering> _ordering{boost::none};
     boost::optional<KeyStringEntry> _nextRecord;
 
+    // When the last scan stopped because '_nextRecord' passed its high seek key, this holds that
+    // key and '_lookAheadValid' is set, allowing the next reopen to avoid re-seeking the cursor.
+    // Created in prepare() with the KeyString version of the index.
+    boost::optional<KeyString::Builder> _lookAheadBound;
+    bool _lookAheadValid{false};
+
     // This buffer stores values that are projected out of the index entry. Values in the
     // '_accessors' list that are pointers point to data in this buffer.
     BufBuilder _valuesBuffer;
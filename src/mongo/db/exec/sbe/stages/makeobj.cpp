@@ -250,6 +250,17 @@ void MakeObjStageBase<MakeObjOutputType::bsonObject>::produceObject() {
                 auto be = value::bitcastTo<const char*>(val);
                 // Skip document length.
                 be += 4;
+
+                // Fields that are carried over are copied in runs: consecutive fields are
+                // contiguous in the input, so each run is appended with a single copy.
+                const char* runStart = nullptr;
+                auto flushRun = [&](const char* runEnd) {
+                    if (runStart) {
+                        bob.bb().appendBuf(runStart, runEnd - runStart);
+                        runStart = nullptr;
+                    }
+                };
+
                 while (*be != 0) {
                     auto sv = bson::fieldNameView(be);
                     auto key = StringMapHasher{}.hashed_key(StringData(sv));
@@ -257,17 +268,21 @@ void MakeObjStageBase<MakeObjOutputType::bsonObject>::produceObject() {
                     auto nextBe = bson::advance(be, sv.size());
 
                     if (!isFieldProjectedOrRestricted(key)) {
-                        bob.append(BSONElement(
-                            be, sv.size() + 1, nextBe - be, BSONElement::CachedSizeTag{}));
+                        if (!runStart) {
+                            runStart = be;
+                        }
                         --nFieldsNeededIfInclusion;
+                    } else {
+                        flushRun(be);
                     }
 
+                    be = nextBe;
+
                     if (nFieldsNeededIfInclusion == 0 && _fieldBehavior == FieldBehavior::keep) {
                         break;
                     }
-
-                    be = nextBe;
                 }
+                flushRun(be);
             }
         } else if (tag == value::TypeTags::Object) {
             if (!(nFieldsNeededIfInclusion == 0 && _fieldBehavior == FieldBehavior::keep)) {
@@ -183,6 +183,47 @@ struct LoopJoinStats final : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        summary.usedDisk = summary.usedDisk || usedDisk;
+    }
+
+    bool usedDisk{false};
+    // The number of sorted runs of spilled input rows written to disk.
+    size_t spills{0};
+    // The number of input rows which were spilled rather than aggregated in the hash table.
+    size_t spilledRecords{0};
+};
+
+struct HashJoinStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashJoinStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        summary.usedDisk = summary.usedDisk || usedDisk;
+    }
+
+    bool usedDisk{false};
+    // The number of hash table partitions written to disk.
+    size_t spilledPartitions{0};
+    // The number of outer and inner rows which were written to disk.
+    size_t spilledOuterRecords{0};
+    size_t spilledInnerRecords{0};
+};
+
 struct TraverseStats : public SpecificStats {
     std::unique_ptr<SpecificStats> clone() const final {
         return std::make_unique<TraverseStats>(*this);
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_set.h>
 #include <queue>
 
 #include "mongo/db/exec/sbe/stages/stages.h"
@@ -73,7 +74,7 @@ private:
     std::vector<value::SlotAccessor*> _inKeyAccessors;
 
     // Table of keys that have been seen.
-    stdx::unordered_set<value::MaterializedRow,
+    absl::flat_hash_set<value::MaterializedRow,
                         value::MaterializedRowHasher,
                         value::MaterializedRowEq>
         _seen;
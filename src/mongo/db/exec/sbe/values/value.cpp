@@ -148,11 +148,29 @@ void PcreRegex::_compile() {
     int eoffset;
     _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
     uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
+
+    // The same compiled regex is typically executed against every input document, so it is worth
+    // paying for the study pass once up front.
+    const char* studyError = nullptr;
+    _pcreExtraPtr = pcre_study(_pcrePtr, 0, &studyError);
+    if (studyError) {
+        _free();
+        uasserted(6105700, str::stream() << "Invalid Regex: " << studyError);
+    }
+}
+
+void PcreRegex::_free() {
+    if (_pcreExtraPtr) {
+        pcre_free_study(_pcreExtraPtr);
+        _pcreExtraPtr = nullptr;
+    }
+    (*pcre_free)(_pcrePtr);
+    _pcrePtr = nullptr;
 }
 
 int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& buf) {
     return pcre_exec(_pcrePtr,
-                     nullptr,
+                     _pcreExtraPtr,
                      stringView.rawData(),
                      stringView.size(),
                      startPos,
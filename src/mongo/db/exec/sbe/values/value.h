@@ -38,6 +38,7 @@
 #include <ostream>
 #include <pcre.h>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -639,7 +640,7 @@ public:
 
     PcreRegex& operator=(const PcreRegex& other) {
         if (this != &other) {
-            (*pcre_free)(_pcrePtr);
+            _free();
             _pattern = other._pattern;
             _options = other._options;
             _compile();
@@ -648,7 +649,7 @@ public:
     }
 
     ~PcreRegex() {
-        (*pcre_free)(_pcrePtr);
+        _free();
     }
 
     const std::string& pattern() const {
@@ -676,11 +677,16 @@ public:
 
 private:
     void _compile();
+    void _free();
 
     std::string _pattern;
     std::string _options;
 
     pcre* _pcrePtr = nullptr;
+    // Result of studying the compiled pattern, which lets pcre_exec() skip start positions that
+    // cannot begin a match (for example by scanning for a literal first byte). May be null when
+    // studying yields nothing useful.
+    pcre_extra* _pcreExtraPtr = nullptr;
 };
 
 constexpr size_t kSmallStringMaxLength = 7;
@@ -860,18 +866,24 @@ inline std::pair<TypeTags, Value> makeSmallString(StringData input) {
     return {TypeTags::StringSmall, smallString};
 }
 
-inline std::pair<TypeTags, Value> makeBigString(StringData input) {
-    auto len = input.size();
-    auto ptr = input.rawData();
-
+/**
+ * Allocates a StringBig value of 'len' characters and returns it along with a pointer to its
+ * character buffer, which the caller is responsible for filling in.
+ */
+inline std::tuple<TypeTags, Value, char*> makeUninitializedBigString(size_t len) {
     invariant(len < static_cast<uint32_t>(std::numeric_limits<int32_t>::max()));
 
     auto length = static_cast<uint32_t>(len);
     auto buf = new char[length + 5];
     DataView(buf).write<LittleEndian<int32_t>>(length + 1);
-    memcpy(buf + 4, ptr, length);
     buf[length + 4] = 0;
-    return {TypeTags::StringBig, reinterpret_cast<Value>(buf)};
+    return {TypeTags::StringBig, reinterpret_cast<Value>(buf), buf + 4};
+}
+
+inline std::pair<TypeTags, Value> makeBigString(StringData input) {
+    auto [tag, val, chars] = makeUninitializedBigString(input.size());
+    memcpy(chars, input.rawData(), input.size());
+    return {tag, val};
 }
 
 inline std::pair<TypeTags, Value> makeNewString(StringData input) {
@@ -2301,16 +2301,35 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinRound(ArityType
 }
 
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinConcat(ArityType arity) {
-    StringBuilder result;
+    // Size the result up front so that the arguments can be copied straight into the buffer of the
+    // resulting value, without going through an intermediate string.
+    size_t length = 0;
     for (ArityType idx = 0; idx < arity; ++idx) {
         auto [_, tag, value] = getFromStack(idx);
         if (!value::isString(tag)) {
             return {false, value::TypeTags::Nothing, 0};
         }
-        result << sbe::value::getStringView(tag, value);
+        length += value::getStringView(tag, value).size();
+    }
+
+    auto appendArgs = [&](char* out) {
+        for (ArityType idx = 0; idx < arity; ++idx) {
+            auto [_, tag, value] = getFromStack(idx);
+            auto str = value::getStringView(tag, value);
+            memcpy(out, str.rawData(), str.size());
+            out += str.size();
+        }
+    };
+
+    if (length <= value::kSmallStringMaxLength) {
+        char buf[value::kSmallStringMaxLength];
+        appendArgs(buf);
+        auto [strTag, strValue] = value::makeNewString({buf, length});
+        return {true, strTag, strValue};
     }
 
-    auto [strTag, strValue] = sbe::value::makeNewString(result.str());
+    auto [strTag, strValue, chars] = value::makeUninitializedBigString(length);
+    appendArgs(chars);
     return {true, strTag, strValue};
 }
 
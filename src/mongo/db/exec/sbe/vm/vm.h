@@ -50,6 +50,30 @@ std::pair<value::TypeTags, value::Value> genericCompare(
     value::Value rhsValue,
     const StringData::ComparatorInterface* comparator = nullptr,
     Op op = {}) {
+    // Comparing values of the same numeric type, typically a field against a constant of the type
+    // the field is stored as, needs none of the widening below.
+    if (lhsTag == rhsTag) {
+        switch (lhsTag) {
+            case value::TypeTags::NumberInt32: {
+                auto result =
+                    op(value::bitcastTo<int32_t>(lhsValue), value::bitcastTo<int32_t>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom<bool>(result)};
+            }
+            case value::TypeTags::NumberInt64: {
+                auto result =
+                    op(value::bitcastTo<int64_t>(lhsValue), value::bitcastTo<int64_t>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom<bool>(result)};
+            }
+            case value::TypeTags::NumberDouble: {
+                auto result =
+                    op(value::bitcastTo<double>(lhsValue), value::bitcastTo<double>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom<bool>(result)};
+            }
+            default:
+                break;
+        }
+    }
+
     if (value::isNumber(lhsTag) && value::isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
             case value::TypeTags::NumberInt32: {
@@ -42,9 +42,16 @@ size_t getTrialPeriodMaxWorks(OperationContext* opCtx, const CollectionPtr& coll
         // For large collections, the number of works is set to be this fraction of the collection
         // size.
         double fraction = internalQueryPlanEvaluationCollFraction;
+        size_t fractionWorks = static_cast<size_t>(fraction * collection->numRecords(opCtx));
 
-        numWorks = std::max(static_cast<size_t>(internalQueryPlanEvaluationWorks.load()),
-                            static_cast<size_t>(fraction * collection->numRecords(opCtx)));
+        // With many candidate plans on a big collection, every candidate may be worked this many
+        // times, so allow the growth with the collection size to be bounded.
+        if (auto maxWorks = internalQueryPlanEvaluationMaxWorks.load(); maxWorks > 0) {
+            fractionWorks = std::min(fractionWorks, static_cast<size_t>(maxWorks));
+        }
+
+        numWorks =
+            std::max(static_cast<size_t>(internalQueryPlanEvaluationWorks.load()), fractionWorks);
     }
 
     return numWorks;
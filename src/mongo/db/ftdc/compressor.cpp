@@ -130,7 +130,9 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
 
     if (_metricsCount != 0 && _deltaCount != 0) {
         // On average, we do not need all 10 bytes for every sample, worst case, we grow the buffer
-        DataBuilder db(_metricsCount * _deltaCount * FTDCVarInt::kMaxSizeBytes64 / 2);
+        auto& db = _compactedMetricsBuffer;
+        db.clear();
+        db.reserve(_metricsCount * _deltaCount * FTDCVarInt::kMaxSizeBytes64 / 2);
 
         std::uint32_t zeroesCount = 0;
 
@@ -35,6 +35,7 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/base/data_builder.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/ftdc/block_compressor.h"
@@ -183,6 +184,9 @@ private:
     // Buffer for uncompressed metric chunk
     BufBuilder _uncompressedChunkBuffer;
 
+    // Buffer for the RLE and VarInt packed deltas, reused across chunks
+    DataBuilder _compactedMetricsBuffer;
+
     // Buffer to hold metrics
     std::vector<std::uint64_t> _metrics;
     std::vector<std::uint64_t> _prevmetrics;
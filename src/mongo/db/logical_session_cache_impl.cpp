@@ -312,6 +312,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     LogicalSessionRecordSet activeSessionRecords;
 
     auto runningOpSessions = _service->getActiveOpSessions();
+    activeSessionRecords.reserve(runningOpSessions.size() + activeSessions.size());
 
     for (const auto& it : runningOpSessions) {
         // if a running op is the cause of an upsert, we won't have a user name for the record
@@ -51,6 +51,8 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/op_observer_util.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/ops/update.h"
+#include "mongo/db/ops/update_request.h"
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/image_collection_entry_gen.h"
 #include "mongo/db/repl/oplog.h"
@@ -279,8 +281,19 @@ void writeToImageCollection(OperationContext* opCtx,
     AllowLockAcquisitionOnTimestampedUnitOfWork allowLockAcquisition(opCtx->lockState());
     AutoGetCollection imageCollectionRaii(
         opCtx, NamespaceString::kConfigImagesNamespace, LockMode::MODE_IX);
-    UpdateResult res = Helpers::upsert(
-        opCtx, NamespaceString::kConfigImagesNamespace.toString(), imageEntry.toBSON());
+
+    // Build the _id upsert directly against the database we already hold rather than going
+    // through Helpers::upsert. Its OldClientContext would look the database up again, check the
+    // shard version of this unsharded internal collection and repoint CurOp at it, all of which
+    // is wasted work on every retryable findAndModify.
+    UpdateRequest request;
+    request.setNamespaceString(NamespaceString::kConfigImagesNamespace);
+    request.setQuery(BSON("_id" << imageEntry.get_id().toBSON()));
+    request.setUpdateModification(
+        write_ops::UpdateModification::parseFromClassicUpdate(imageEntry.toBSON()));
+    request.setUpsert();
+    request.setYieldPolicy(PlanYieldPolicy::YieldPolicy::NO_YIELD);
+    UpdateResult res = ::mongo::update(opCtx, imageCollectionRaii.getDb(), request);
     invariant(res.numDocsModified == 1 || !res.upsertedId.isEmpty());
 }
 
@@ -128,6 +128,25 @@ TEST_F(OperationCPUTimerTest, TestTimerDetachAndAttachHandlers) {
     observer.join();
 }
 
+TEST_F(OperationCPUTimerTest, TimerKeepsElapsedTimeAcrossDetachAndAttach) {
+    auto timer = getTimer();
+    auto detachAndAttach = [&] {
+        auto client = makeClient();
+        AlternativeClientRegion acr(client);
+    };
+
+    timer->start();
+    busyWait(Microseconds(100));
+    detachAndAttach();
+    const auto elapsedAfterFirstDetach = timer->getElapsed();
+    ASSERT_GTE(elapsedAfterFirstDetach, Microseconds(100));
+
+    // Time accumulated before an earlier detach must not be lost by later ones.
+    detachAndAttach();
+    ASSERT_GTE(timer->getElapsed(), elapsedAfterFirstDetach);
+    timer->stop();
+}
+
 DEATH_TEST_F(OperationCPUTimerTest,
              AccessTimerForDetachedOperation,
              "Operation not attached to the current thread") {
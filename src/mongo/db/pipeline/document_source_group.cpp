@@ -29,8 +29,11 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
 #include <memory>
 
+#include "mongo/base/init.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
@@ -40,8 +43,13 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -61,6 +69,67 @@ std::string nextFileName() {
     return "extsort-doc-group." + std::to_string(documentSourceGroupFileCounter.fetchAndAdd(1));
 }
 
+/**
+ * Worker threads used to aggregate slices of the input of a parallel $group.
+ */
+std::unique_ptr<ThreadPool> groupThreadPool;
+MONGO_INITIALIZER(DocumentSourceGroupThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "parallel $group pool";
+    options.threadNamePrefix = "GroupWorker";
+    options.minThreads = 0;
+    options.maxThreads = 64;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName);
+    };
+    groupThreadPool = std::make_unique<ThreadPool>(options);
+    groupThreadPool->startup();
+}
+
+/**
+ * The accumulators whose partial states can be produced by getValue(true) and combined by
+ * process(..., true), as is done when merging the results of a $group split across shards. The
+ * JavaScript-based $accumulator is deliberately absent.
+ */
+const StringDataSet kParallelizableAccumulators{"$addToSet",
+                                                "$avg",
+                                                "$first",
+                                                "$last",
+                                                "$max",
+                                                "$mergeObjects",
+                                                "$min",
+                                                "$push",
+                                                "$stdDevPop",
+                                                "$stdDevSamp",
+                                                "$sum"};
+
+/**
+ * The name under which the input buffered by a parallel $group is charged to its memory tracker.
+ * Accumulator field names cannot start with '$', so this never collides with one of them.
+ */
+constexpr StringData kParallelSlicesMemoryName = "$parallelSlices"_sd;
+
+/**
+ * Returns true if 'expr' can be evaluated from several threads at once. Only field paths rooted at
+ * the input document, constants, and objects composed of those qualify: they neither read user
+ * variables nor the document metadata, and have no mutable state of their own.
+ */
+bool isSafeForConcurrentEvaluation(const Expression* expr) {
+    if (dynamic_cast<const ExpressionConstant*>(expr)) {
+        return true;
+    }
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+        return !fieldPath->isVariableReference() && fieldPath->getFieldPath().getPathLength() > 1;
+    }
+    if (dynamic_cast<const ExpressionObject*>(expr)) {
+        const auto& children = expr->getChildren();
+        return std::all_of(children.begin(), children.end(), [](auto&& child) {
+            return child && isSafeForConcurrentEvaluation(child.get());
+        });
+    }
+    return false;
+}
+
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -116,9 +185,10 @@ DocumentSource::GetModPathsReturn GroupFromFirstDocumentTransformation::getModif
 std::unique_ptr<GroupFromFirstDocumentTransformation> GroupFromFirstDocumentTransformation::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     const std::string& groupId,
-    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs) {
-    return std::make_unique<GroupFromFirstDocumentTransformation>(groupId,
-                                                                  std::move(accumulatorExprs));
+    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs,
+    ExpectedInput expectedInput) {
+    return std::make_unique<GroupFromFirstDocumentTransformation>(
+        groupId, std::move(accumulatorExprs), expectedInput);
 }
 
 constexpr StringData DocumentSourceGroup::kStageName;
@@ -527,11 +597,198 @@ private:
 };
 }  // namespace
 
+struct DocumentSourceGroup::InputSlice {
+    // The input documents, stored as BSON so that each worker builds Documents with storage of its
+    // own. Documents share lazily populated storage and so cannot be read by two threads at once.
+    std::vector<BSONObj> inputs;
+
+    // The total size of 'inputs', which is charged to the stage's memory tracker until the slice
+    // has been merged.
+    long long inputBytes = 0;
+
+    // Populated by aggregateSlice().
+    boost::optional<GroupsMap> groups;
+};
+
+size_t DocumentSourceGroup::getParallelism() const {
+    const int maxParallelism = internalDocumentSourceGroupMaxParallelism.load();
+    if (maxParallelism <= 1) {
+        return 1;
+    }
+
+    for (auto&& idExpression : _idExpressions) {
+        if (!isSafeForConcurrentEvaluation(idExpression.get())) {
+            return 1;
+        }
+    }
+    for (auto&& accumulatedField : _accumulatedFields) {
+        if (!kParallelizableAccumulators.count(accumulatedField.expr.name) ||
+            !isSafeForConcurrentEvaluation(accumulatedField.expr.initializer.get()) ||
+            !isSafeForConcurrentEvaluation(accumulatedField.expr.argument.get())) {
+            return 1;
+        }
+    }
+    return maxParallelism;
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::aggregateInParallel(size_t parallelism) {
+    const size_t sliceSize = internalDocumentSourceGroupParallelSliceSize.load();
+
+    // The buffered input counts against the $group memory limit. Slices are also cut short by size
+    // so that the slices being filled and aggregated together take at most half of that limit,
+    // leaving the rest for '_groups'.
+    const long long maxSliceBytes = std::max<long long>(
+        1, _memoryTracker._maxAllowedMemoryUsageBytes / (2 * (parallelism + 1)));
+    long long bufferedBytes = 0;
+    auto chargeBufferedBytes = [&](long long diff) {
+        bufferedBytes += diff;
+        // Set the total rather than apply the difference, as a spill resets the tracker.
+        _memoryTracker.set(kParallelSlicesMemoryName, bufferedBytes);
+    };
+
+    // Slices are merged into '_groups' in the order they were read, so order-sensitive
+    // accumulators like $first and $push see their input in the same order as a serial $group.
+    std::deque<std::pair<std::shared_ptr<InputSlice>, Future<void>>> inFlight;
+
+    // The workers reference this stage, so never leave with a slice still being aggregated.
+    ON_BLOCK_EXIT([&] {
+        for (auto&& slice : inFlight) {
+            slice.second.waitNoThrow().ignore();
+        }
+    });
+
+    auto mergeOldestSlice = [&] {
+        auto slice = std::move(inFlight.front().first);
+        auto aggregated = std::move(inFlight.front().second);
+        inFlight.pop_front();
+        aggregated.get();
+        chargeBufferedBytes(-slice->inputBytes);
+        mergeSlice(slice.get());
+    };
+
+    auto slice = std::make_shared<InputSlice>();
+    GetNextResult input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        // Converting the input to BSON still happens on this thread. It is cheap for documents
+        // read straight from storage, which are trivially convertible, but a document produced
+        // by an earlier stage is serialized here in full.
+        const auto& rootDocument = input.getDocument();
+        if (auto bson = rootDocument.toBsonIfTriviallyConvertible()) {
+            slice->inputs.push_back(bson->getOwned());
+        } else {
+            try {
+                slice->inputs.push_back(rootDocument.toBson());
+            } catch (const ExceptionFor<ErrorCodes::BSONObjectTooLarge>&) {
+                // A serial $group accepts intermediate documents too large for BSON. Hand this
+                // document, and the rest of the input, back to it once the slices read so far
+                // have been merged.
+                break;
+            }
+        }
+        slice->inputBytes += slice->inputs.back().objsize();
+        chargeBufferedBytes(slice->inputs.back().objsize());
+        if (slice->inputs.size() < sliceSize && slice->inputBytes < maxSliceBytes) {
+            continue;
+        }
+
+        if (inFlight.size() == parallelism) {
+            mergeOldestSlice();
+        }
+        auto pf = makePromiseFuture<void>();
+        groupThreadPool->schedule(
+            [this, slice, promise = std::move(pf.promise)](auto status) mutable {
+                promise.setWith([&] {
+                    uassertStatusOK(status);
+                    aggregateSlice(slice.get());
+                });
+            });
+        inFlight.emplace_back(std::move(slice), std::move(pf.future));
+        slice = std::make_shared<InputSlice>();
+    }
+
+    // The final, partial slice is aggregated on this thread while the workers finish. This is also
+    // all the work there is for an input smaller than a single slice.
+    aggregateSlice(slice.get());
+    while (!inFlight.empty()) {
+        mergeOldestSlice();
+    }
+    chargeBufferedBytes(-slice->inputBytes);
+    mergeSlice(slice.get());
+
+    return input;
+}
+
+void DocumentSourceGroup::aggregateSlice(InputSlice* slice) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    slice->groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    for (auto&& bson : slice->inputs) {
+        Document rootDocument(bson);
+        Value id = computeId(rootDocument);
+
+        const size_t oldSize = slice->groups->size();
+        Accumulators& group = (*slice->groups)[id];
+        if (slice->groups->size() != oldSize) {
+            Value expandedId = expandId(id);
+            Document idDoc =
+                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+            group.reserve(numAccumulators);
+            for (auto&& accumulatedField : _accumulatedFields) {
+                auto accum = accumulatedField.makeAccumulator();
+                accum->startNewGroup(
+                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables));
+                group.push_back(std::move(accum));
+            }
+        }
+
+        for (size_t i = 0; i < numAccumulators; i++) {
+            group[i]->process(
+                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+                _doingMerge);
+        }
+    }
+
+    // The input is no longer needed once it has been aggregated.
+    slice->inputs = {};
+}
+
+void DocumentSourceGroup::mergeSlice(InputSlice* slice) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    for (auto&& [id, partialGroup] : *slice->groups) {
+        if (shouldSpillWithAttemptToSaveMemory()) {
+            _sortedFiles.push_back(spill());
+        }
+
+        const size_t oldSize = _groups->size();
+        Accumulators& group = (*_groups)[id];
+        if (_groups->size() != oldSize) {
+            // The first partial state seen for a group is adopted as is.
+            _memoryTracker.set(_memoryTracker.currentMemoryBytes() + id.getApproximateSize());
+            group = std::move(partialGroup);
+            for (size_t i = 0; i < numAccumulators; i++) {
+                _memoryTracker.update(_accumulatedFields[i].fieldName, group[i]->getMemUsage());
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < numAccumulators; i++) {
+            _memoryTracker.update(_accumulatedFields[i].fieldName, -1 * group[i]->getMemUsage());
+            group[i]->process(partialGroup[i]->getValue(true /* toBeMerged */), true);
+            _memoryTracker.update(_accumulatedFields[i].fieldName, group[i]->getMemUsage());
+        }
+    }
+    slice->groups = boost::none;
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. A parallel $group
+    // usually consumes the whole input in aggregateInParallel(), so the loop below only runs for
+    // the input it handed back.
+    const size_t parallelism = getParallelism();
+    GetNextResult input = parallelism > 1 ? aggregateInParallel(parallelism) : pSource->getNext();
 
     for (; input.isAdvanced(); input = pSource->getNext()) {
         if (shouldSpillWithAttemptToSaveMemory()) {
@@ -837,13 +1094,22 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
 
     const auto groupId = fieldPath.tail().fullPath();
 
-    // We can't do this transformation if there are any non-$first accumulators.
+    // We can't do this transformation unless the accumulators are all $first or all $last.
+    boost::optional<AccumulatorDocumentsNeeded> documentsNeeded;
     for (auto&& accumulator : _accumulatedFields) {
-        if (AccumulatorDocumentsNeeded::kFirstDocument !=
-            accumulator.makeAccumulator()->documentsNeeded()) {
+        auto needed = accumulator.makeAccumulator()->documentsNeeded();
+        if (needed != AccumulatorDocumentsNeeded::kFirstDocument &&
+            needed != AccumulatorDocumentsNeeded::kLastDocument) {
+            return nullptr;
+        }
+        if (documentsNeeded && *documentsNeeded != needed) {
             return nullptr;
         }
+        documentsNeeded = needed;
     }
+    const auto expectedInput = documentsNeeded == AccumulatorDocumentsNeeded::kLastDocument
+        ? GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument
+        : GroupFromFirstDocumentTransformation::ExpectedInput::kFirstDocument;
 
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> fields;
 
@@ -862,11 +1128,12 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     for (auto&& accumulator : _accumulatedFields) {
         fields.push_back(std::make_pair(accumulator.fieldName, accumulator.expr.argument));
 
-        // Since we don't attempt this transformation for non-$first accumulators,
-        // the initializer should always be trivial.
+        // Since we don't attempt this transformation for accumulators other than $first and
+        // $last, the initializer should always be trivial.
     }
 
-    return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
+    return GroupFromFirstDocumentTransformation::create(
+        pExpCtx, groupId, std::move(fields), expectedInput);
 }
 
 size_t DocumentSourceGroup::getMaxMemoryUsageBytes() const {
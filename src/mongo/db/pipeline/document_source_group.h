@@ -49,10 +49,19 @@ namespace mongo {
  */
 class GroupFromFirstDocumentTransformation final : public TransformerInterface {
 public:
+    /**
+     * Which document of each group the transformation must be applied to. When it is the last
+     * document, the caller must feed it groups in the reverse of the order the $group saw them.
+     */
+    enum class ExpectedInput { kFirstDocument, kLastDocument };
+
     GroupFromFirstDocumentTransformation(
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs)
-        : _accumulatorExprs(std::move(accumulatorExprs)), _groupId(groupId) {}
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument)
+        : _accumulatorExprs(std::move(accumulatorExprs)),
+          _groupId(groupId),
+          _expectedInput(expectedInput) {}
 
     TransformerType getType() const final {
         return TransformerType::kGroupFromFirstDocument;
@@ -66,6 +75,10 @@ public:
         return _groupId;
     }
 
+    ExpectedInput expectedInput() const {
+        return _expectedInput;
+    }
+
     Document applyTransformation(const Document& input) final;
 
     void optimize() final;
@@ -80,11 +93,13 @@ public:
     static std::unique_ptr<GroupFromFirstDocumentTransformation> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs);
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument);
 
 private:
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _accumulatorExprs;
     std::string _groupId;
+    ExpectedInput _expectedInput;
 };
 
 class DocumentSourceGroup final : public DocumentSource {
@@ -175,7 +190,9 @@ public:
     /**
      * When possible, creates a document transformer that transforms the first document in a group
      * into one of the output documents of the $group stage. This is possible when we are grouping
-     * on a single field and all accumulators are $first (or there are no accumluators).
+     * on a single field and all accumulators are $first (or there are no accumluators). It is also
+     * possible when all accumulators are $last, in which case the transformation expects the last
+     * document of each group instead (see GroupFromFirstDocumentTransformation::expectedInput()).
      *
      * It is sometimes possible to use a DISTINCT_SCAN to scan the first document of each group,
      * in which case this transformation can replace the actual $group stage in the pipeline
@@ -217,6 +234,41 @@ private:
      */
     GetNextResult initialize();
 
+    /**
+     * A contiguous range of the input which a worker thread aggregates into its own partial
+     * groups map when the $group runs in parallel. Defined in the .cpp file.
+     */
+    struct InputSlice;
+
+    /**
+     * Returns the number of threads which may aggregate slices of the input concurrently, or 1 if
+     * this $group must run serially. A parallel $group requires that the group key and the
+     * arguments of every accumulator be safe to evaluate from several threads at once, and that
+     * every accumulator supports merging its partial states.
+     */
+    size_t getParallelism() const;
+
+    /**
+     * Exhausts 'pSource' by cutting the input into slices of consecutive documents, aggregating
+     * up to 'parallelism' slices concurrently, and merging each slice's partial groups into
+     * '_groups' in input order. The input buffered in slices is charged to '_memoryTracker' until
+     * it has been merged. Returns the kEOF or kPauseExecution result which ended the input, or
+     * the first document too large to be serialized for a slice. The caller then aggregates that
+     * document and the rest of the input serially.
+     */
+    GetNextResult aggregateInParallel(size_t parallelism);
+
+    /**
+     * Aggregates the documents of 'slice' into the slice's own groups map. Called on a worker
+     * thread, so it must not touch '_groups' or '_memoryTracker'.
+     */
+    void aggregateSlice(InputSlice* slice);
+
+    /**
+     * Merges the partial groups of an aggregated 'slice' into '_groups', spilling as needed.
+     */
+    void mergeSlice(InputSlice* slice);
+
     /**
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
@@ -50,11 +50,13 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -245,6 +247,164 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldMatchSerialGroup) {
+    auto expCtx = getExpCtx();
+    const auto spec = fromjson(
+        "{$group: {_id: {k: '$k'}, total: {$sum: '$v'}, all: {$push: '$v'}, first: {$first: "
+        "'$v'}, last: {$last: '$v'}, avg: {$avg: '$v'}}}");
+
+    // Build an input in which every group spans several slices, with a pause in the middle.
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50; ++i) {
+        inputs.emplace_back(Document{{"k", i % 3}, {"v", i}});
+        if (i == 25) {
+            inputs.emplace_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+    }
+
+    auto runGroup = [&] {
+        auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+        auto mock = DocumentSourceMock::createForTest(inputs, expCtx);
+        group->setSource(mock.get());
+
+        ASSERT_TRUE(group->getNext().isPaused());
+        std::map<int, Document> results;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            auto doc = next.releaseDocument();
+            results.emplace(doc["_id"]["k"].getInt(), doc);
+        }
+        return results;
+    };
+
+    const auto serialResults = runGroup();
+
+    const auto originalParallelism = internalDocumentSourceGroupMaxParallelism.load();
+    const auto originalSliceSize = internalDocumentSourceGroupParallelSliceSize.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceGroupMaxParallelism.store(originalParallelism);
+        internalDocumentSourceGroupParallelSliceSize.store(originalSliceSize);
+    });
+    internalDocumentSourceGroupMaxParallelism.store(4);
+    internalDocumentSourceGroupParallelSliceSize.store(4);
+
+    const auto parallelResults = runGroup();
+    ASSERT_EQ(serialResults.size(), 3UL);
+    ASSERT_EQ(parallelResults.size(), serialResults.size());
+    for (auto&& [key, doc] : serialResults) {
+        ASSERT_DOCUMENT_EQ(parallelResults.at(key), doc);
+    }
+    ASSERT_VALUE_EQ(parallelResults.at(1)["first"], Value(1));
+    ASSERT_VALUE_EQ(parallelResults.at(1)["last"], Value(49));
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldFallBackToSerialForUnsafeExpressions) {
+    auto expCtx = getExpCtx();
+    const auto originalParallelism = internalDocumentSourceGroupMaxParallelism.load();
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGroupMaxParallelism.store(originalParallelism); });
+    internalDocumentSourceGroupMaxParallelism.store(4);
+
+    // A computed group key is evaluated by the calling thread only.
+    const auto spec = fromjson(
+        "{$group: {_id: {$add: ['$k', 1]}, total: {$sum: '$v'}, root: {$push: '$$ROOT'}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    auto mock = DocumentSourceMock::createForTest({Document{{"k", 1}, {"v", 2}}}, expCtx);
+    group->setSource(mock.get());
+
+    auto next = group->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto doc = next.releaseDocument();
+    ASSERT_VALUE_EQ(doc["_id"], Value(2));
+    ASSERT_VALUE_EQ(doc["total"], Value(2));
+    ASSERT_VALUE_EQ(doc["root"], Value(std::vector<Value>{Value(Document{{"k", 1}, {"v", 2}})}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldBoundBufferedInputByMemoryLimit) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    const auto originalParallelism = internalDocumentSourceGroupMaxParallelism.load();
+    const auto originalMaxMemoryBytes = internalDocumentSourceGroupMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceGroupMaxParallelism.store(originalParallelism);
+        internalDocumentSourceGroupMaxMemoryBytes.store(originalMaxMemoryBytes);
+    });
+    internalDocumentSourceGroupMaxParallelism.store(4);
+    internalDocumentSourceGroupMaxMemoryBytes.store(10000);
+
+    // The input is larger than the memory limit, but its groups are tiny. The buffered input is
+    // charged to the memory tracker, so this only succeeds if slices are cut short by size rather
+    // than buffered up to the default slice length.
+    string largeStr(500, 'x');
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50; ++i) {
+        inputs.emplace_back(Document{{"k", i % 2}, {"largeStr", largeStr}});
+    }
+
+    const auto spec = fromjson("{$group: {_id: '$k', count: {$sum: 1}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    auto mock = DocumentSourceMock::createForTest(inputs, expCtx);
+    group->setSource(mock.get());
+
+    std::map<int, long long> counts;
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        auto doc = next.releaseDocument();
+        counts.emplace(doc["_id"].getInt(), doc["count"].coerceToLong());
+    }
+    ASSERT_EQ(counts.size(), 2UL);
+    ASSERT_EQ(counts.at(0), 25);
+    ASSERT_EQ(counts.at(1), 25);
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldFallBackToSerialForTooLargeInput) {
+    auto expCtx = getExpCtx();
+    const auto originalParallelism = internalDocumentSourceGroupMaxParallelism.load();
+    const auto originalSliceSize = internalDocumentSourceGroupParallelSliceSize.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceGroupMaxParallelism.store(originalParallelism);
+        internalDocumentSourceGroupParallelSliceSize.store(originalSliceSize);
+    });
+    internalDocumentSourceGroupMaxParallelism.store(4);
+    internalDocumentSourceGroupParallelSliceSize.store(2);
+
+    // Documents produced by an earlier stage may exceed the BSON size limit. The one in the middle
+    // of this input cannot be serialized for a slice, so it and the rest of the input are grouped
+    // serially.
+    const string largeStr(BSONObjMaxUserSize / 3 + 1, 'x');
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 10; ++i) {
+        if (i == 5) {
+            inputs.emplace_back(Document{{"k", i % 2},
+                                         {"v", i},
+                                         {"a", largeStr},
+                                         {"b", largeStr},
+                                         {"c", largeStr},
+                                         {"d", largeStr}});
+        } else {
+            inputs.emplace_back(Document{{"k", i % 2}, {"v", i}});
+        }
+    }
+    ASSERT_THROWS_CODE(
+        inputs[5].getDocument().toBson(), AssertionException, ErrorCodes::BSONObjectTooLarge);
+
+    const auto spec = fromjson("{$group: {_id: '$k', count: {$sum: 1}, total: {$sum: '$v'}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    auto mock = DocumentSourceMock::createForTest(inputs, expCtx);
+    group->setSource(mock.get());
+
+    std::map<int, Document> results;
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        auto doc = next.releaseDocument();
+        results.emplace(doc["_id"].getInt(), doc);
+    }
+    ASSERT_EQ(results.size(), 2UL);
+    ASSERT_VALUE_EQ(results.at(0)["count"], Value(5));
+    ASSERT_VALUE_EQ(results.at(0)["total"], Value(20));
+    ASSERT_VALUE_EQ(results.at(1)["count"], Value(5));
+    ASSERT_VALUE_EQ(results.at(1)["total"], Value(25));
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -489,14 +489,27 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
 DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     tassert(5521502, "calling doGetNext() when '_sampleSize' is set is disallowed", !_sampleSize);
 
-    // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
-    // exhausted.
-    if (_bucketUnpacker.hasNext()) {
-        return _bucketUnpacker.getNext();
-    }
+    // Measurements are unpacked from a bucket in batches, which lets the unpacker decode each
+    // column for many measurements at once and discard those failing its column filters. A batch
+    // may therefore be empty even though the bucket had measurements left. Otherwise, fallback to
+    // unpacking every measurement in all buckets until the child stage is exhausted.
+    while (true) {
+        if (_unpackedBatchPos < _unpackedBatch.size()) {
+            return std::move(_unpackedBatch[_unpackedBatchPos++]);
+        }
+
+        if (_bucketUnpacker.hasNext()) {
+            _unpackedBatch.clear();
+            _unpackedBatchPos = 0;
+            _bucketUnpacker.getNextBatch(kUnpackBatchSize, &_unpackedBatch);
+            continue;
+        }
+
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
 
-    auto nextResult = pSource->getNext();
-    if (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
         _bucketUnpacker.reset(std::move(bucket));
         uassert(5346509,
@@ -504,10 +517,7 @@ DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
                               << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
                               << " contains an empty data region",
                 _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
     }
-
-    return nextResult;
 }
 
 bool DocumentSourceInternalUnpackBucket::pushDownComputedMetaProjection(
@@ -745,6 +755,52 @@ DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
     return nullptr;
 }
 
+std::vector<BucketUnpackerColumnFilter> DocumentSourceInternalUnpackBucket::createColumnFilters(
+    const MatchExpression* matchExpr) const {
+    std::vector<BucketUnpackerColumnFilter> filters;
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < matchExpr->numChildren(); i++) {
+            auto childFilters = createColumnFilters(matchExpr->getChild(i));
+            std::move(childFilters.begin(), childFilters.end(), std::back_inserter(filters));
+        }
+        return filters;
+    }
+
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(matchExpr)) {
+        return filters;
+    }
+
+    auto comparison = static_cast<const ComparisonMatchExpression*>(matchExpr);
+    auto path = comparison->path();
+    const auto& spec = _bucketUnpacker.bucketSpec();
+    if (path.empty() || path.find('.') != std::string::npos ||
+        (spec.metaField && path == *spec.metaField) ||
+        std::find(spec.computedMetaProjFields.begin(), spec.computedMetaProjFields.end(), path) !=
+            spec.computedMetaProjFields.end() ||
+        !BucketUnpackerColumnFilter::isSupportedConstant(comparison->getData())) {
+        return filters;
+    }
+
+    auto op = [&] {
+        switch (comparison->matchType()) {
+            case MatchExpression::EQ:
+                return BucketUnpackerColumnFilter::Op::kEq;
+            case MatchExpression::LT:
+                return BucketUnpackerColumnFilter::Op::kLt;
+            case MatchExpression::LTE:
+                return BucketUnpackerColumnFilter::Op::kLte;
+            case MatchExpression::GT:
+                return BucketUnpackerColumnFilter::Op::kGt;
+            case MatchExpression::GTE:
+                return BucketUnpackerColumnFilter::Op::kGte;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }();
+    filters.push_back({path.toString(), op, Value{comparison->getData()}});
+    return filters;
+}
+
 std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
 DocumentSourceInternalUnpackBucket::splitMatchOnMetaAndRename(
     boost::intrusive_ptr<DocumentSourceMatch> match) {
@@ -1010,6 +1066,17 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // Let the unpacker evaluate simple comparisons of the next $match on decoded column values, to
+    // avoid materializing measurements which cannot match. The $match itself stays in place.
+    if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+        nextMatch && !_triedColumnFilterPushdown && !_sampleSize &&
+        !_bucketUnpacker.bucketSpec().includeBucketIdAndRowIndex) {
+        _triedColumnFilterPushdown = true;
+        for (auto&& filter : createColumnFilters(nextMatch->getMatchExpression())) {
+            _bucketUnpacker.addColumnFilter(std::move(filter));
+        }
+    }
+
     // Attempt to push down a $project on the metaField past $_internalUnpackBucket.
     if (!haveComputedMetaField) {
         if (auto [metaProject, deleteRemainder] = extractProjectForPushDown(std::next(itr)->get());
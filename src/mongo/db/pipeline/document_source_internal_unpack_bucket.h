@@ -45,6 +45,9 @@ public:
     static constexpr StringData kExclude = "exclude"_sd;
     static constexpr StringData kBucketMaxSpanSeconds = "bucketMaxSpanSeconds"_sd;
 
+    // The maximum number of measurements unpacked from a bucket at once.
+    static constexpr size_t kUnpackBatchSize = 128;
+
     static boost::intrusive_ptr<DocumentSource> createFromBsonInternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
     static boost::intrusive_ptr<DocumentSource> createFromBsonExternal(
@@ -160,6 +163,16 @@ public:
     std::unique_ptr<MatchExpression> createPredicatesOnBucketLevelField(
         const MatchExpression* matchExpr) const;
 
+    /**
+     * Returns the comparisons of a top-level conjunction 'matchExpr' that the BucketUnpacker can
+     * evaluate on decoded column values. These are comparisons of a top-level measurement field
+     * against a numeric, date or ObjectId constant, for example {a: {$gte: 5}} in
+     * {$and: [{a: {$gte: 5}}, {b: {$regex: "x"}}]}. Predicates on the metaField, on computed meta
+     * projections, or on dotted paths are not returned.
+     */
+    std::vector<BucketUnpackerColumnFilter> createColumnFilters(
+        const MatchExpression* matchExpr) const;
+
     /**
      * Sets the sample size to 'n' and the maximum number of measurements in a bucket to be
      * 'bucketMaxCount'. Calling this method implicitly changes the behavior from having the stage
@@ -205,12 +218,17 @@ private:
     BucketUnpacker _bucketUnpacker;
     int _bucketMaxSpanSeconds;
 
+    // Measurements unpacked from the current bucket which have not been returned yet.
+    std::vector<Document> _unpackedBatch;
+    size_t _unpackedBatchPos = 0;
+
     int _bucketMaxCount = 0;
     boost::optional<long long> _sampleSize;
 
     // Used to avoid infinite loops after we step backwards to optimize a $match on bucket level
     // fields, otherwise we may do an infinite number of $match pushdowns.
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
+    bool _triedColumnFilterPushdown = false;
     bool _optimizedEndOfPipeline = false;
     bool _triedInternalizeProject = false;
 };
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketColumnFilterTest = AggregationContextFixture;
+
+std::vector<BucketUnpackerColumnFilter> createColumnFilters(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& match) {
+    auto pipeline = Pipeline::parse(
+        makeVector(fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: "
+                            "'myMeta', bucketMaxSpanSeconds: 3600}}"),
+                   BSON("$match" << match)),
+        expCtx);
+    auto& container = pipeline->getSources();
+    auto original = dynamic_cast<DocumentSourceMatch*>(container.back().get());
+    return dynamic_cast<DocumentSourceInternalUnpackBucket*>(container.front().get())
+        ->createColumnFilters(original->getMatchExpression());
+}
+
+TEST_F(InternalUnpackBucketColumnFilterTest, CreatesFiltersForComparisonsOnScalarConstants) {
+    auto filters = createColumnFilters(
+        getExpCtx(),
+        fromjson("{$and: [{a: {$gt: 1}}, {b: {$lte: 2.5}}, {time: {$gte: {$date: 1000}}}, "
+                 "{_id: {$eq: {$oid: '000000000000000000000000'}}}]}"));
+
+    ASSERT_EQ(filters.size(), 4U);
+    ASSERT_EQ(filters[0].fieldName, "a");
+    ASSERT(filters[0].op == BucketUnpackerColumnFilter::Op::kGt);
+    ASSERT_EQ(filters[1].fieldName, "b");
+    ASSERT(filters[1].op == BucketUnpackerColumnFilter::Op::kLte);
+    ASSERT_EQ(filters[2].fieldName, "time");
+    ASSERT(filters[2].op == BucketUnpackerColumnFilter::Op::kGte);
+    ASSERT_EQ(filters[2].constant.getType(), Date);
+    ASSERT_EQ(filters[3].fieldName, "_id");
+    ASSERT(filters[3].op == BucketUnpackerColumnFilter::Op::kEq);
+}
+
+TEST_F(InternalUnpackBucketColumnFilterTest, IgnoresUnsupportedPredicates) {
+    // Non-scalar or non-numeric constants, NaN, dotted paths, the metaField and disjunctions cannot
+    // be evaluated on decoded column values.
+    auto filters = createColumnFilters(
+        getExpCtx(),
+        fromjson("{$and: [{a: {$gt: 'x'}}, {b: null}, {c: {$lt: NaN}}, {'d.e': {$gt: 1}}, "
+                 "{myMeta: {$gt: 1}}, {$or: [{f: 1}, {g: 1}]}, {h: {$in: [1, 2]}}, "
+                 "{i: {$lt: {$numberDecimal: '1'}}}]}"));
+    ASSERT_EQ(filters.size(), 0U);
+}
+
+TEST_F(InternalUnpackBucketColumnFilterTest, OptimizeAddsFiltersAndKeepsMatch) {
+    auto pipeline = Pipeline::parse(
+        makeVector(fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                            "bucketMaxSpanSeconds: 3600}}"),
+                   fromjson("{$match: {a: {$gt: 1}}}")),
+        getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto& container = pipeline->getSources();
+    auto unpack = dynamic_cast<DocumentSourceInternalUnpackBucket*>(
+        std::prev(std::prev(container.end()))->get());
+    ASSERT(unpack);
+    ASSERT_EQ(unpack->bucketUnpacker().columnFilters().size(), 1U);
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(container.back().get()));
+}
+
+}  // namespace
+}  // namespace mongo
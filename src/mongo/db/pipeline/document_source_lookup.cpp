@@ -368,6 +368,18 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     if (hasLocalFieldForeignFieldJoin()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+
+        // Input documents frequently join on values that were already looked up, in which case
+        // the foreign query would be identical to an earlier one and we can reuse its results.
+        if (_joinCache) {
+            if (auto cachedDocs = (*_joinCache)[Value(matchStage)]) {
+                std::vector<Value> cachedResults(cachedDocs->begin(), cachedDocs->end());
+                MutableDocument output(std::move(inputDoc));
+                output.setNestedField(_as, Value(std::move(cachedResults)));
+                return output.freeze();
+            }
+        }
+
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
@@ -393,6 +405,13 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         throw;
     }
 
+    // Only a bare local/foreignField join is a pure function of its $match. Reading through a view
+    // or running a user-supplied pipeline may involve stages such as $sample.
+    const auto joinCacheMaxBytes = internalDocumentSourceLookupJoinCacheSizeBytes.load();
+    const bool shouldCacheJoin = hasLocalFieldForeignFieldJoin() && !hasPipeline() &&
+        _resolvedPipeline.size() == 1 && joinCacheMaxBytes > 0;
+    std::vector<Document> docsToCache;
+
     std::vector<Value> results;
     long long objsize = 0;
     const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
@@ -407,10 +426,23 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
 
                 !hasOverflowed && objsize <= maxBytes);
         objsize = safeSum;
+        if (shouldCacheJoin) {
+            docsToCache.push_back(*result);
+        }
         results.emplace_back(std::move(*result));
     }
 
     recordPlanSummaryStats(*pipeline);
+
+    if (shouldCacheJoin) {
+        if (!_joinCache) {
+            _joinCache.emplace(ValueComparator());
+        }
+        _joinCache->set(Value(_resolvedPipeline[*_fieldMatchPipelineIdx]),
+                        std::move(docsToCache));
+        _joinCache->evictDownTo(static_cast<size_t>(joinCacheMaxBytes));
+    }
+
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
@@ -372,6 +372,11 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // For a plain local/foreignField join, maps the $match issued for an input document to the
+    // foreign documents it produced, so that input documents with the same join values share a
+    // single foreign query. Bounded by 'internalDocumentSourceLookupJoinCacheSizeBytes'.
+    boost::optional<LookupSetCache> _joinCache;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
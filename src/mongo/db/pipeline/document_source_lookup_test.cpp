@@ -50,6 +50,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -834,12 +835,18 @@ public:
 
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        ++_numPipelinesAttached;
         return pipeline;
     }
 
+    int numPipelinesAttached() const {
+        return _numPipelinesAttached;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numPipelinesAttached = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -893,6 +900,81 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldReuseForeignResultsForRepeatedJoinValues) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"foreignId", 0}},
+                                                              Document{{"foreignId", 0}},
+                                                              Document{{"foreignId", 1}},
+                                                              Document{{"foreignId", 0}}},
+                                                             expCtx);
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}},
+                                                             Document{{"_id", 1}}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "_id"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    lookup->setSource(mockLocalSource.get());
+
+    for (int expectedId : {0, 0, 1, 0}) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                           (Document{{"foreignId", expectedId},
+                                     {"foreignDocs", {Document{{"_id", expectedId}}}}}));
+    }
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // Only the first input document for each join value issued a foreign query.
+    ASSERT_EQ(mongoInterface->numPipelinesAttached(), 2);
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotReuseForeignResultsWhenJoinCacheIsDisabled) {
+    RAIIServerParameterControllerForTest controller{
+        "internalDocumentSourceLookupJoinCacheSizeBytes", 0};
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"foreignId", 0}}, Document{{"foreignId", 0}}}, expCtx);
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "_id"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    lookup->setSource(mockLocalSource.get());
+
+    ASSERT_TRUE(lookup->getNext().isAdvanced());
+    ASSERT_TRUE(lookup->getNext().isAdvanced());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_EQ(mongoInterface->numPipelinesAttached(), 2);
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -503,5 +503,61 @@ BENCHMARK(BM_SetDifference);
 BENCHMARK(BM_SetEquals);
 BENCHMARK(BM_SetUnion);
 
+/**
+ * Tests performance of 'evaluate()' of expressions producing short strings, such as the country
+ * codes and SKUs commonly used as group keys. Value stores strings of up to 13 bytes inline, so the
+ * 13-byte cases avoid the allocation and refcounting which the 14-byte cases pay for.
+ *
+ * length - the length of the string read or produced by the expression.
+ * state - benchmarking state.
+ */
+void testShortStringFieldPathExpression(size_t length, benchmark::State& state) {
+    std::vector<Document> documents;
+    for (int i = 0; i < 100; ++i) {
+        const auto c = static_cast<char>('a' + i % 26);
+        documents.push_back(Document{{"sku"_sd, std::string(length, c)}});
+    }
+    // $ifNull returns a copy of the field's Value.
+    benchmarkExpression(BSON("$ifNull" << BSON_ARRAY("$sku"
+                                                     << "none")),
+                        state,
+                        documents);
+}
+
+void testShortStringConcatExpression(size_t length, benchmark::State& state) {
+    const size_t prefixLength = length / 2;
+    std::vector<Document> documents;
+    for (int i = 0; i < 100; ++i) {
+        const auto c = static_cast<char>('a' + i % 26);
+        documents.push_back(Document{{"prefix"_sd, std::string(prefixLength, c)},
+                                     {"suffix"_sd, std::string(length - prefixLength, c)}});
+    }
+    benchmarkExpression(BSON("$concat" << BSON_ARRAY("$prefix"
+                                                     << "$suffix")),
+                        state,
+                        documents);
+}
+
+void BM_FieldPathEvaluateString13Bytes(benchmark::State& state) {
+    testShortStringFieldPathExpression(13, state);
+}
+
+void BM_FieldPathEvaluateString14Bytes(benchmark::State& state) {
+    testShortStringFieldPathExpression(14, state);
+}
+
+void BM_ConcatEvaluateString13Bytes(benchmark::State& state) {
+    testShortStringConcatExpression(13, state);
+}
+
+void BM_ConcatEvaluateString14Bytes(benchmark::State& state) {
+    testShortStringConcatExpression(14, state);
+}
+
+BENCHMARK(BM_FieldPathEvaluateString13Bytes);
+BENCHMARK(BM_FieldPathEvaluateString14Bytes);
+BENCHMARK(BM_ConcatEvaluateString13Bytes);
+BENCHMARK(BM_ConcatEvaluateString14Bytes);
+
 }  // namespace
 }  // namespace mongo
@@ -92,6 +92,16 @@ FieldPath::FieldPath(std::string inputPath)
     for (size_t i = 0; i < pathLength; ++i) {
         uassertValidFieldName(getFieldName(i));
     }
+
+    _computeFieldHashes();
+}
+
+void FieldPath::_computeFieldHashes() {
+    const auto pathLength = getPathLength();
+    _fieldHash.reserve(pathLength);
+    for (size_t i = 0; i < pathLength; ++i) {
+        _fieldHash.push_back(FieldNameHasher()(getFieldName(i)));
+    }
 }
 
 void FieldPath::uassertValidFieldName(StringData fieldName) {
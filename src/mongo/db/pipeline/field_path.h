@@ -30,6 +30,7 @@
 #pragma once
 
 #include <string>
+#include <third_party/murmurhash3/MurmurHash3.h>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -37,6 +38,40 @@
 
 namespace mongo {
 
+/**
+ * The hash function used for looking up field names in a Document. It lives here so that path
+ * components can be hashed once, when a FieldPath is built, rather than on every lookup.
+ */
+struct FieldNameHasher {
+    unsigned operator()(StringData name) const {
+        unsigned out;
+        MurmurHash3_x86_32(name.rawData(), name.size(), 0, &out);
+        return out;
+    }
+};
+
+/**
+ * A field name paired with its precomputed FieldNameHasher hash. Does not own the name.
+ */
+class HashedFieldName {
+public:
+    HashedFieldName(StringData key, unsigned hash) : _key(key), _hash(hash) {
+        dassert(hash == FieldNameHasher()(key));
+    }
+
+    StringData key() const {
+        return _key;
+    }
+
+    unsigned hash() const {
+        return _hash;
+    }
+
+private:
+    StringData _key;
+    unsigned _hash;
+};
+
 /**
  * Utility class which represents a field path with nested paths separated by dots.
  */
@@ -109,6 +144,14 @@ public:
         return StringData(&_fieldPath[begin], end - begin);
     }
 
+    /**
+     * Like getFieldName(), but also returns the precomputed hash of the field name.
+     */
+    HashedFieldName getFieldNameHashed(size_t i) const {
+        dassert(i < getPathLength());
+        return HashedFieldName{getFieldName(i), _fieldHash[i]};
+    }
+
     /**
      * Returns the full path, not including the prefix 'FieldPath::prefix'.
      */
@@ -142,7 +185,11 @@ public:
 
 private:
     FieldPath(std::string string, std::vector<size_t> dots)
-        : _fieldPath(std::move(string)), _fieldPathDotPosition(std::move(dots)) {}
+        : _fieldPath(std::move(string)), _fieldPathDotPosition(std::move(dots)) {
+        _computeFieldHashes();
+    }
+
+    void _computeFieldHashes();
 
     static const char prefix = '$';
 
@@ -153,6 +200,9 @@ private:
     // string::npos (which evaluates to -1) and the last contains _fieldPath.size() to facilitate
     // lookup.
     std::vector<size_t> _fieldPathDotPosition;
+
+    // Contains the FieldNameHasher hash of each path component.
+    std::vector<unsigned> _fieldHash;
 };
 
 inline bool operator<(const FieldPath& lhs, const FieldPath& rhs) {
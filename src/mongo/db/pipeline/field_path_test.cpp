@@ -226,5 +226,19 @@ TEST(FieldPathTest, Concat) {
     checkConcatWorks("$db", "$id");
     checkConcatWorks("$db.$id", "$id.$db");
 }
+
+TEST(FieldPathTest, GetFieldNameHashedMatchesFieldNameHasher) {
+    auto check = [](const FieldPath& path) {
+        for (size_t i = 0; i < path.getPathLength(); ++i) {
+            auto hashed = path.getFieldNameHashed(i);
+            ASSERT_EQ(hashed.key(), path.getFieldName(i));
+            ASSERT_EQ(hashed.hash(), FieldNameHasher()(path.getFieldName(i)));
+        }
+    };
+    check(FieldPath("foo"));
+    check(FieldPath("foo.bar.baz"));
+    check(FieldPath("foo.bar").concat(FieldPath("baz.qux")));
+    check(FieldPath("foo.bar.baz").tail());
+}
 }  // namespace
 }  // namespace mongo
@@ -127,6 +127,27 @@ public:
         _memoryUsage += cacheEntrySizeIncreaseBy;
     }
 
+    /**
+     * Replaces the documents cached under "key" with "docs", which may be empty, and makes "key"
+     * the most recently used item. Unlike insert(), this is meant for callers that cache the full
+     * result set of a key at once.
+     */
+    void set(Value key, std::vector<Document> docs) {
+        auto cacheEntrySize = key.getApproximateSize();
+        for (auto&& doc : docs) {
+            cacheEntrySize += doc.getApproximateSize();
+        }
+
+        auto& byKey = boost::multi_index::get<1>(_container);
+        if (auto it = byKey.find(key); it != byKey.end()) {
+            _memoryUsage -= it->approxCacheEntrySize;
+            byKey.erase(it);
+        }
+
+        _container.push_front({std::move(key), std::move(docs), cacheEntrySize});
+        _memoryUsage += cacheEntrySize;
+    }
+
     /**
      * Evict the least-recently-used item.
      */
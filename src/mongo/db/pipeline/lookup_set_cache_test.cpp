@@ -120,6 +120,31 @@ TEST(LookupSetCacheTest, InsertDoesPutKeyInMiddle) {
     ASSERT_TRUE(cache[Value(1)]);
 }
 
+TEST(LookupSetCacheTest, SetDoesReplaceDocsAndPutKeyAtFront) {
+    LookupSetCache cache(defaultComparator);
+
+    cache.insert(Value(0), intToDoc(0));
+    cache.insert(Value(1), intToDoc(1));
+    cache.set(Value(0), {intToDoc(2), intToDoc(3)});
+    cache.set(Value(2), {});
+    // Cache ordering is now {2: [], 0: [2, 3], 1: [1]}.
+
+    ASSERT_EQ(cache.size(), 3U);
+    ASSERT_EQ(cache.getMemoryUsage(),
+              Value(0).getApproximateSize() + intToDoc(2).getApproximateSize() +
+                  intToDoc(3).getApproximateSize() + Value(1).getApproximateSize() +
+                  intToDoc(1).getApproximateSize() + Value(2).getApproximateSize());
+
+    cache.evictOne();
+    ASSERT_FALSE(cache[Value(1)]);
+
+    ASSERT_TRUE(cache[Value(2)]);
+    ASSERT_TRUE(cache[Value(2)]->empty());
+    ASSERT_EQ(cache[Value(0)]->size(), 2U);
+    ASSERT_FALSE(vectorContains(cache[Value(0)], intToDoc(0)));
+    ASSERT_TRUE(vectorContains(cache[Value(0)], intToDoc(3)));
+}
+
 TEST(LookupSetCacheTest, EvictDoesRespectMemoryUsage) {
     LookupSetCache cache(defaultComparator);
 
@@ -147,7 +147,7 @@ public:
         tassert(5578602,
                 str::stream() << "Underflow on memory tracking, attempting to add " << diff
                               << " but only " << _memoryUsageBytes << " available",
-                diff >= 0 || (int)_memoryUsageBytes >= -1 * diff);
+                diff >= 0 || _memoryUsageBytes >= -1 * diff);
         set(_memoryUsageBytes + diff);
     }
 
@@ -99,6 +99,16 @@ TEST_F(MemoryUsageTrackerTest, UpdateUsageUpdatesGlobal) {
     ASSERT_EQ(_tracker.maxMemoryBytes(), 150LL);
 }
 
+TEST_F(MemoryUsageTrackerTest, UpdateHandlesUsageAboveFourGigabytes) {
+    constexpr long long kGB = 1024LL * 1024 * 1024;
+    _tracker.set(5 * kGB);
+
+    // The underflow check must compare the full 64-bit total, not a truncated one.
+    _tracker.update(-2 * kGB);
+    ASSERT_EQ(_tracker.currentMemoryBytes(), 3 * kGB);
+    ASSERT_EQ(_tracker.maxMemoryBytes(), 5 * kGB);
+}
+
 DEATH_TEST_F(MemoryUsageTrackerTest,
              UpdateGlobalToNegativeIsDisallowed,
              "Underflow on memory tracking") {
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/query_test_service_context.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Runs 'state.range(0)' generated documents through the pipeline described by 'stages'. Parsing
+ * and optimizing the pipeline is excluded from the measured time, so the results reflect the cost
+ * of pulling documents through the stages.
+ */
+void benchmarkPipeline(benchmark::State& state, const std::vector<const char*>& stages) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss("test.bm");
+    auto expCtx = make_intrusive<ExpressionContextForTest>(opContext.get(), nss);
+
+    std::vector<BSONObj> rawPipeline;
+    for (auto stage : stages) {
+        rawPipeline.push_back(fromjson(stage));
+    }
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < state.range(0); ++i) {
+        inputs.emplace_back(Document{{"_id", i}, {"a", i % 10}, {"b", i}, {"s", "abcdefgh"_sd}});
+    }
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto pipeline = Pipeline::parse(rawPipeline, expCtx);
+        pipeline->addInitialSource(DocumentSourceMock::createForTest(inputs, expCtx));
+        pipeline->optimizePipeline();
+        state.ResumeTiming();
+
+        while (auto next = pipeline->getNext()) {
+            benchmark::DoNotOptimize(*next);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MatchFilter(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$match: {a: {$in: [1, 3, 5]}, b: {$gte: 10}}}"});
+}
+
+void BM_ProjectInclusion(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$project: {a: 1, s: 1}}"});
+}
+
+void BM_ProjectComputed(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$project: {sum: {$add: ['$a', '$b']}, s: {$toUpper: '$s'}}}"});
+}
+
+void BM_GroupSum(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$group: {_id: '$a', total: {$sum: '$b'}, n: {$sum: 1}}}"});
+}
+
+void BM_SortDescending(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$sort: {b: -1}}"});
+}
+
+void BM_MatchSortLimit(benchmark::State& state) {
+    benchmarkPipeline(state, {"{$match: {a: {$ne: 0}}}", "{$sort: {b: -1}}", "{$limit: 10}"});
+}
+
+BENCHMARK(BM_MatchFilter)->Arg(1000);
+BENCHMARK(BM_ProjectInclusion)->Arg(1000);
+BENCHMARK(BM_ProjectComputed)->Arg(1000);
+BENCHMARK(BM_GroupSum)->Arg(1000);
+BENCHMARK(BM_SortDescending)->Arg(1000);
+BENCHMARK(BM_MatchSortLimit)->Arg(1000);
+
+}  // namespace
+}  // namespace mongo
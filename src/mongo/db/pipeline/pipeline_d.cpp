@@ -618,6 +618,21 @@ getSortAndGroupStagesFromPipeline(const Pipeline::SourceContainer& sources) {
     return std::make_pair(sortStage, groupStage);
 }
 
+/**
+ * Returns 'sortObj' with every direction inverted, or an empty object if some component of the
+ * sort, such as a $meta sort, has no reverse.
+ */
+BSONObj reverseSortPatternForDistinctScan(const BSONObj& sortObj) {
+    BSONObjBuilder reversed;
+    for (auto&& elem : sortObj) {
+        if (!elem.isNumber()) {
+            return BSONObj();
+        }
+        reversed.append(elem.fieldName(), elem.numberInt() > 0 ? -1 : 1);
+    }
+    return reversed.obj();
+}
+
 boost::optional<long long> extractSkipForPushdown(Pipeline* pipeline) {
     // If the disablePipelineOptimization failpoint is enabled, then do not attempt the skip
     // pushdown optimization.
@@ -738,6 +753,13 @@ PipelineD::buildInnerQueryExecutorGeneric(const CollectionPtr& collection,
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
+
+        // Without a $sort there is no order in which a document would be the last of its group.
+        if (rewrittenGroupStage && !sortStage &&
+            rewrittenGroupStage->expectedInput() ==
+                GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument) {
+            rewrittenGroupStage = nullptr;
+        }
     }
 
     // If there is a $limit or $skip stage (or multiple of them) that could be pushed down into the
@@ -946,6 +968,18 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         plannerOpts |= QueryPlannerParams::RETURN_OWNED_DATA;
     }
 
+    // The last document of each group in 'sortObj' order is the first one in the reverse order, so
+    // a $group made of $last accumulators scans for the first document under the reversed sort.
+    BSONObj groupSortObj = sortObj;
+    if (rewrittenGroupStage &&
+        rewrittenGroupStage->expectedInput() ==
+            GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument) {
+        groupSortObj = reverseSortPatternForDistinctScan(sortObj);
+        if (groupSortObj.isEmpty()) {
+            rewrittenGroupStage = nullptr;
+        }
+    }
+
     if (rewrittenGroupStage) {
         // See if the query system can handle the $group and $sort stage using a DISTINCT_SCAN
         // (SERVER-9507).
@@ -955,7 +989,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       queryObj,
                                                       projObj,
                                                       deps.metadataDeps(),
-                                                      sortObj,
+                                                      groupSortObj,
                                                       SkipThenLimit{boost::none, boost::none},
                                                       rewrittenGroupStage->groupId(),
                                                       aggRequest,
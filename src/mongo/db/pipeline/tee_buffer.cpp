@@ -31,8 +31,6 @@
 
 #include "mongo/db/pipeline/tee_buffer.h"
 
-#include <algorithm>
-
 #include "mongo/db/exec/document_value/document.h"
 
 namespace mongo {
@@ -50,12 +48,7 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
-    size_t nConsumersStillProcessingThisBatch =
-        std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-            return info.nLeftToReturn > 0;
-        });
-
-    if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
+    if (_buffer.empty() || _nConsumersStillProcessingBatch == 0) {
         loadNextBatch();
     }
 
@@ -71,7 +64,9 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     }
 
     const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
-    --_consumers[consumerId].nLeftToReturn;
+    if (--_consumers[consumerId].nLeftToReturn == 0) {
+        --_nConsumersStillProcessingBatch;
+    }
 
     return _buffer[bufferIndex];
 }
@@ -97,9 +92,13 @@ void TeeBuffer::loadNextBatch() {
     invariant(!input.isPaused());  // NOLINT(bugprone-use-after-move)
 
     // Populate the pending returns.
+    _nConsumersStillProcessingBatch = 0;
     for (size_t consumerId = 0; consumerId < _consumers.size(); ++consumerId) {
         if (_consumers[consumerId].stillInUse) {
             _consumers[consumerId].nLeftToReturn = _buffer.size();
+            if (!_buffer.empty()) {
+                ++_nConsumersStillProcessingBatch;
+            }
         }
     }
 }
@@ -65,6 +65,9 @@ public:
      */
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
+        if (_consumers[consumerId].nLeftToReturn > 0) {
+            --_nConsumersStillProcessingBatch;
+        }
         _consumers[consumerId].nLeftToReturn = 0;
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
@@ -103,5 +106,9 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // The number of consumers whose 'nLeftToReturn' is positive, maintained incrementally so that
+    // getNext() does not have to scan all consumers on every call.
+    size_t _nConsumersStillProcessingBatch = 0;
 };
 }  // namespace mongo
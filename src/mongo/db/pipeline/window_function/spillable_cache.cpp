@@ -85,12 +85,16 @@ void SpillableCache::freeUpTo(int id) {
         }
         ++_nextFreedIndex;
     }
+    while (!_recentDiskReads.empty() && _recentDiskReads.front().first < _nextFreedIndex) {
+        _recentDiskReads.pop_front();
+    }
 }
 void SpillableCache::clear() {
     if (_diskCache) {
         _expCtx->mongoProcessInterface->truncateRecordStore(_expCtx, _diskCache->rs());
     }
     _memCache.clear();
+    _recentDiskReads.clear();
     _diskWrittenIndex = 0;
     _nextIndex = 0;
     _nextFreedIndex = 0;
@@ -161,8 +165,19 @@ Document SpillableCache::readDocumentFromDiskById(int desired) {
             str::stream() << "Attempted to read id " << desired
                           << "from disk in SpillableCache before writing",
             _diskCache && desired < _diskWrittenIndex);
-    return _expCtx->mongoProcessInterface->readRecordFromRecordStore(
+    for (const auto& [id, doc] : _recentDiskReads) {
+        if (id == desired) {
+            return doc;
+        }
+    }
+
+    auto doc = _expCtx->mongoProcessInterface->readRecordFromRecordStore(
         _expCtx, _diskCache->rs(), RecordId(desired + 1));
+    if (_recentDiskReads.size() == kMaxRecentDiskReads) {
+        _recentDiskReads.pop_front();
+    }
+    _recentDiskReads.emplace_back(desired, doc);
+    return doc;
 }
 Document SpillableCache::readDocumentFromMemCacheById(int desired) {
     // If we have only freed documents from disk, the index into '_memCache' is off by the number of
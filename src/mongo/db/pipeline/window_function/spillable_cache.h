@@ -90,6 +90,7 @@ public:
             _diskCache = nullptr;
         }
         _memCache.clear();
+        _recentDiskReads.clear();
     }
 
     size_t getApproximateSize() {
@@ -151,6 +152,12 @@ private:
     // Be able to report that disk was used after the cache has been finalized.
     bool _usedDisk = false;
 
+    // The most recently read documents from disk, keyed by id, oldest first. Window bounds that
+    // slide over spilled documents re-read the documents at the edges of the window on every
+    // advance, and each read from the record store takes a collection lock and a point lookup.
+    std::deque<std::pair<int, Document>> _recentDiskReads;
+    static constexpr size_t kMaxRecentDiskReads = 4;
+
     MemoryUsageTracker::PerFunctionMemoryTracker _memTracker;
 };
 
@@ -70,6 +70,7 @@ public:
     Document readRecordFromRecordStore(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                        RecordStore* rs,
                                        RecordId rID) const override {
+        ++numRecordsRead;
         RecordData possibleRecord;
         AutoGetCollection autoColl(expCtx->opCtx, expCtx->ns, MODE_IX);
         auto foundDoc = rs->findRecord(expCtx->opCtx, RecordId(rID), &possibleRecord);
@@ -100,12 +101,15 @@ public:
         rs->finalizeTemporaryTable(expCtx->opCtx,
                                    TemporaryRecordStore::FinalizationAction::kDelete);
     }
+
+    mutable int numRecordsRead = 0;
 };
 
 class SpillableCacheTest : public AggregationMongoDContextFixture {
 public:
     SpillableCacheTest() : AggregationMongoDContextFixture() {
-        getExpCtx()->mongoProcessInterface = std::make_shared<MongoProcessInterfaceForTest>();
+        _processInterface = std::make_shared<MongoProcessInterfaceForTest>();
+        getExpCtx()->mongoProcessInterface = _processInterface;
         _expCtx = getExpCtx();
     }
 
@@ -129,6 +133,7 @@ public:
     }
 
     boost::intrusive_ptr<ExpressionContext> _expCtx;
+    std::shared_ptr<MongoProcessInterfaceForTest> _processInterface;
     std::unique_ptr<MemoryUsageTracker> _tracker;
 
     // Docs are ~200 each.
@@ -167,6 +172,30 @@ TEST_F(SpillableCacheTest, CanReturnDocumentsFromCacheAndDisk) {
     cache->finalize();
 }
 
+TEST_F(SpillableCacheTest, RereadingRecentDocumentsFromDiskDoesNotHitTheRecordStore) {
+    _expCtx->allowDiskUse = true;
+    auto cache = createSpillableCache(1);
+    buildAndLoadDocumentSet(6, cache.get());
+
+    // Alternate between two positions the way the edges of a sliding window do.
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_DOCUMENT_EQ(cache->getDocumentById(i), _docSet[i]);
+        ASSERT_DOCUMENT_EQ(cache->getDocumentById(i + 1), _docSet[i + 1]);
+        ASSERT_DOCUMENT_EQ(cache->getDocumentById(i), _docSet[i]);
+    }
+    ASSERT_EQ(_processInterface->numRecordsRead, 6);
+
+    // Freed documents are dropped from the recent reads, and clear() forgets all of them since
+    // ids are reused afterwards.
+    cache->freeUpTo(2);
+    cache->clear();
+    buildAndLoadDocumentSet(2, cache.get());
+    ASSERT_DOCUMENT_EQ(cache->getDocumentById(0), _docSet[6]);
+    ASSERT_EQ(_processInterface->numRecordsRead, 7);
+    cache->finalize();
+    _expCtx->allowDiskUse = false;
+}
+
 DEATH_TEST_F(SpillableCacheTest, RemovesDocumentsWhenExpired, "Requested expired document") {
     _expCtx->allowDiskUse = false;
     auto cache = createSpillableCache(1000);
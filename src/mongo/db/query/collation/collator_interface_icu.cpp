@@ -31,10 +31,10 @@
 
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
+#include <array>
 #include <memory>
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/util/assert_util.h"
 
@@ -77,25 +77,34 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const auto source = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Most sort keys fit in a small stack buffer, which saves building an icu::CollationKey and
+    // growing its heap buffer. getSortKey() returns the full key length even when the key does not
+    // fit, in which case it is generated a second time directly into the returned string.
+    std::array<uint8_t, 128> stackBuffer;
+    int32_t keyLength = _collator->getSortKey(source, stackBuffer.data(), stackBuffer.size());
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
+
+    std::string key;
+    if (keyLength <= static_cast<int32_t>(stackBuffer.size())) {
+        key.assign(reinterpret_cast<const char*>(stackBuffer.data()), keyLength);
+    } else {
+        key.resize(keyLength);
+        const int32_t fullKeyLength =
+            _collator->getSortKey(source, reinterpret_cast<uint8_t*>(&key[0]), keyLength);
+        invariant(fullKeyLength == keyLength);
+    }
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
-    invariant(keyBuffer[keyLength - 1u] == '\0');
-    const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
-    return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    invariant(key.back() == '\0');
+    key.pop_back();
+    return makeComparisonKey(std::move(key));
 }
 
 }  // namespace mongo
@@ -566,6 +566,14 @@ TEST(CollatorInterfaceICUTest, DifferentEmbeddedInvalidSequencesAndDifferentFina
     assertLessThanEnUS(valid2, invalid2);
 }
 
+TEST(CollatorInterfaceICUTest, LongStringsCompareCorrectlyUsingComparisonKeys) {
+    // These produce sort keys too long for the fixed buffer used by getComparisonKey().
+    const std::string longString(300, 'a');
+    assertLessThanEnUS(longString, longString + "b");
+    assertLessThanEnUS(longString + "a", std::string(299, 'a') + "b");
+    assertEqualEnUS(longString, longString);
+}
+
 TEST(CollatorInterfaceICUTest, ComparisonKeysForEnUsCollatorCorrect) {
     Collation collationSpec;
     collationSpec.setLocale("en_US");
@@ -82,6 +82,32 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+std::size_t FindCommon::getBytesToReserveForFirstBatch(const FindCommandRequest& findCommand,
+                                                       long long numResults,
+                                                       int bytesBuffered) {
+    if (numResults != kNumResultsBeforeReservingFirstBatch || bytesBuffered <= 0) {
+        return 0;
+    }
+
+    long long expectedDocs =
+        findCommand.getBatchSize().value_or(query_request_helper::kDefaultBatchSize);
+    if (auto limit = findCommand.getLimit()) {
+        expectedDocs = std::min<long long>(expectedDocs, *limit);
+    }
+
+    const long long remainingDocs = expectedDocs - numResults;
+    const long long remainingBytes = kMaxBytesToReturnToClientAtOnce - bytesBuffered;
+    if (remainingDocs <= 0 || remainingBytes <= 0) {
+        return 0;
+    }
+
+    const long long averageDocSize = std::max<long long>(bytesBuffered / numResults, 1);
+    if (remainingDocs >= remainingBytes / averageDocSize) {
+        return remainingBytes;
+    }
+    return remainingDocs * averageDocSize;
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
@@ -96,6 +96,10 @@ public:
     // The initial size of the query response buffer.
     static const int kInitReplyBufferSize = 32768;
 
+    // The number of results the first batch of a find buffers before sizing its reply for the rest
+    // of the batch.
+    static const int kNumResultsBeforeReservingFirstBatch = 16;
+
     /**
      * Returns true if the batchSize for the initial find has been satisfied.
      *
@@ -120,6 +124,18 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Predicts how many more bytes the first batch of 'findCommand' will need, given the number of
+     * results ('numResults') and bytes ('bytesBuffered') it has buffered so far. Returns zero
+     * unless exactly 'kNumResultsBeforeReservingFirstBatch' results have been buffered, so that the
+     * reply is only sized up once and only from results that were actually seen. The prediction
+     * assumes the remaining results are of the average size seen so far, and is capped by the
+     * limit, the batchSize and the maximum number of bytes returned to a client at once.
+     */
+    static std::size_t getBytesToReserveForFirstBatch(const FindCommandRequest& findCommand,
+                                                      long long numResults,
+                                                      int bytesBuffered);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
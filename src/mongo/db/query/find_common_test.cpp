@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/find_command_gen.h"
+#include "mongo/db/query/query_request_helper.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString testns("testdb.testcoll");
+const int kThreshold = FindCommon::kNumResultsBeforeReservingFirstBatch;
+
+// The bytes buffered by 'kThreshold' results of 100 bytes each.
+const int kBytesBuffered = kThreshold * 100;
+
+TEST(FindCommonTest, NoReservationForFewResults) {
+    FindCommandRequest findCommand(testns);
+
+    // A single large result does not make the reply grow for results that may never come.
+    ASSERT_EQ(0U, FindCommon::getBytesToReserveForFirstBatch(findCommand, 1, 1024 * 1024));
+    ASSERT_EQ(0U,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold - 1, 1024 * 1024));
+}
+
+TEST(FindCommonTest, ReservesOnlyOnce) {
+    FindCommandRequest findCommand(testns);
+    ASSERT_NE(0U,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, kBytesBuffered));
+    ASSERT_EQ(0U,
+              FindCommon::getBytesToReserveForFirstBatch(
+                  findCommand, kThreshold + 1, (kThreshold + 1) * 100));
+}
+
+TEST(FindCommonTest, ReservesForRestOfDefaultBatch) {
+    FindCommandRequest findCommand(testns);
+    const auto expectedBytes =
+        static_cast<std::size_t>((query_request_helper::kDefaultBatchSize - kThreshold) * 100);
+    ASSERT_EQ(expectedBytes,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, kBytesBuffered));
+}
+
+TEST(FindCommonTest, ReservationIsBoundedByLimit) {
+    FindCommandRequest findCommand(testns);
+    findCommand.setLimit(kThreshold + 4);
+    ASSERT_EQ(400U,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, kBytesBuffered));
+
+    findCommand.setLimit(kThreshold);
+    ASSERT_EQ(0U,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, kBytesBuffered));
+}
+
+TEST(FindCommonTest, ReservationIsBoundedByBatchSize) {
+    FindCommandRequest findCommand(testns);
+    findCommand.setBatchSize(kThreshold + 2);
+    ASSERT_EQ(200U,
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, kBytesBuffered));
+}
+
+TEST(FindCommonTest, ReservationIsBoundedByMaxBytesToReturn) {
+    FindCommandRequest findCommand(testns);
+    findCommand.setBatchSize(1000000);
+    const int bytesBuffered = FindCommon::kMaxBytesToReturnToClientAtOnce / 2;
+    ASSERT_EQ(static_cast<std::size_t>(FindCommon::kMaxBytesToReturnToClientAtOnce - bytesBuffered),
+              FindCommon::getBytesToReserveForFirstBatch(findCommand, kThreshold, bytesBuffered));
+
+    ASSERT_EQ(0U,
+              FindCommon::getBytesToReserveForFirstBatch(
+                  findCommand, kThreshold, FindCommon::kMaxBytesToReturnToClientAtOnce));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -221,7 +221,7 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx,
                         2,
                         "Multikey path metadata range index scan stats",
                         "index"_attr = desc->indexName(),
-                        "numSeeks"_attr = mkAccessStats.keysExamined,
+                        "numSeeks"_attr = mkAccessStats.numSeeks,
                         "keysExamined"_attr = mkAccessStats.keysExamined);
         }
     }
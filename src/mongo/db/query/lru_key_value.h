@@ -170,6 +170,21 @@ public:
         return Status::OK();
     }
 
+    /**
+     * Removes the least recently used entry and passes its ownership to the caller. Returns a null
+     * pointer if the kv-store is empty.
+     */
+    std::unique_ptr<V> removeLeastRecentlyUsed() {
+        if (_kvList.empty()) {
+            return std::unique_ptr<V>();
+        }
+        V* evictedEntry = _kvList.back().second;
+        _kvMap.erase(_kvList.back().first);
+        _kvList.pop_back();
+        _currentSize--;
+        return std::unique_ptr<V>(evictedEntry);
+    }
+
     /**
      * Deletes all entries in the kv-store.
      */
@@ -634,6 +634,23 @@ Status PlanCache::set(const CanonicalQuery& query,
                     "evictedEntry"_attr = redact(evictedEntry->debugString()));
     }
 
+    // Keep the estimated memory footprint of all plan caches within budget by evicting this
+    // cache's least recently used entries. The entry just added is never evicted. An entry only
+    // gives its size back to the estimate once it is destroyed, so each evicted entry must be
+    // released before the budget is checked again.
+    evictedEntry.reset();
+    const long long maxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    while (maxSizeBytes > 0 && _cache.size() > 1 &&
+           PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() > maxSizeBytes) {
+        auto lruEntry = _cache.removeLeastRecentlyUsed();
+        LOGV2_DEBUG(6103900,
+                    1,
+                    "Plan cache maximum memory size exceeded - removed least recently used entry",
+                    "namespace"_attr = query.nss(),
+                    "maxSizeBytes"_attr = maxSizeBytes,
+                    "evictedEntry"_attr = redact(lruEntry->debugString()));
+    }
+
     return Status::OK();
 }
 
@@ -1914,6 +1914,35 @@ TEST(PlanCacheTest, ComputeKeyPartialIndex) {
                                                   planCache.computeKey(*cqGtZero));
 }
 
+// The number of elements in an $in list and the values of its elements should not affect the plan
+// cache key, unless they change whether the query is compatible with a partial index.
+TEST(PlanCacheTest, ComputeKeyInListLengthAndValues) {
+    BSONObj filterObj = BSON("f" << BSON("$gt" << 0));
+    unique_ptr<MatchExpression> filterExpr(parseMatchExpression(filterObj));
+
+    PlanCache planCache;
+    const auto keyPattern = BSON("f" << 1);
+    planCache.notifyOfIndexUpdates(
+        {CoreIndexInfo(keyPattern,
+                       IndexNames::nameToType(IndexNames::findPluginName(keyPattern)),
+                       false,                       // sparse
+                       IndexEntry::Identifier{""},  // name
+                       filterExpr.get())});         // filterExpr
+
+    unique_ptr<CanonicalQuery> cqInTwo(canonicalize("{f: {$in: [1, 2]}}"));
+    unique_ptr<CanonicalQuery> cqInThree(canonicalize("{f: {$in: [3, 4, 5]}}"));
+    unique_ptr<CanonicalQuery> cqInMany(
+        canonicalize("{f: {$in: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]}}"));
+    unique_ptr<CanonicalQuery> cqInNegative(canonicalize("{f: {$in: [-1, 2, 3]}}"));
+
+    ASSERT_EQ(planCache.computeKey(*cqInTwo), planCache.computeKey(*cqInThree));
+    ASSERT_EQ(planCache.computeKey(*cqInTwo), planCache.computeKey(*cqInMany));
+
+    // A negative element makes the query incompatible with the partial index.
+    assertPlanCacheKeysUnequalDueToDiscriminators(planCache.computeKey(*cqInNegative),
+                                                  planCache.computeKey(*cqInTwo));
+}
+
 // Query shapes should get the same plan cache key if they have the same collation indexability.
 TEST(PlanCacheTest, ComputeKeyCollationIndex) {
     CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
@@ -2530,6 +2559,42 @@ TEST(PlanCacheTest, PlanCacheSizeWithMultiplePlanCaches) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PlanCacheSizeBudgetEvictsLeastRecentlyUsedEntries) {
+    PlanCache planCache;
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    long long originalSize = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get();
+
+    // Measure the size of a single entry.
+    std::string queryString = "{a: 1, c: 1}";
+    unique_ptr<CanonicalQuery> first(canonicalize(queryString));
+    ASSERT_OK(planCache.set(*first, solns, createDecision(1U), Date_t{}));
+    long long entrySize = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() - originalSize;
+    ASSERT_GT(entrySize, 0);
+
+    // Allow roughly three entries' worth of memory in addition to what is already used.
+    RAIIServerParameterControllerForTest controller{"internalQueryCacheMaxSizeBytes",
+                                                    originalSize + 3 * entrySize + entrySize / 2};
+    // The cache grows to three entries and then evicts exactly one entry per insertion.
+    const std::vector<size_t> expectedSizes = {2U, 3U, 3U, 3U};
+    for (int i = 1; i < 5; ++i) {
+        queryString[1] = 'a' + i;
+        unique_ptr<CanonicalQuery> query(canonicalize(queryString));
+        ASSERT_OK(planCache.set(*query, solns, createDecision(1U), Date_t{}));
+        ASSERT_LTE(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(),
+                   originalSize + 3 * entrySize + entrySize / 2);
+        ASSERT_EQ(planCache.size(), expectedSizes[i - 1]);
+    }
+
+    // The oldest entries were evicted, the most recent one is still cached.
+    ASSERT_EQ(planCache.get(*first).state, PlanCache::CacheEntryState::kNotPresent);
+    unique_ptr<CanonicalQuery> last(canonicalize(queryString));
+    ASSERT_NE(planCache.get(*last).state, PlanCache::CacheEntryState::kNotPresent);
+
+    planCache.clear();
+    ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
+}
+
 TEST(PlanCacheTest, DifferentQueryEngines) {
     // Helper to construct a plan cache key given the 'enableSlotBasedExecutionEngine' flag.
     auto constructPlanCacheKey = [](const PlanCache& pc,
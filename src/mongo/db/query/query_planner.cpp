@@ -890,8 +890,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::planForMul
         uassertStatusOKWithContext(planEnumerator.init(), "failed to initialize plan enumerator");
 
         unique_ptr<MatchExpression> nextTaggedTree;
-        while ((nextTaggedTree = planEnumerator.getNext()) &&
-               (out.size() < params.maxIndexedSolutions)) {
+        while ((out.size() < params.maxIndexedSolutions) &&
+               (nextTaggedTree = planEnumerator.getNext())) {
             LOGV2_DEBUG(20976,
                         5,
                         "About to build solntree from tagged tree",
@@ -899,10 +899,10 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::planForMul
 
             // Store the plan cache index tree before calling prepareForAccessingPlanning(), so that
             // the PlanCacheIndexTree has the same sort as the MatchExpression used to generate the
-            // plan cache key.
-            std::unique_ptr<MatchExpression> clone(nextTaggedTree->shallowClone());
+            // plan cache key. This only reads the tags, so the tagged tree need not be cloned.
             std::unique_ptr<PlanCacheIndexTree> cacheData;
-            auto statusWithCacheData = cacheDataFromTaggedTree(clone.get(), relevantIndices);
+            auto statusWithCacheData =
+                cacheDataFromTaggedTree(nextTaggedTree.get(), relevantIndices);
             if (!statusWithCacheData.isOK()) {
                 LOGV2_DEBUG(20977,
                             5,
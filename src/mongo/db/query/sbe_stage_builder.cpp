@@ -1914,6 +1914,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                         innerCondSlots,
                                                         innerProjectSlots,
                                                         collatorSlot,
+                                                        _cq.getExpCtx()->allowDiskUse,
                                                         root->nodeId());
 
     // If there are more than 2 children, iterate all remaining children and hash
@@ -1936,6 +1937,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                        innerCondSlots,
                                                        innerProjectSlots,
                                                        collatorSlot,
+                                                       _cq.getExpCtx()->allowDiskUse,
                                                        root->nodeId());
     }
 
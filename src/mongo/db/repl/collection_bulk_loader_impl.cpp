@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <numeric>
+
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
@@ -75,7 +77,7 @@ CollectionBulkLoaderImpl::~CollectionBulkLoaderImpl() {
 
 Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndexSpecs) {
     return _runTaskReleaseResourcesOnFailure([&secondaryIndexSpecs, this]() -> Status {
-        return writeConflictRetry(
+        auto status = writeConflictRetry(
             _opCtx.get(),
             "CollectionBulkLoader::init",
             _collection->getNss().ns(),
@@ -118,6 +120,15 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
                 wuow.commit();
                 return Status::OK();
             });
+        if (!status.isOK()) {
+            return status;
+        }
+
+        if (collectionBulkLoaderUsesBulkRecordStoreInserts && !(*_collection)->isCapped()) {
+            _recordStoreBulkBuilder =
+                (*_collection)->getRecordStore()->makeBulkBuilder(_opCtx.get());
+        }
+        return Status::OK();
     });
 }
 
@@ -130,9 +141,17 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
         Status status = writeConflictRetry(
             _opCtx.get(), "CollectionBulkLoaderImpl/insertDocumentsUncapped", _nss.ns(), [&] {
                 WriteUnitOfWork wunit(_opCtx.get());
-                auto insertIter = iter;
-                int bytesInBlock = 0;
-                locs.clear();
+                // Records appended through the bulk builder are not rolled back with the
+                // WriteUnitOfWork, so a retry resumes after the last one rather than inserting it
+                // again.
+                if (!_recordStoreBulkBuilder) {
+                    locs.clear();
+                }
+                auto insertIter = iter + locs.size();
+                int bytesInBlock = std::accumulate(
+                    iter, insertIter, 0, [](int bytes, const BSONObj& doc) {
+                        return bytes + doc.objsize();
+                    });
 
                 auto onRecordInserted = [&](const RecordId& location) {
                     locs.emplace_back(location);
@@ -143,9 +162,12 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
                     const auto& doc = *insertIter++;
                     bytesInBlock += doc.objsize();
                     // This version of insert will not update any indexes.
-                    const auto status =
-                        (*_collection)
-                            ->insertDocumentForBulkLoader(_opCtx.get(), doc, onRecordInserted);
+                    const auto status = (*_collection)
+                                            ->insertDocumentForBulkLoader(
+                                                _opCtx.get(),
+                                                doc,
+                                                onRecordInserted,
+                                                _recordStoreBulkBuilder.get());
                     if (!status.isOK()) {
                         return status;
                     }
@@ -228,6 +250,14 @@ Status CollectionBulkLoaderImpl::commit() {
                     "namespace"_attr = _nss.ns());
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        // Make the documents appended in bulk visible before the indexes are built.
+        if (_recordStoreBulkBuilder) {
+            WriteUnitOfWork wunit(_opCtx.get());
+            _recordStoreBulkBuilder->commit();
+            wunit.commit();
+            _recordStoreBulkBuilder.reset();
+        }
+
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
         if (_secondaryIndexesBlock) {
@@ -342,6 +372,10 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+    // The collection is expected to be dropped after a failure, along with any record appended in
+    // bulk.
+    _recordStoreBulkBuilder.reset();
+
     if (_secondaryIndexesBlock) {
         CollectionWriter collWriter(*_collection);
         _secondaryIndexesBlock->abortIndexBuild(
@@ -108,6 +108,9 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    // Appends documents to the record store in bulk when it supports it. Committed before the
+    // indexes are built, since that may delete documents with duplicate _id values.
+    std::unique_ptr<RecordStoreBulkBuilderInterface> _recordStoreBulkBuilder;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
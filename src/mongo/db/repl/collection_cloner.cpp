@@ -31,7 +31,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/index_build_entry_helpers.h"
 #include "mongo/db/index_builds_coordinator.h"
@@ -39,11 +42,14 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -56,6 +62,11 @@ MONGO_FAIL_POINT_DEFINE(initialSyncHangDuringCollectionClone);
 // DBClientConnection, optionally limited to a specific collection.
 MONGO_FAIL_POINT_DEFINE(initialSyncHangCollectionClonerAfterHandlingBatchResponse);
 
+namespace {
+// The number of _id values sampled per partition when choosing partition boundaries.
+const int kPartitionSamplesPerPartition = 32;
+}  // namespace
+
 CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
                                    const CollectionOptions& collectionOptions,
                                    InitialSyncSharedData* sharedData,
@@ -96,7 +107,9 @@ CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
           _dbWorkTaskRunner.schedule(std::move(task));
           return executor::TaskExecutor::CallbackHandle();
       }),
-      _dbWorkTaskRunner(dbPool) {
+      _dbWorkTaskRunner(dbPool),
+      _createClientFn(
+          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }) {
     invariant(sourceNss.isValid());
     invariant(collectionOptions.uuid);
     _sourceDbAndUuid = NamespaceStringOrUUID(sourceNss.db().toString(), *collectionOptions.uuid);
@@ -236,7 +249,12 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
+    planQueryPartitions();
+    if (_queryPartitions.empty()) {
+        runQuery();
+    } else {
+        runPartitionedQuery();
+    }
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -371,6 +389,235 @@ void CollectionCloner::runQuery() {
     }
 }
 
+std::vector<BSONObj> CollectionCloner::choosePartitionBoundaries(
+    const std::vector<BSONObj>& sortedIds, int numPartitions) {
+    std::vector<BSONObj> boundaries;
+    if (sortedIds.empty()) {
+        return boundaries;
+    }
+    for (int i = 1; i < numPartitions; ++i) {
+        const auto& candidate = sortedIds[sortedIds.size() * i / numPartitions];
+        if (!boundaries.empty() && candidate.binaryEqual(boundaries.back())) {
+            continue;
+        }
+        boundaries.push_back(candidate.getOwned());
+    }
+    return boundaries;
+}
+
+void CollectionCloner::planQueryPartitions() {
+    if (_queryPartitionsPlanned) {
+        return;
+    }
+
+    const auto numPartitions = collectionClonerPartitionCount.load();
+    long long bytesToCopy;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        bytesToCopy = _stats.bytesToCopy;
+    }
+
+    // Ranges are taken over the _id index, which capped and clustered collections either lack or
+    // must not be cloned by, since their documents have to be inserted in natural order. Finished
+    // ranges are remembered across retries, which is only needed where queries are resumable.
+    std::vector<BSONObj> boundaries;
+    if (numPartitions > 1 && _resumeSupported && !_collectionOptions.capped &&
+        !_idIndexSpec.isEmpty() && bytesToCopy >= collectionClonerPartitionMinBytes.load()) {
+        boundaries = samplePartitionBoundaries(numPartitions);
+    }
+
+    _queryPartitionsPlanned = true;
+    if (boundaries.empty()) {
+        return;
+    }
+
+    BSONObj min;
+    for (auto&& boundary : boundaries) {
+        _queryPartitions.push_back({min, boundary});
+        min = boundary;
+    }
+    _queryPartitions.push_back({min, BSONObj()});
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _usingPartitionedQuery = true;
+    }
+
+    LOGV2(6102300,
+          "Collection cloner will copy the collection with concurrent _id range queries",
+          "namespace"_attr = _sourceNss.ns(),
+          "numPartitions"_attr = _queryPartitions.size());
+}
+
+std::vector<BSONObj> CollectionCloner::samplePartitionBoundaries(int numPartitions) {
+    const int sampleSize = numPartitions * kPartitionSamplesPerPartition;
+    BSONObj res;
+    getClient()->runCommand(
+        _sourceNss.db().toString(),
+        BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                         << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                       << BSON("$project" << BSON("_id" << 1))
+                                       << BSON("$sort" << BSON("_id" << 1)))
+                         << "cursor" << BSON("batchSize" << sampleSize + 1)),
+        res,
+        QueryOption_SecondaryOk);
+    if (auto status = getStatusFromCommandResult(res); !status.isOK()) {
+        LOGV2_DEBUG(6102301,
+                    1,
+                    "Collection cloner will copy the collection with a single query because "
+                    "sampling _id values failed",
+                    "namespace"_attr = _sourceNss.ns(),
+                    "error"_attr = status);
+        return {};
+    }
+
+    std::vector<BSONObj> sortedIds;
+    for (auto&& elem : res.getObjectField("cursor").getObjectField("firstBatch")) {
+        sortedIds.push_back(elem.Obj());
+    }
+    return choosePartitionBoundaries(sortedIds, numPartitions);
+}
+
+void CollectionCloner::runPartitionedQuery() {
+    _abortPartitionedQuery.store(false);
+    Status firstError = Status::OK();
+    std::vector<stdx::thread> threads;
+    for (auto& partition : _queryPartitions) {
+        if (partition.done) {
+            continue;
+        }
+        threads.emplace_back([this, &partition, &firstError] {
+            ThreadClient tc("CollectionClonerPartition", getGlobalServiceContext());
+            try {
+                runPartitionQuery(&partition);
+            } catch (const DBException& ex) {
+                stdx::lock_guard<Latch> lk(_mutex);
+                if (firstError.isOK()) {
+                    firstError = ex.toStatus();
+                }
+                // Only stop the other partitions once the error is recorded, so their
+                // cancellation is not reported in its place. Shutting down their connections
+                // also stops the ones waiting on the network.
+                _abortPartitionedQuery.store(true);
+                for (auto client : _partitionClients) {
+                    client->shutdownAndDisallowReconnect();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // NamespaceNotFound is rethrown like any other error and ends the clone cleanly.
+    uassertStatusOK(firstError);
+}
+
+void CollectionCloner::runPartitionQuery(QueryPartition* partition) {
+    auto client = _createClientFn();
+
+    // Register the connection both with this cloner, so a failing partition can stop the others,
+    // and with the initial syncer, so canceling the attempt does too.
+    {
+        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+        uassert(ErrorCodes::CallbackCanceled,
+                str::stream() << "Collection cloning cancelled due to initial sync failure: "
+                              << getSharedData()->getStatus(lk),
+                getSharedData()->getStatus(lk).isOK());
+        getSharedData()->registerClient(lk, client.get());
+    }
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+        getSharedData()->unregisterClient(lk, client.get());
+    });
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        uassert(ErrorCodes::CallbackCanceled,
+                "Collection cloning cancelled because another partition failed",
+                !_abortPartitionedQuery.load());
+        _partitionClients.push_back(client.get());
+    }
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _partitionClients.erase(
+            std::find(_partitionClients.begin(), _partitionClients.end(), client.get()));
+    });
+
+    uassertStatusOK(client->connect(getSource(), StringData(), boost::none));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+
+    Query query;
+    query.hint(BSON("_id" << 1)).readOnce(true);
+    if (!partition->lastId.isEmpty()) {
+        // Resume from the last document received; the min bound includes it, so skip it.
+        query.minKey(partition->lastId);
+        partition->skipLastId = true;
+    } else if (!partition->min.isEmpty()) {
+        query.minKey(partition->min);
+    }
+    if (!partition->max.isEmpty()) {
+        query.maxKey(partition->max);
+    }
+
+    auto handleBatch = [this, partition](DBClientCursorBatchIterator& iter) {
+        handleNextPartitionBatch(partition, iter);
+    };
+    client->query(handleBatch,
+                  _sourceDbAndUuid,
+                  BSONObj{},
+                  query,
+                  nullptr /* fieldsToReturn */,
+                  QueryOption_NoCursorTimeout | QueryOption_SecondaryOk |
+                      (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+                  _collectionClonerBatchSize,
+                  ReadConcernArgs::kImplicitDefault);
+    partition->done = true;
+}
+
+void CollectionCloner::handleNextPartitionBatch(QueryPartition* partition,
+                                                DBClientCursorBatchIterator& iter) {
+    {
+        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+        if (!getSharedData()->getStatus(lk).isOK()) {
+            uasserted(ErrorCodes::CallbackCanceled,
+                      str::stream() << "Collection cloning cancelled due to initial sync failure: "
+                                    << getSharedData()->getStatus(lk));
+        }
+    }
+    uassert(ErrorCodes::CallbackCanceled,
+            "Collection cloning cancelled because another partition failed",
+            !_abortPartitionedQuery.load());
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.receivedBatches++;
+        BSONObj lastDoc;
+        while (iter.moreInCurrentBatch()) {
+            auto doc = iter.nextSafe();
+            if (partition->skipLastId) {
+                partition->skipLastId = false;
+                if (doc["_id"].wrap().binaryEqual(partition->lastId)) {
+                    continue;
+                }
+            }
+            lastDoc = doc;
+            _documentsToInsert.emplace_back(std::move(doc));
+        }
+        if (!lastDoc.isEmpty()) {
+            partition->lastId = lastDoc["_id"].wrap();
+        }
+    }
+
+    auto&& scheduleResult = _scheduleDbWorkFn(
+        [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
+    if (!scheduleResult.isOK()) {
+        uassertStatusOK(scheduleResult.getStatus().withContext(
+            str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'"));
+    }
+
+    hangAfterHandlingBatchIfRequested();
+}
+
 void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
     {
         stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
@@ -421,6 +668,10 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
         _resumeToken = iter.getPostBatchResumeToken();
     }
 
+    hangAfterHandlingBatchIfRequested();
+}
+
+void CollectionCloner::hangAfterHandlingBatchIfRequested() {
     initialSyncHangCollectionClonerAfterHandlingBatchResponse.executeIf(
         [&](const BSONObj&) {
             while (MONGO_unlikely(
@@ -452,6 +703,11 @@ void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::Cal
         // 'receivedBatches'.
         ++_stats.fetchedBatches;
         if (_documentsToInsert.size() == 0) {
+            // With concurrent partitions, an earlier callback may already have inserted the
+            // documents this one was scheduled for.
+            if (_usingPartitionedQuery) {
+                return;
+            }
             LOGV2_WARNING(21145,
                           "insertDocumentsCallback, but no documents to insert for ns:{namespace}",
                           "insertDocumentsCallback, but no documents to insert",
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include "mongo/db/repl/initial_sync_base_cloner.h"
 #include "mongo/db/repl/initial_sync_shared_data.h"
 #include "mongo/db/repl/task_runner.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -77,6 +79,13 @@ public:
     using ScheduleDbWorkFn = unique_function<StatusWith<executor::TaskExecutor::CallbackHandle>(
         executor::TaskExecutor::CallbackFn)>;
 
+    /**
+     * Type of function to create the additional connections used by a partitioned query.
+     *
+     * Used for testing only.
+     */
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     CollectionCloner(const NamespaceString& ns,
                      const CollectionOptions& collectionOptions,
                      InitialSyncSharedData* sharedData,
@@ -122,6 +131,23 @@ public:
         _scheduleDbWorkFn = std::move(scheduleDbWorkFn);
     }
 
+    /**
+     * Overrides how connections for partitioned queries are created.
+     *
+     * For testing only.
+     */
+    void setCreateClientFn_forTest(CreateClientFn createClientFn) {
+        _createClientFn = std::move(createClientFn);
+    }
+
+    /**
+     * Picks up to 'numPartitions' - 1 split points from 'sortedIds', a sample of { _id: ... }
+     * documents sorted in _id index order, so that each resulting range holds about the same
+     * share of the sample. Repeated split points are dropped.
+     */
+    static std::vector<BSONObj> choosePartitionBoundaries(const std::vector<BSONObj>& sortedIds,
+                                                          int numPartitions);
+
 protected:
     ClonerStages getStages() final;
 
@@ -232,6 +258,52 @@ private:
      */
     void abortNonResumableClone(const Status& status);
 
+    /**
+     * A range of the _id index copied by one of the concurrent queries of a partitioned clone.
+     */
+    struct QueryPartition {
+        BSONObj min;     // Inclusive { _id: ... } bound, empty for the first partition.
+        BSONObj max;     // Exclusive { _id: ... } bound, empty for the last partition.
+        BSONObj lastId;  // { _id: ... } of the last document received, used to resume.
+        bool skipLastId = false;  // The next document may be 'lastId', which is already queued.
+        bool done = false;
+    };
+
+    /**
+     * Decides, once per clone, whether the query stage copies the collection as several
+     * concurrent _id ranges, and if so fills _queryPartitions.
+     */
+    void planQueryPartitions();
+
+    /**
+     * Samples _id values on the source with $sample and returns the split points between
+     * 'numPartitions' ranges. Returns no split points if sampling fails.
+     */
+    std::vector<BSONObj> samplePartitionBoundaries(int numPartitions);
+
+    /**
+     * Copies every unfinished partition concurrently, each over its own connection to the sync
+     * source. Throws the first error any partition hit once all of them have stopped; finished
+     * partitions are not copied again when the stage is retried.
+     */
+    void runPartitionedQuery();
+
+    /**
+     * Copies, or resumes copying, a single partition. Throws on error.
+     */
+    void runPartitionQuery(QueryPartition* partition);
+
+    /**
+     * Like handleNextBatch(), for a batch returned by a partition's query.
+     */
+    void handleNextPartitionBatch(QueryPartition* partition, DBClientCursorBatchIterator& iter);
+
+    /**
+     * Blocks while the initialSyncHangCollectionClonerAfterHandlingBatchResponse fail point is
+     * enabled for this collection.
+     */
+    void hangAfterHandlingBatchIfRequested();
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -282,6 +354,25 @@ private:
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
     bool _lostNonResumableCursor = false;  // (X)
+
+    // Whether planQueryPartitions() has run for this clone.
+    bool _queryPartitionsPlanned = false;  // (X)
+
+    // The _id ranges of a partitioned query, empty if the collection is cloned with one query.
+    // While runPartitionedQuery() runs, each partition is only accessed by its own thread.
+    std::vector<QueryPartition> _queryPartitions;  // (X)
+
+    // Whether _queryPartitions is non-empty, for the database work threads.
+    bool _usingPartitionedQuery = false;  // (M)
+
+    // Set when a partition fails so the other partitions stop early.
+    AtomicWord<bool> _abortPartitionedQuery{false};  // (S)
+
+    // The connections of the partitions currently running, shut down when one of them fails.
+    std::vector<DBClientConnection*> _partitionClients;  // (M)
+
+    // Creates the connections used by partitioned queries.
+    CreateClientFn _createClientFn;  // (R)
 };
 
 }  // namespace repl
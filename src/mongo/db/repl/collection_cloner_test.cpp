@@ -39,6 +39,7 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/thread_pool.h"
 
@@ -373,6 +374,136 @@ TEST_F(CollectionClonerTestResumable, InsertDocumentsSingleBatch) {
     ASSERT_EQUALS(1u, stats.receivedBatches);
 }
 
+TEST_F(CollectionClonerTestResumable, PartitionedQueryFallsBackToSingleQueryIfSamplingFails) {
+    RAIIServerParameterControllerForTest partitionCount("collectionClonerPartitionCount", 4);
+    RAIIServerParameterControllerForTest partitionMinBytes("collectionClonerPartitionMinBytes", 0);
+
+    // Set up data for preliminary stages
+    setMockServerReplies(BSON("size" << 10),
+                         createCountResponse(2),
+                         createCursorResponse(_nss.ns(), BSON_ARRAY(_idIndexSpec)));
+    _mockServer->setCommandReply("aggregate", Status(ErrorCodes::OperationFailed, ""));
+
+    // Set up documents to be returned from upstream node.
+    _mockServer->insert(_nss.ns(), BSON("_id" << 1));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 2));
+
+    auto cloner = makeCollectionCloner();
+    ASSERT_OK(cloner->run());
+
+    ASSERT_EQUALS(2, _collectionStats->insertCount);
+    ASSERT_TRUE(_collectionStats->commitCalled);
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(1u, stats.receivedBatches);
+}
+
+TEST_F(CollectionClonerTestResumable, PartitionedQueryResumesUnfinishedPartitionsAfterFailure) {
+    RAIIServerParameterControllerForTest partitionCount("collectionClonerPartitionCount", 2);
+    RAIIServerParameterControllerForTest partitionMinBytes("collectionClonerPartitionMinBytes", 0);
+
+    // Set up data for preliminary stages
+    setMockServerReplies(BSON("size" << 10),
+                         createCountResponse(4),
+                         createCursorResponse(_nss.ns(), BSON_ARRAY(_idIndexSpec)));
+
+    // The sample splits the collection at { _id: 4 }, so the first partition holds three
+    // documents and the second one.
+    _mockServer->setCommandReply("aggregate",
+                                 createCursorResponse(_nss.ns(),
+                                                      BSON_ARRAY(BSON("_id" << 1)
+                                                                 << BSON("_id" << 2)
+                                                                 << BSON("_id" << 3)
+                                                                 << BSON("_id" << 4)
+                                                                 << BSON("_id" << 5)
+                                                                 << BSON("_id" << 6))));
+
+    // Set up documents to be returned from upstream node.
+    _mockServer->insert(_nss.ns(), BSON("_id" << 1));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 2));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 3));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 4));
+
+    // Preliminary setup for hanging failpoint.
+    auto afterBatchFailpoint =
+        globalFailPointRegistry().find("initialSyncHangCollectionClonerAfterHandlingBatchResponse");
+    afterBatchFailpoint->setMode(FailPoint::alwaysOn, 0);
+
+    auto cloner = makeCollectionCloner();
+    cloner->setBatchSize_forTest(2);
+    cloner->setCreateClientFn_forTest(
+        [&] { return std::make_unique<MockDBClientConnection>(_mockServer.get()); });
+
+    // Run every insert twice, as if the callback scheduled for another partition's batch had
+    // already inserted the documents. The second run must find nothing to insert.
+    cloner->setScheduleDbWorkFn_forTest([&](const executor::TaskExecutor::CallbackFn& workFn) {
+        executor::TaskExecutor::CallbackHandle handle(std::make_shared<MockCallbackState>());
+        mongo::executor::TaskExecutor::CallbackArgs args{nullptr, handle, Status::OK()};
+        workFn(args);
+        workFn(args);
+        return StatusWith<executor::TaskExecutor::CallbackHandle>(handle);
+    });
+
+    _mockServer->clearCounters();
+    startCapturingLogMessages();
+
+    // Run the cloner in a separate thread.
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+
+    // Wait for both partitions to process their first batch. Only the first partition has more
+    // documents to fetch.
+    while (cloner->getStats().receivedBatches < 2) {
+        sleepmillis(10);
+    }
+
+    // This will cause the first partition's next batch to fail once (transiently).
+    auto failNextBatch = globalFailPointRegistry().find("mockCursorThrowErrorOnGetMore");
+    failNextBatch->setMode(FailPoint::nTimes, 1, fromjson("{errorType: 'HostUnreachable'}"));
+
+    // Let the query stage finish.
+    afterBatchFailpoint->setMode(FailPoint::off, 0);
+    clonerThread.join();
+
+    stopCapturingLogMessages();
+
+    // The retry only queries the first partition again, from the last _id it received, and skips
+    // that document. The finished second partition is not queried again. Since the
+    // CollectionMockStats class does not de-duplicate inserts, any document copied twice would
+    // increase insertCount.
+    ASSERT_EQUALS(3u, _mockServer->getQueryCount());
+    ASSERT_EQUALS(4, _collectionStats->insertCount);
+    ASSERT_TRUE(_collectionStats->commitCalled);
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(4u, stats.documentsCopied);
+
+    // The inserts finding no documents are expected with partitions, and are not warned about.
+    ASSERT_EQUALS(0, countBSONFormatLogLinesIsSubset(BSON("id" << 21145)));
+}
+
+TEST(CollectionClonerPartitionTest, ChoosePartitionBoundaries) {
+    std::vector<BSONObj> sortedIds;
+    for (int i = 0; i < 8; ++i) {
+        sortedIds.push_back(BSON("_id" << i));
+    }
+
+    auto boundaries = CollectionCloner::choosePartitionBoundaries(sortedIds, 4);
+    ASSERT_EQUALS(3u, boundaries.size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), boundaries[0]);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 4), boundaries[1]);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 6), boundaries[2]);
+
+    // A sample smaller than the number of partitions yields fewer, distinct boundaries.
+    boundaries = CollectionCloner::choosePartitionBoundaries({BSON("_id" << 5)}, 4);
+    ASSERT_EQUALS(1u, boundaries.size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 5), boundaries[0]);
+
+    ASSERT_TRUE(CollectionCloner::choosePartitionBoundaries({}, 4).empty());
+    ASSERT_TRUE(CollectionCloner::choosePartitionBoundaries(sortedIds, 1).empty());
+}
+
 TEST_F(CollectionClonerTestResumable, BatchSizeStoredInConstructor) {
     auto batchSizeDefault = collectionClonerBatchSize;
     collectionClonerBatchSize = 3;
@@ -286,7 +286,8 @@ Status DbCheckHasher::hashAll(void) {
 
     PlanExecutor::ExecState lastState;
     while (PlanExecutor::ADVANCED == (lastState = _exec->getNext(&currentObj, nullptr))) {
-        if (!currentObj.hasField("_id")) {
+        const auto idElem = currentObj["_id"];
+        if (idElem.eoo()) {
             return Status(ErrorCodes::NoSuchKey, "Document missing _id");
         }
 
@@ -296,7 +297,7 @@ Status DbCheckHasher::hashAll(void) {
         }
 
         // Update `last` every time.
-        _last = BSONKey::parseFromBSON(currentObj["_id"]);
+        _last = BSONKey::parseFromBSON(idElem);
         _bytesSeen += currentObj.objsize();
         _countSeen += 1;
 
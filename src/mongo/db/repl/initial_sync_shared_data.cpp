@@ -31,6 +31,10 @@
 
 #include "mongo/db/repl/initial_sync_shared_data.h"
 
+#include <algorithm>
+
+#include "mongo/client/dbclient_connection.h"
+
 namespace mongo {
 namespace repl {
 int InitialSyncSharedData::incrementRetryingOperations(WithLock lk) {
@@ -76,5 +80,21 @@ Milliseconds InitialSyncSharedData::getCurrentOutageDuration(WithLock lk) {
                                            : Milliseconds::min());
 }
 
+void InitialSyncSharedData::registerClient(WithLock lk, DBClientConnection* client) {
+    _registeredClients.push_back(client);
+}
+
+void InitialSyncSharedData::unregisterClient(WithLock lk, DBClientConnection* client) {
+    auto it = std::find(_registeredClients.begin(), _registeredClients.end(), client);
+    invariant(it != _registeredClients.end());
+    _registeredClients.erase(it);
+}
+
+void InitialSyncSharedData::shutdownRegisteredClients(WithLock lk) {
+    for (auto client : _registeredClients) {
+        client->shutdownAndDisallowReconnect();
+    }
+}
+
 }  // namespace repl
 }  // namespace mongo
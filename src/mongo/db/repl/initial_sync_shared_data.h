@@ -30,11 +30,15 @@
 #pragma once
 
 #include <mutex>
+#include <vector>
 
 #include "mongo/db/repl/repl_sync_shared_data.h"
 #include "mongo/db/server_options.h"
 
 namespace mongo {
+
+class DBClientConnection;
+
 namespace repl {
 class InitialSyncSharedData final : public ReplSyncSharedData {
 private:
@@ -128,6 +132,19 @@ public:
         _allowedOutageDuration = allowedOutageDuration;
     }
 
+    /**
+     * Registers a connection to the sync source that a cloner opened in addition to the initial
+     * syncer's own, so that canceling the attempt also shuts it down. The connection must be
+     * unregistered before it is destroyed.
+     */
+    void registerClient(WithLock lk, DBClientConnection* client);
+    void unregisterClient(WithLock lk, DBClientConnection* client);
+
+    /**
+     * Shuts down every registered connection, and keeps them from reconnecting.
+     */
+    void shutdownRegisteredClients(WithLock lk);
+
 private:
     class RetryingOperation {
     public:
@@ -214,6 +231,9 @@ private:
 
     // The initial sync ID on the source at the start of data cloning.
     boost::optional<UUID> _initialSyncSourceId;
+
+    // Additional connections to the sync source, shut down when the attempt is canceled.
+    std::vector<DBClientConnection*> _registeredClients;
 };
 }  // namespace repl
 }  // namespace mongo
@@ -362,6 +362,7 @@ void InitialSyncer::_cancelRemainingWork_inlock() {
         stdx::lock_guard<InitialSyncSharedData> lock(*_sharedData);
         _sharedData->setStatusIfOK(
             lock, Status{ErrorCodes::CallbackCanceled, "Initial sync attempt canceled"});
+        _sharedData->shutdownRegisteredClients(lock);
     }
     if (_client) {
         _client->shutdownAndDisallowReconnect();
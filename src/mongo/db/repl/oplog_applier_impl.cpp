@@ -72,6 +72,12 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
+// Number of batches and time the applier spent waiting for the batcher to hand over each one. The
+// batcher prepares the next batch while the current one applies, so this stays near zero unless
+// batch preparation is slower than application.
+TimerStats waitForBatchStats;
+ServerStatusMetricField<TimerStats> displayWaitForBatch("repl.apply.waitForBatch",
+                                                        &waitForBatchStats);
 
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
@@ -265,6 +271,9 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             ? new ApplyBatchFinalizerForJournal(_replCoord)
             : new ApplyBatchFinalizer(_replCoord)};
 
+    // Measures the wait for the next batch across all of the one-second retries below. It is only
+    // reset once a batch has been applied.
+    Timer waitForBatchTimer;
     while (true) {  // Exits on message from OplogBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -308,6 +317,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             }
             continue;  // Try again.
         }
+        waitForBatchStats.record(waitForBatchTimer);
 
         // Extract some info from ops that we'll need after releasing the batch below.
         const auto firstOpTimeInBatch = ops.front().getOpTime();
@@ -364,6 +374,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // 4. Finalize this batch. The finalizer advances the global timestamp to lastOpTimeInBatch.
         finalizer->record({lastOpTimeInBatch, lastWallTimeInBatch});
+        waitForBatchTimer.reset();
     }
 }
 
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -56,6 +57,7 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -539,6 +541,148 @@ TEST_F(OplogApplierImplTest,
                   secondDerivedOp.getObject()["lastWriteOpTime"]["ts"].timestamp());
 }
 
+/**
+ * Fills writer vectors for an insert, an update and a delete on each of 'numDocs' documents in
+ * 'nss', returning the writer vectors. Ops are appended to 'ops', which must outlive the result.
+ */
+std::vector<std::vector<const OplogEntry*>> fillWriterVectorsWithCrudOps(
+    OperationContext* opCtx,
+    ReplicationConsistencyMarkers* const consistencyMarkers,
+    StorageInterface* const storageInterface,
+    const NamespaceString& nss,
+    int numDocs,
+    std::vector<OplogEntry>* ops) {
+    auto writerPool = makeReplWriterPool(16);
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(opCtx),
+        consistencyMarkers,
+        storageInterface,
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    unsigned int i = 1;
+    for (int id = 0; id < numDocs; ++id) {
+        ops->push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i++), 1LL}, nss, BSON("_id" << id << "x" << 0)));
+        ops->push_back(makeUpdateDocumentOplogEntry({Timestamp(Seconds(1), i++), 1LL},
+                                                    nss,
+                                                    BSON("_id" << id),
+                                                    BSON("$set" << BSON("x" << 1))));
+        ops->push_back(makeDeleteDocumentOplogEntry(
+            {Timestamp(Seconds(1), i++), 1LL}, nss, BSON("_id" << id)));
+    }
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(
+        writerPool->getStats().options.maxThreads);
+    std::vector<std::vector<OplogEntry>> derivedOps;
+    oplogApplier.fillWriterVectors_forTest(opCtx, ops, &writerVectors, &derivedOps);
+    return writerVectors;
+}
+
+TEST_F(OplogApplierImplTest, CrudOpsOnOneCollectionArePartitionedByIdAcrossWriters) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+
+    const int numDocs = 64;
+    std::vector<OplogEntry> ops;
+    auto writerVectors = fillWriterVectorsWithCrudOps(
+        _opCtx.get(), getConsistencyMarkers(), getStorageInterface(), nss, numDocs, &ops);
+
+    // Updates and deletes are spread across writers just like inserts, so a single hot collection
+    // does not bottleneck on one writer thread.
+    auto busyWriters = std::count_if(writerVectors.begin(),
+                                     writerVectors.end(),
+                                     [](const auto& writer) { return !writer.empty(); });
+    ASSERT_GT(busyWriters, 1);
+
+    // All ops on the same document must land on the same writer, in oplog order.
+    std::map<int, size_t> writerForId;
+    std::map<int, std::vector<OpTypeEnum>> opTypesForId;
+    for (size_t writerId = 0; writerId < writerVectors.size(); ++writerId) {
+        for (const auto* op : writerVectors[writerId]) {
+            int id = op->getIdElement().numberInt();
+            auto [it, inserted] = writerForId.emplace(id, writerId);
+            ASSERT_EQUALS(writerId, it->second);
+            opTypesForId[id].push_back(op->getOpType());
+        }
+    }
+    ASSERT_EQUALS(static_cast<size_t>(numDocs), opTypesForId.size());
+    for (const auto& [id, opTypes] : opTypesForId) {
+        std::vector<OpTypeEnum> expected{
+            OpTypeEnum::kInsert, OpTypeEnum::kUpdate, OpTypeEnum::kDelete};
+        ASSERT(opTypes == expected) << "ops for _id " << id << " were reordered";
+    }
+}
+
+TEST_F(OplogApplierImplTest, GroupInsertsWithinNamespaceMovesIndependentInsertsTogether) {
+    NamespaceString nss1("test.a");
+    NamespaceString nss2("test.b");
+    unsigned int i = 1;
+    auto nextOpTime = [&] { return OpTime(Timestamp(Seconds(1), i++), 1LL); };
+    std::vector<OplogEntry> ops{
+        makeInsertDocumentOplogEntry(nextOpTime(), nss1, BSON("_id" << 1)),
+        makeUpdateDocumentOplogEntry(
+            nextOpTime(), nss1, BSON("_id" << 10), BSON("$set" << BSON("x" << 1))),
+        makeInsertDocumentOplogEntry(nextOpTime(), nss1, BSON("_id" << 2)),
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss1, BSON("_id" << 11)),
+        makeInsertDocumentOplogEntry(nextOpTime(), nss1, BSON("_id" << 3)),
+        // The insert of _id 5 must stay after the delete that precedes it.
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss2, BSON("_id" << 5)),
+        makeInsertDocumentOplogEntry(nextOpTime(), nss2, BSON("_id" << 5)),
+    };
+    std::vector<const OplogEntry*> opPtrs;
+    for (const auto& op : ops) {
+        opPtrs.push_back(&op);
+    }
+
+    OplogApplierUtils::groupInsertsWithinNamespace(&opPtrs);
+
+    std::vector<const OplogEntry*> expected{
+        &ops[0], &ops[2], &ops[4], &ops[1], &ops[3], &ops[5], &ops[6]};
+    ASSERT(opPtrs == expected);
+}
+
+TEST_F(OplogApplierImplTest, GroupInsertsWithinNamespaceSkipsCollationSensitiveIds) {
+    NamespaceString nss("test.a");
+    unsigned int i = 1;
+    auto nextOpTime = [&] { return OpTime(Timestamp(Seconds(1), i++), 1LL); };
+    // Under a case-insensitive collation these two _id values are the same document.
+    std::vector<OplogEntry> ops{
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id"
+                                                             << "A")),
+        makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id"
+                                                             << "a")),
+    };
+    std::vector<const OplogEntry*> opPtrs{&ops[0], &ops[1]};
+
+    OplogApplierUtils::groupInsertsWithinNamespace(&opPtrs);
+
+    ASSERT_EQUALS(&ops[0], opPtrs[0]);
+    ASSERT_EQUALS(&ops[1], opPtrs[1]);
+}
+
+TEST_F(OplogApplierImplTest, CrudOpsOnCappedCollectionAreSerializedOnOneWriter) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    CollectionOptions options;
+    options.capped = true;
+    options.cappedSize = 1024 * 1024;
+    createCollection(_opCtx.get(), nss, options);
+
+    std::vector<OplogEntry> ops;
+    auto writerVectors = fillWriterVectorsWithCrudOps(
+        _opCtx.get(), getConsistencyMarkers(), getStorageInterface(), nss, 64, &ops);
+
+    // Capped collections must preserve insertion order, so their ops are never split by _id.
+    auto busyWriters = std::count_if(writerVectors.begin(),
+                                     writerVectors.end(),
+                                     [](const auto& writer) { return !writer.empty(); });
+    ASSERT_EQUALS(1, busyWriters);
+}
+
 class MultiOplogEntryOplogApplierImplTest : public OplogApplierImplTest {
 public:
     MultiOplogEntryOplogApplierImplTest()
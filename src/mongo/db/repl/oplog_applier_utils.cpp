@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -82,7 +83,10 @@ void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
     auto collProperties = collPropertiesCache->getCollectionProperties(opCtx, *hashedNs);
 
     // Include the _id of the document in the hash so we get parallelism even if all writes are to a
-    // single collection.
+    // single collection. This applies to updates and deletes as well as inserts: ops on the same
+    // document still land on the same writer in oplog order, and unique secondary index
+    // constraints are not enforced during secondary application, so ops on distinct documents
+    // never have to be serialized.
     //
     // For capped collections, this is illegal, since capped collections must preserve
     // insertion order.
@@ -144,6 +148,69 @@ void OplogApplierUtils::stableSortByNamespace(std::vector<const OplogEntry*>* op
     std::stable_sort(oplogEntryPointers->begin(), oplogEntryPointers->end(), nssComparator);
 }
 
+namespace {
+/**
+ * Returns whether the inserts in the same-namespace run [begin, end) can be moved ahead of the
+ * updates and deletes in it without changing the outcome of applying the run, and whether doing
+ * so would change anything.
+ */
+bool canGroupInsertsInRun(std::vector<const OplogEntry*>::const_iterator begin,
+                          std::vector<const OplogEntry*>::const_iterator end) {
+    auto idsBeforeInsert = SimpleBSONElementComparator::kInstance.makeBSONEltUnorderedSet();
+    bool hasInsertAfterOtherOp = false;
+    for (auto it = begin; it != end; ++it) {
+        const OplogEntry* op = *it;
+        if (!op->isCrudOpType() || op->isForCappedCollection()) {
+            return false;
+        }
+
+        // Under a non-simple collation, _id values that compare unequal here may still identify
+        // the same document, so only reorder around types that collations cannot affect.
+        BSONElement id = op->getIdElement();
+        switch (id.type()) {
+            case EOO:
+            case String:
+            case Symbol:
+            case Object:
+            case Array:
+                return false;
+            default:
+                break;
+        }
+
+        if (op->getOpType() != OpTypeEnum::kInsert) {
+            idsBeforeInsert.insert(id);
+            continue;
+        }
+        if (idsBeforeInsert.empty()) {
+            continue;
+        }
+        if (idsBeforeInsert.count(id)) {
+            return false;
+        }
+        hasInsertAfterOtherOp = true;
+    }
+    return hasInsertAfterOtherOp;
+}
+}  // namespace
+
+void OplogApplierUtils::groupInsertsWithinNamespace(
+    std::vector<const OplogEntry*>* oplogEntryPointers) {
+    auto runBegin = oplogEntryPointers->begin();
+    while (runBegin != oplogEntryPointers->end()) {
+        const auto& nss = (*runBegin)->getNss();
+        auto runEnd = std::find_if(runBegin + 1,
+                                   oplogEntryPointers->end(),
+                                   [&](const OplogEntry* op) { return op->getNss() != nss; });
+        if (canGroupInsertsInRun(runBegin, runEnd)) {
+            std::stable_partition(runBegin, runEnd, [](const OplogEntry* op) {
+                return op->getOpType() == OpTypeEnum::kInsert;
+            });
+        }
+        runBegin = runEnd;
+    }
+}
+
 void OplogApplierUtils::addDerivedOps(OperationContext* opCtx,
                                       std::vector<OplogEntry>* derivedOps,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -286,7 +353,9 @@ Status OplogApplierUtils::applyOplogBatchCommon(
     DisableDocumentValidation validationDisabler(opCtx);
     // Group the operations by namespace in order to get larger groups for bulk inserts, but do not
     // mix up the current order of oplog entries within the same namespace (thus *stable* sort).
+    // Then, where it cannot change the result, move each namespace's inserts next to each other.
     stableSortByNamespace(ops);
+    groupInsertsWithinNamespace(ops);
     InsertGroup insertGroup(
         ops, opCtx, oplogApplicationMode, isDataConsistent, applyOplogEntryOrGroupedInserts);
 
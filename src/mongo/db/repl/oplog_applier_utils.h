@@ -73,6 +73,16 @@ public:
      */
     static void stableSortByNamespace(std::vector<const OplogEntry*>* oplogEntryPointers);
 
+    /**
+     * Within each run of ops on the same namespace, which stableSortByNamespace() produces, moves
+     * the inserts ahead of the updates and deletes so that InsertGroup can apply them in bulk.
+     * The relative order of the inserts, and of the other ops, is kept. A run is left untouched
+     * unless every insert only targets a document that no earlier update or delete in the run
+     * touches, so the reordered ops commute. Runs on capped collections, runs with non-CRUD ops,
+     * and runs with _id values whose equality may depend on a collation are never reordered.
+     */
+    static void groupInsertsWithinNamespace(std::vector<const OplogEntry*>* oplogEntryPointers);
+
     /**
      * Updates a CRUD op's hash and isForCappedCollection field if necessary.
      */
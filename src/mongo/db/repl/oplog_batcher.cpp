@@ -280,10 +280,13 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
             // Locks the oplog to check its max size, do this in the UninterruptibleLockGuard.
             batchLimits.bytes = getBatchLimitOplogBytes(opCtx.get(), storageInterface);
 
+            // The entries were parsed once by getNextApplierBatch() and share ownership of the
+            // buffered BSON, which itself still references the fetcher's network reply. Move them
+            // so that no entry is copied between the oplog buffer and the applier.
             auto oplogEntries =
                 fassertNoTrace(31004, getNextApplierBatch(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the batch, wait a bit for something to appear.
@@ -48,7 +48,9 @@ size_t getDocumentSize(const BSONObj& o) {
 
 OplogBufferBlockingQueue::OplogBufferBlockingQueue() : OplogBufferBlockingQueue(nullptr) {}
 OplogBufferBlockingQueue::OplogBufferBlockingQueue(Counters* counters)
-    : _counters(counters), _queue(kOplogBufferSize, &getDocumentSize) {}
+    : OplogBufferBlockingQueue(kOplogBufferSize, counters) {}
+OplogBufferBlockingQueue::OplogBufferBlockingQueue(std::size_t maxSize, Counters* counters)
+    : _counters(counters), _queue(maxSize, &getDocumentSize) {}
 
 void OplogBufferBlockingQueue::startup(OperationContext*) {
     // Update server status metric to reflect the current oplog buffer's max size.
@@ -84,7 +86,7 @@ bool OplogBufferBlockingQueue::isEmpty() const {
 }
 
 std::size_t OplogBufferBlockingQueue::getMaxSize() const {
-    return kOplogBufferSize;
+    return _queue.maxSize();
 }
 
 std::size_t OplogBufferBlockingQueue::getSize() const {
@@ -42,6 +42,7 @@ class OplogBufferBlockingQueue final : public OplogBuffer {
 public:
     OplogBufferBlockingQueue();
     explicit OplogBufferBlockingQueue(Counters* counters);
+    OplogBufferBlockingQueue(std::size_t maxSize, Counters* counters);
 
     void startup(OperationContext* opCtx) override;
     void shutdown(OperationContext* opCtx) override;
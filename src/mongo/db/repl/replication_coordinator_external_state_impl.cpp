@@ -219,7 +219,8 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
         return;
 
     invariant(replCoord);
-    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(
+        static_cast<std::size_t>(oplogBufferMaxSizeBytes), &bufferGauge);
 
     // No need to log OplogBuffer::startup because the blocking queue implementation
     // does not start any threads or access the storage layer.
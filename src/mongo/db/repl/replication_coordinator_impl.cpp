@@ -207,22 +207,44 @@ constexpr StringData kQuiesceModeShutdownMessage =
 
 }  // namespace
 
+ReplicationCoordinatorImpl::WaiterList::GroupKey
+ReplicationCoordinatorImpl::WaiterList::_makeGroupKey(
+    const boost::optional<WriteConcernOptions>& writeConcern) {
+    if (!writeConcern) {
+        return {};
+    }
+    return {writeConcern->wMode,
+            writeConcern->wNumNodes,
+            writeConcern->syncMode,
+            writeConcern->checkCondition};
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    auto& group = _waiters[_makeGroupKey(waiter->writeConcern)];
+    group.emplace(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    auto& group = _waiters[_makeGroupKey(wc)];
+    group.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto groupIt = _waiters.find(_makeGroupKey(waiter->writeConcern));
+    if (groupIt == _waiters.end()) {
+        return false;
+    }
+    auto& group = groupIt->second;
+    for (auto iter = group.begin(); iter != group.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            group.erase(iter);
+            if (group.empty()) {
+                _waiters.erase(groupIt);
+            }
             return true;
         }
     }
@@ -232,33 +254,62 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 template <typename Func>
 void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
                                                                boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
+    _setValueIf_inlock(std::forward<Func>(func), opTime, false /* stopAtFirstMiss */);
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIfMonotonic_inlock(
+    Func&& func, boost::optional<OpTime> opTime) {
+    _setValueIf_inlock(std::forward<Func>(func), opTime, true /* stopAtFirstMiss */);
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::_setValueIf_inlock(Func&& func,
+                                                                boost::optional<OpTime> opTime,
+                                                                bool stopAtFirstMiss) {
+    for (auto groupIt = _waiters.begin(); groupIt != _waiters.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (func(it->first, waiter)) {
+                    waiter->promise.emplaceValue();
+                    it = group.erase(it);
+                } else if (stopAtFirstMiss) {
+                    // Every later waiter in this group waits for a later opTime with the same
+                    // write concern, so none of them can be satisfied either.
+                    break;
+                } else {
+                    ++it;
+                }
+            } catch (const DBException& e) {
+                waiter->promise.setError(e.toStatus());
+                it = group.erase(it);
             }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
+        }
+        if (group.empty()) {
+            groupIt = _waiters.erase(groupIt);
+        } else {
+            ++groupIt;
         }
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.emplaceValue();
+        }
     }
     _waiters.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.setError(status);
+        }
     }
     _waiters.clear();
 }
@@ -4724,7 +4775,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // For a fixed write concern, whether replication is done only gets harder as the opTime grows,
+    // so each group of waiters can be scanned up to its first unsatisfied waiter.
+    _replicationWaiterList.setValueIfMonotonic_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
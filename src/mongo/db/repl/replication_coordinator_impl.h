@@ -31,6 +31,7 @@
 
 #include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -698,14 +699,33 @@ private:
         // condition in func.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        // Like setValueIf_inlock, but stops visiting a group of waiters with the same write
+        // concern at the first waiter for which func returns false. Only valid if func is
+        // monotonic in the opTime for a fixed write concern, i.e. if it does not hold for a waiter
+        // it does not hold for any waiter of the same group with a later opTime either.
+        template <typename Func>
+        void setValueIfMonotonic_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        // The parts of a write concern that decide whether a waiter is satisfied at a given
+        // opTime. Waiters without a write concern all share the default-constructed key.
+        using GroupKey = std::tuple<std::string,
+                                    int,
+                                    WriteConcernOptions::SyncMode,
+                                    WriteConcernOptions::CheckCondition>;
+        using WaiterMap = std::multimap<OpTime, SharedWaiterHandle>;
+
+        static GroupKey _makeGroupKey(const boost::optional<WriteConcernOptions>& writeConcern);
+
+        template <typename Func>
+        void _setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime, bool stopAtFirstMiss);
+
+        // Waiters grouped by write concern, each group sorted by OpTime.
+        std::map<GroupKey, WaiterMap> _waiters;
     };
 
     enum class HeartbeatState { kScheduled = 0, kSent = 1 };
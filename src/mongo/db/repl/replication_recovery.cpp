@@ -111,17 +111,19 @@ public:
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
-              "Applied {numOpsApplied} operations in {numBatches} batches. Last operation applied "
-              "with optime: {applyThroughOpTime}",
+              "Applied {numOpsApplied} operations in {numBatches} batches in {durationMillis}ms. "
+              "Last operation applied with optime: {applyThroughOpTime}",
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
+              "durationMillis"_attr = _timer.millis(),
               "applyThroughOpTime"_attr = applyThroughOpTime);
     }
 
 private:
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+    Timer _timer;
 };
 
 /**
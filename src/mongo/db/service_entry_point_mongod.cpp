@@ -51,6 +51,7 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_cannot_refresh_due_to_locks_held_exception.h"
 #include "mongo/s/stale_exception.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -123,8 +124,11 @@ public:
 
         auto waitForWriteConcernAndAppendStatus = [&]() {
             WriteConcernResult res;
+            Timer waitForWCTimer;
             auto waitForWCStatus =
                 mongo::waitForWriteConcern(opCtx, lastOpAfterRun, opCtx->getWriteConcern(), &res);
+            CurOp::get(opCtx)->debug().waitForWriteConcernDurationMillis =
+                Milliseconds(waitForWCTimer.millis());
 
             CommandHelpers::appendCommandWCStatus(commandResponseBuilder, waitForWCStatus, res);
         };
@@ -65,8 +65,9 @@ private:
     // The id of the session with which this object is associated
     const LogicalSessionId _sessionId;
 
-    // These fields are only safe to read or write while holding the SessionCatalog::_mutex. In
-    // practice, it is only used inside of the SessionCatalog itself.
+    // These fields are only safe to read or write while holding the mutex of the SessionCatalog
+    // partition which owns this session. In practice, it is only used inside of the SessionCatalog
+    // itself.
 
     // A pointer back to the currently running operation on this Session, or nullptr if there
     // is no operation currently running for the Session.
@@ -52,17 +52,21 @@ const auto operationSessionDecoration =
 }  // namespace
 
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        ObservableSession session(lg, entry.second->session);
-        invariant(!session.hasCurrentOperation());
-        invariant(!session._killed());
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        for (const auto& entry : partition.sessions) {
+            ObservableSession session(lg, entry.second->session);
+            invariant(!session.hasCurrentOperation());
+            invariant(!session._killed());
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    _sessions.clear();
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        partition.sessions.clear();
+    }
 }
 
 SessionCatalog* SessionCatalog::get(OperationContext* opCtx) {
@@ -87,10 +91,12 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSessionWithPare
         invariant(opCtx->getLogicalSessionId() == lsid);
     }
 
-    stdx::unique_lock<Latch> ul(_mutex);
+    // The parent session lives in the same partition as the child session.
+    auto& partition = _getPartition(lsid);
+    stdx::unique_lock<Latch> ul(partition.mutex);
 
-    auto parentSri = _getOrCreateSessionRuntimeInfo(ul, *getParentSessionId(lsid));
-    auto childSri = _getOrCreateSessionRuntimeInfo(ul, lsid);
+    auto parentSri = _getOrCreateSessionRuntimeInfo(ul, partition, *getParentSessionId(lsid));
+    auto childSri = _getOrCreateSessionRuntimeInfo(ul, partition, lsid);
 
     if (killToken) {
         invariant(ObservableSession(ul, childSri->session)._killed());
@@ -142,9 +148,10 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSessionWithoutP
         invariant(opCtx->getLogicalSessionId() == lsid);
     }
 
-    stdx::unique_lock<Latch> ul(_mutex);
+    auto& partition = _getPartition(lsid);
+    stdx::unique_lock<Latch> ul(partition.mutex);
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, lsid);
+    auto sri = _getOrCreateSessionRuntimeInfo(ul, partition, lsid);
     if (killToken) {
         invariant(ObservableSession(ul, sri->session)._killed());
     }
@@ -200,16 +207,17 @@ void SessionCatalog::scanSession(const LogicalSessionId& lsid,
     std::unique_ptr<SessionRuntimeInfo> sessionToReap;
 
     {
-        stdx::lock_guard<Latch> lg(_mutex);
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
+        auto& partition = _getPartition(lsid);
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        auto it = partition.sessions.find(lsid);
+        if (it != partition.sessions.end()) {
             auto& sri = it->second;
             ObservableSession osession(lg, sri->session);
             workerFn(osession);
 
             if (osession._shouldBeReaped(sri->numWaitingToCheckOut)) {
                 sessionToReap = std::move(sri);
-                _sessions.erase(it);
+                partition.sessions.erase(it);
             }
         }
     }
@@ -219,16 +227,16 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
                                   const ScanSessionsCallbackFn& workerFn) {
     std::vector<std::unique_ptr<SessionRuntimeInfo>> sessionsToReap;
 
-    {
-        stdx::lock_guard<Latch> lg(_mutex);
+    LOGV2_DEBUG(21976,
+                2,
+                "Scanning {sessionCount} sessions",
+                "Scanning sessions",
+                "sessionCount"_attr = size());
 
-        LOGV2_DEBUG(21976,
-                    2,
-                    "Scanning {sessionCount} sessions",
-                    "Scanning sessions",
-                    "sessionCount"_attr = _sessions.size());
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
 
-        for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end(); ++it) {
             if (matcher.match(it->first)) {
                 auto& sri = it->second;
                 ObservableSession osession(lg, sri->session);
@@ -237,7 +245,7 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
 
                 if (osession._shouldBeReaped(sri->numWaitingToCheckOut)) {
                     sessionsToReap.emplace_back(std::move(sri));
-                    _sessions.erase(it++);
+                    partition.sessions.erase(it++);
                 }
             }
         }
@@ -245,45 +253,55 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
 }
 
 SessionCatalog::KillToken SessionCatalog::killSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<Latch> lg(_mutex);
+    auto& partition = _getPartition(lsid);
+    stdx::lock_guard<Latch> lg(partition.mutex);
 
-    auto sri = _getSessionRuntimeInfo(lg, lsid);
+    auto sri = _getSessionRuntimeInfo(lg, partition, lsid);
     uassert(ErrorCodes::NoSuchSession, "Session not found", sri);
     return ObservableSession(lg, sri->session).kill();
 }
 
 size_t SessionCatalog::size() const {
-    stdx::lock_guard<Latch> lg(_mutex);
-    return _sessions.size();
+    size_t size = 0;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lg(partition.mutex);
+        size += partition.sessions.size();
+    }
+    return size;
+}
+
+SessionCatalog::Partition& SessionCatalog::_getPartition(const LogicalSessionId& lsid) {
+    return _partitions[LogicalSessionIdHash()(lsid) % kNumPartitions];
 }
 
 SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getSessionRuntimeInfo(
-    WithLock, const LogicalSessionId& lsid) {
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
+    WithLock, Partition& partition, const LogicalSessionId& lsid) {
+    auto it = partition.sessions.find(lsid);
+    if (it == partition.sessions.end()) {
         return nullptr;
     }
     return it->second.get();
 }
 
 SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock lk, const LogicalSessionId& lsid) {
-    if (auto sri = _getSessionRuntimeInfo(lk, lsid)) {
+    WithLock lk, Partition& partition, const LogicalSessionId& lsid) {
+    if (auto sri = _getSessionRuntimeInfo(lk, partition, lsid)) {
         return sri;
     }
 
-    auto it = _sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
+    auto it = partition.sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
     return it->second.get();
 }
 
 void SessionCatalog::_releaseSession(SessionRuntimeInfo* sri,
                                      SessionRuntimeInfo* parentSri,
                                      boost::optional<KillToken> killToken) {
-    stdx::lock_guard<Latch> lg(_mutex);
+    auto& partition = _getPartition(sri->session.getSessionId());
+    stdx::lock_guard<Latch> lg(partition.mutex);
 
     // Make sure we have exactly the same session on the map and that it is still associated with an
     // operation context (meaning checked-out)
-    invariant(_sessions[sri->session.getSessionId()].get() == sri);
+    invariant(partition.sessions[sri->session.getSessionId()].get() == sri);
     invariant(sri->session._checkoutOpCtx);
     if (killToken) {
         invariant(killToken->lsidToKill == sri->session.getSessionId());
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -43,6 +44,7 @@
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -130,7 +132,7 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
+        // Signaled when the state becomes available. Uses the owning partition's mutex to protect
         // the state transitions.
         stdx::condition_variable availableCondVar;
     };
@@ -153,16 +155,43 @@ private:
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Returns the session runtime info for 'lsid' from the '_sessions' map. The returned pointer
-     * is guaranteed to be linked on the map for as long as the mutex is held.
+     * The sessions are spread over several partitions, each with its own mutex, so that checking
+     * out unrelated sessions does not contend on a single mutex.
      */
-    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    struct Partition {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::Partition::mutex");
+
+        // Owns the Session objects for all current Sessions in this partition.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    static constexpr size_t kNumPartitions = 16;
+
+    /**
+     * Returns the partition which owns 'lsid'. Partitions are chosen by the session's id only, so
+     * a child session always lives in the same partition as its parent session and the two can be
+     * checked out together under that partition's mutex.
+     */
+    Partition& _getPartition(const LogicalSessionId& lsid);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The
-     * returned pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Returns the session runtime info for 'lsid' from the partition's map. The returned pointer
+     * is guaranteed to be linked on the map for as long as the partition's mutex is held.
      */
-    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk,
+                                               Partition& partition,
+                                               const LogicalSessionId& lsid);
+
+    /**
+     * Creates or returns the session runtime info for 'lsid' from the partition's map. The
+     * returned pointer is guaranteed to be linked on the map for as long as the partition's mutex
+     * is held.
+     */
+    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk,
+                                                       Partition& partition,
+                                                       const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
@@ -171,12 +200,7 @@ private:
                          SessionRuntimeInfo* parentSri,
                          boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
 };
 
 /**
@@ -397,6 +397,33 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessions) {
     lsidsFound.clear();
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsVisitsManySessions) {
+    // Create enough sessions for them to be spread over all of the catalog's partitions.
+    const size_t numSessions = 100;
+    LogicalSessionIdSet lsids;
+    for (size_t i = 0; i < numSessions; ++i) {
+        auto lsid = makeLogicalSessionIdForTest();
+        lsids.insert(lsid);
+        stdx::async(stdx::launch::async,
+                    [this, lsid] {
+                        ThreadClient tc(getServiceContext());
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    })
+            .get();
+    }
+    ASSERT_EQ(numSessions, catalog()->size());
+
+    LogicalSessionIdSet lsidsFound;
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+    catalog()->scanSessions(matcherAllSessions, [&](const ObservableSession& session) {
+        ASSERT(lsidsFound.insert(session.getSessionId()).second);
+    });
+    ASSERT(lsids == lsidsFound);
+}
+
 TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     // Create sessions in the catalog.
     const auto lsids = []() -> std::vector<LogicalSessionId> {
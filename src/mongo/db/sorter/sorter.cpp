@@ -1008,7 +1008,10 @@ void Sorter<Key, Value>::File::read(std::streamoff offset, std::streamsize size,
                 _file);
     }
 
-    _file.seekg(offset);
+    if (offset != _readOffset) {
+        _file.seekg(offset);
+    }
+    _readOffset = -1;
     _file.read(reinterpret_cast<char*>(out), size);
 
     uassert(16817,
@@ -1024,6 +1027,8 @@ void Sorter<Key, Value>::File::read(std::streamoff offset, std::streamsize size,
             str::stream() << "Error reading file " << _path.string() << ": "
                           << sorter::myErrnoWithDescription(),
             _file.tellg() >= 0);
+
+    _readOffset = offset + size;
 }
 
 template <typename Key, typename Value>
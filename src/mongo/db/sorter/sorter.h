@@ -302,6 +302,11 @@ public:
         // opened or is already being read.
         std::streamoff _offset = -1;
 
+        // The offset just past the most recent read, or -1 if the read position is unknown. A read
+        // that continues where the previous one ended skips the seek, which would otherwise
+        // discard the stream's read buffer.
+        std::streamoff _readOffset = -1;
+
         // Whether to keep the on-disk file even after this in-memory object has been destructed.
         bool _keep = false;
     };
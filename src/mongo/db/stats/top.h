@@ -153,9 +153,14 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
+    // Guards '_usage'.
     mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
     UsageMap _usage;
+
+    // Guards '_globalHistogramStats'. Kept separate from '_lock' since every operation records
+    // both its per-namespace usage and its global latency, and they should not contend.
+    mutable SimpleMutex _globalHistogramLock;
+    OperationLatencyHistogram _globalHistogramStats;
 };
 
 }  // namespace mongo
@@ -387,11 +387,12 @@ public:
     static Value deserialize(BufReader& buf, KeyString::Version version) {
         const int32_t sizeOfKeystring = buf.read<LittleEndian<int32_t>>();
         const void* keystringPtr = buf.skip(sizeOfKeystring);
+        auto typeBits = TypeBits::fromBuffer(version, &buf);  // advances the buf
 
-        BufBuilder newBuf;
+        // Size the buffer exactly rather than using the BufBuilder default. The Sorter calls this
+        // once per spilled key, so over-allocating would cost an oversized allocation per key.
+        BufBuilder newBuf(sizeOfKeystring + typeBits.getSize());
         newBuf.appendBuf(keystringPtr, sizeOfKeystring);
-
-        auto typeBits = TypeBits::fromBuffer(version, &buf);  // advances the buf
         if (typeBits.isAllZeros()) {
             newBuf.appendChar(0);
         } else {
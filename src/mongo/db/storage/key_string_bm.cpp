@@ -207,6 +207,42 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+// Compares adjacent keys of a compound index whose leading components are shared by all keys, as
+// in a range scan over {tenantId, region, ts}, and each key against the end of the range.
+void BM_KeyStringCompareSharedPrefix(benchmark::State& state, size_t tenantIdLen) {
+    const auto version = KeyString::Version::V1;
+    const std::string tenantId(tenantIdLen, 't');
+
+    auto makeKey = [&](int ts) {
+        return BSON("" << tenantId << ""
+                       << "us-east-1"
+                       << "" << ts);
+    };
+
+    std::vector<KeyString::Value> keys;
+    for (int i = 0; i < kSampleSize; i++) {
+        KeyString::HeapBuilder builder(version, makeKey(i), ALL_ASCENDING);
+        keys.emplace_back(builder.release());
+    }
+    KeyString::HeapBuilder endBuilder(
+        version, makeKey(kSampleSize), ALL_ASCENDING, KeyString::Discriminator::kExclusiveAfter);
+    const KeyString::Value end = endBuilder.release();
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < kSampleSize; i++) {
+            benchmark::DoNotOptimize(keys[i - 1].compare(keys[i]));
+            benchmark::DoNotOptimize(keys[i].compare(end));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * (kSampleSize - 1) * 2 * keys[0].getSize());
+    state.SetItemsProcessed(state.iterations() * (kSampleSize - 1) * 2);
+}
+
+BENCHMARK_CAPTURE(BM_KeyStringCompareSharedPrefix, Prefix8, 8);
+BENCHMARK_CAPTURE(BM_KeyStringCompareSharedPrefix, Prefix64, 64);
+BENCHMARK_CAPTURE(BM_KeyStringCompareSharedPrefix, Prefix256, 256);
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
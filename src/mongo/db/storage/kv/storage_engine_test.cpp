@@ -48,10 +48,12 @@
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine_impl.h"
 #include "mongo/db/storage/storage_engine_test_fixture.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -112,6 +114,33 @@ TEST_F(StorageEngineTest, LoadCatalogDropsOrphansAfterUncleanShutdown) {
     ASSERT(!collectionExists(opCtx.get(), collNs));
 }
 
+TEST_F(StorageEngineTest, LoadCatalogOpensRecordStoresConcurrently) {
+    auto opCtx = cc().makeOperationContext();
+
+    std::vector<NamespaceString> namespaces;
+    for (int i = 0; i < 20; i++) {
+        namespaces.emplace_back("db.coll" + std::to_string(i));
+        ASSERT_OK(createCollection(opCtx.get(), namespaces.back()).getStatus());
+    }
+
+    const auto oldMaxCatalogLoadThreads = gMaxCatalogLoadThreads;
+    gMaxCatalogLoadThreads = 4;
+    ON_BLOCK_EXIT([&] { gMaxCatalogLoadThreads = oldMaxCatalogLoadThreads; });
+    {
+        Lock::GlobalWrite writeLock(opCtx.get(), Date_t::max(), Lock::InterruptBehavior::kThrow);
+        _storageEngine->closeCatalog(opCtx.get());
+        _storageEngine->loadCatalog(opCtx.get(), StorageEngine::LastShutdownState::kClean);
+    }
+
+    for (const auto& nss : namespaces) {
+        auto coll =
+            CollectionCatalog::get(opCtx.get())->lookupCollectionByNamespace(opCtx.get(), nss);
+        ASSERT(coll);
+        ASSERT(coll->getRecordStore());
+        ASSERT_EQ(coll->getRecordStore()->ns(), nss.ns());
+    }
+}
+
 TEST_F(StorageEngineTest, ReconcileDropsTemporary) {
     auto opCtx = cc().makeOperationContext();
 
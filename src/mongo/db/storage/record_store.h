@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -49,6 +50,7 @@ class MAdvise;
 class OperationContext;
 
 class RecordStore;
+class RecordStoreBulkBuilderInterface;
 
 struct ValidateResults;
 class ValidateAdaptor;
@@ -372,6 +374,20 @@ public:
         return inOutRecords.front().id;
     }
 
+    /**
+     * Returns a bulk builder which appends records to this empty RecordStore, or nullptr if the
+     * RecordStore cannot currently be bulk loaded. Records appended through the builder bypass the
+     * usual transactional insert path: they are not rolled back with a WriteUnitOfWork and must not
+     * be read until the builder is committed. No other operation may use this RecordStore while the
+     * builder exists.
+     *
+     * Implementations can assume that 'this' RecordStore outlives its bulk builder.
+     */
+    virtual std::unique_ptr<RecordStoreBulkBuilderInterface> makeBulkBuilder(
+        OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Updates the record with id 'recordId', replacing its contents with those described by
      * 'data' and 'len'.
@@ -586,4 +602,25 @@ protected:
     std::string _ns;
 };
 
+/**
+ * Appends records to an empty RecordStore in RecordId order. See RecordStore::makeBulkBuilder().
+ */
+class RecordStoreBulkBuilderInterface {
+public:
+    virtual ~RecordStoreBulkBuilderInterface() {}
+
+    /**
+     * Appends a copy of the record described by 'data' and 'len', and returns its generated
+     * RecordId.
+     */
+    virtual StatusWith<RecordId> addRecord(const char* data, int len) = 0;
+
+    /**
+     * Makes the appended records visible and accounts for them in the size of the RecordStore. Must
+     * be called in a WriteUnitOfWork, and at most once. Records which are not committed may or may
+     * not be present once the builder is destroyed, so the RecordStore should then be dropped.
+     */
+    virtual void commit() = 0;
+};
+
 }  // namespace mongo
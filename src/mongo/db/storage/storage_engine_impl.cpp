@@ -47,10 +47,12 @@
 #include "mongo/db/storage/durable_history_pin.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
@@ -235,6 +237,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         }
     }
 
+    std::vector<DurableCatalog::Entry> entriesToLoad;
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -273,6 +276,20 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
             }
         }
 
+        entriesToLoad.push_back(std::move(entry));
+    }
+
+    // Opening a record store reads its table's metadata from the storage engine, which dominates
+    // loading the catalog when there are very many collections, so do it concurrently if allowed.
+    std::vector<std::unique_ptr<RecordStore>> recordStores(entriesToLoad.size());
+    const size_t numThreads = std::min(size_t(gMaxCatalogLoadThreads), entriesToLoad.size());
+    if (!_options.forRepair && numThreads > 1) {
+        recordStores = _openRecordStoresConcurrently(opCtx, entriesToLoad, numThreads);
+    }
+
+    for (size_t i = 0; i < entriesToLoad.size(); i++) {
+        const auto& entry = entriesToLoad[i];
+
         Timestamp minVisibleTs = Timestamp::min();
         // If there's no recovery timestamp, every collection is available.
         if (boost::optional<Timestamp> recoveryTs = _engine->getRecoveryTimestamp()) {
@@ -289,7 +306,12 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        _initCollection(opCtx,
+                        entry.catalogId,
+                        entry.nss,
+                        _options.forRepair,
+                        minVisibleTs,
+                        std::move(recordStores[i]));
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248, "Orphaned collection found", "namespace"_attr = entry.nss);
@@ -299,11 +321,62 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
     opCtx->recoveryUnit()->abandonSnapshot();
 }
 
+std::vector<std::unique_ptr<RecordStore>> StorageEngineImpl::_openRecordStoresConcurrently(
+    OperationContext* opCtx, const std::vector<DurableCatalog::Entry>& entries, size_t numThreads) {
+    LOGV2(6102000,
+          "Opening collection record stores concurrently",
+          "numCollections"_attr = entries.size(),
+          "numThreads"_attr = numThreads);
+
+    std::vector<std::unique_ptr<RecordStore>> recordStores(entries.size());
+    std::vector<Status> statuses(numThreads, Status::OK());
+    AtomicWord<size_t> nextEntry{0};
+
+    auto openRecordStores = [&](size_t thread) {
+        // The caller holds the global lock exclusively for the duration, so these operations
+        // cannot take any locks themselves, nor do they need to.
+        ThreadClient tc("CatalogLoader", opCtx->getServiceContext());
+        auto threadOpCtx = tc->makeOperationContext();
+        try {
+            for (size_t i = nextEntry.fetchAndAdd(1); i < entries.size();
+                 i = nextEntry.fetchAndAdd(1)) {
+                const auto& entry = entries[i];
+                // The oplog's record store starts background work of its own, leave it to the
+                // caller.
+                if (entry.nss.isOplog()) {
+                    continue;
+                }
+
+                auto md = _catalog->getMetaData(threadOpCtx.get(), entry.catalogId);
+                recordStores[i] = _engine->getRecordStore(
+                    threadOpCtx.get(), entry.nss.ns(), entry.ident, md->options);
+                invariant(recordStores[i]);
+            }
+        } catch (const DBException& ex) {
+            statuses[thread] = ex.toStatus();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t thread = 0; thread < numThreads; thread++) {
+        threads.emplace_back([&openRecordStores, thread] { openRecordStores(thread); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& status : statuses) {
+        uassertStatusOK(status);
+    }
+    return recordStores;
+}
+
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
                                         bool forRepair,
-                                        Timestamp minVisibleTs) {
+                                        Timestamp minVisibleTs,
+                                        std::unique_ptr<RecordStore> rs) {
     auto md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -311,12 +384,11 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
 
     auto ident = _catalog->getEntry(catalogId).ident;
 
-    std::unique_ptr<RecordStore> rs;
     if (forRepair) {
         // Using a NULL rs since we don't want to open this record store before it has been
         // repaired. This also ensures that if we try to use it, it will blow up.
-        rs = nullptr;
-    } else {
+        invariant(!rs);
+    } else if (!rs) {
         rs = _engine->getRecordStore(opCtx, nss.ns(), ident, md->options);
         invariant(rs);
     }
@@ -361,11 +361,26 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
+    /**
+     * Instantiates the collection for the durable catalog entry 'catalogId' and registers it with
+     * the CollectionCatalog. Uses 'rs' as its record store if provided, otherwise opens it unless
+     * 'forRepair' is set.
+     */
     void _initCollection(OperationContext* opCtx,
                          RecordId catalogId,
                          const NamespaceString& nss,
                          bool forRepair,
-                         Timestamp minVisibleTs);
+                         Timestamp minVisibleTs,
+                         std::unique_ptr<RecordStore> rs = nullptr);
+
+    /**
+     * Opens the record stores of the non-oplog collections in 'entries' on up to 'numThreads'
+     * threads. Returns them in the same order as 'entries', leaving the oplog's slot empty.
+     */
+    std::vector<std::unique_ptr<RecordStore>> _openRecordStoresConcurrently(
+        OperationContext* opCtx,
+        const std::vector<DurableCatalog::Entry>& entries,
+        size_t numThreads);
 
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx, const std::vector<UUID>& toDrop);
 
@@ -244,6 +244,68 @@ private:
     stdx::condition_variable _condvar;
 };
 
+class WiredTigerKVEngine::WiredTigerSizeStorerFlusher : public BackgroundJob {
+public:
+    explicit WiredTigerSizeStorerFlusher(WiredTigerKVEngine* engine)
+        : BackgroundJob(false /* deleteSelf */), _engine(engine) {}
+
+    virtual string name() const {
+        return "WTSizeStorerFlusher";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6101400, 1, "starting {name} thread", "name"_attr = name());
+
+        while (true) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::seconds(60), [&] {
+                    return _flushRequested || _shuttingDown;
+                });
+                if (_shuttingDown)
+                    break;
+                _flushRequested = false;
+            }
+
+            stdx::lock_guard<Latch> sizeStorerLock(_engine->_sizeStorerMutex);
+            _engine->syncSizeInfo(false);
+        }
+        LOGV2_DEBUG(6101401, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    /**
+     * Wakes up the flusher thread to write back the buffered size information, without waiting
+     * for it to be written.
+     */
+    void requestFlush() {
+        stdx::lock_guard<Latch> lock(_mutex);
+        _flushRequested = true;
+        _condvar.notify_one();
+    }
+
+    void shutdown() {
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            _shuttingDown = true;
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    WiredTigerKVEngine* _engine;
+
+    // Protects _flushRequested and _shuttingDown.
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerSizeStorerFlusher::_mutex");
+    // The flusher thread idles on this condition variable until a flush is requested, or at most a
+    // minute, so that size information is periodically written back even on an idle server.
+    stdx::condition_variable _condvar;
+    bool _flushRequested = false;
+    bool _shuttingDown = false;
+};
+
 std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult& r) {
     if (r.isOK()) {
         if (r.getValue()) {
@@ -516,6 +578,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    if (!_ephemeral) {
+        _readAhead = std::make_unique<WiredTigerReadAhead>(_sessionCache.get(),
+                                                           gWiredTigerReadAheadThreads);
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -574,6 +641,24 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     }
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
+    if (!_readOnly) {
+        _sizeStorerFlusher = std::make_unique<WiredTigerSizeStorerFlusher>(this);
+        _sizeStorerFlusher->go();
+    }
+
+    {
+        std::string oplogStonesUri = _uri("oplogStones");
+        WT_SESSION* s = session.getSession();
+        if (!_readOnly) {
+            std::string config = WiredTigerCustomizationHooks::get(getGlobalServiceContext())
+                                     ->getTableCreateConfig(oplogStonesUri);
+            invariantWTOK(s->create(s, oplogStonesUri.c_str(), config.c_str()));
+        }
+        // A read-only node may be running on a data directory that predates the table.
+        if (_hasUri(s, oplogStonesUri)) {
+            _oplogStonesUri = std::move(oplogStonesUri);
+        }
+    }
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
@@ -710,6 +795,14 @@ void WiredTigerKVEngine::cleanShutdown() {
     LOGV2(22317, "WiredTigerKVEngine shutting down");
     WiredTigerUtil::resetTableLoggingInfo();
 
+    if (_sizeStorerFlusher) {
+        LOGV2(6101402, "Shutting down size storer flusher thread");
+        _sizeStorerFlusher->shutdown();
+        LOGV2(6101403, "Finished shutting down size storer flusher thread");
+    }
+    if (_readAhead) {
+        _readAhead->shutdown();
+    }
     if (!_readOnly)
         syncSizeInfo(true);
     if (!_conn) {
@@ -1708,36 +1801,30 @@ void WiredTigerKVEngine::dropIdentForImport(OperationContext* opCtx, StringData
     invariantWTOK(ret);
 }
 
-std::list<WiredTigerCachedCursor> WiredTigerKVEngine::filterCursorsWithQueuedDrops(
-    std::list<WiredTigerCachedCursor>* cache) {
-    std::list<WiredTigerCachedCursor> toDrop;
-
+std::vector<WiredTigerCachedCursor> WiredTigerKVEngine::filterCursorsWithQueuedDrops(
+    WiredTigerCursorCache* cache) {
     stdx::lock_guard<Latch> lk(_identToDropMutex);
     if (_identToDrop.empty())
-        return toDrop;
-
-    for (auto i = cache->begin(); i != cache->end();) {
-        if (!i->_cursor ||
-            std::find_if(_identToDrop.begin(), _identToDrop.end(), [i](const auto& identToDrop) {
-                return identToDrop.uri == std::string(i->_cursor->uri);
-            }) == _identToDrop.end()) {
-            ++i;
-            continue;
-        }
-        toDrop.push_back(*i);
-        i = cache->erase(i);
-    }
+        return {};
 
-    return toDrop;
+    return cache->removeIf([&](const WiredTigerCachedCursor& cached) {
+        return std::find_if(_identToDrop.begin(),
+                            _identToDrop.end(),
+                            [&](const auto& identToDrop) {
+                                return identToDrop.uri == std::string(cached._cursor->uri);
+                            }) != _identToDrop.end();
+    });
 }
 
 bool WiredTigerKVEngine::haveDropsQueued() const {
     Date_t now = _clockSource->now();
     Milliseconds delta = now - Date_t::fromMillisSinceEpoch(_previousCheckedDropsQueued.load());
 
+    // This runs when sessions are released, so leave the write-back to the flusher thread instead
+    // of stalling the releasing operation.
     if (!_readOnly && _sizeStorerSyncTracker.intervalHasElapsed()) {
         _sizeStorerSyncTracker.resetLastTime();
-        syncSizeInfo(false);
+        _sizeStorerFlusher->requestFlush();
     }
 
     // We only want to check the queue max once per second or we'll thrash
@@ -1910,7 +1997,7 @@ std::vector<std::string> WiredTigerKVEngine::getAllIdents(OperationContext* opCt
             continue;
 
         StringData ident = key.substr(idx + 1);
-        if (ident == "sizeStorer")
+        if (ident == "sizeStorer" || ident == "oplogStones")
             continue;
 
         all.push_back(ident.toString());
@@ -2211,6 +2298,11 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
                           << ", Stable timestamp: " << stableTS.toString());
     }
 
+    // The size storer flusher must not write back size information while WiredTiger rolls back,
+    // as rollback_to_stable fails with EBUSY while a transaction is active. Holding the mutex also
+    // keeps the flusher away until the size storer has been re-created.
+    stdx::lock_guard<Latch> sizeStorerLock(_sizeStorerMutex);
+
     LOGV2_FOR_ROLLBACK(
         23989, 2, "WiredTiger::RecoverToStableTimestamp syncing size storer to disk.");
     syncSizeInfo(true);
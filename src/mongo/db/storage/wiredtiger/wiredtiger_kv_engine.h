@@ -43,6 +43,7 @@
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/platform/mutex.h"
@@ -265,9 +266,25 @@ public:
     WT_CONNECTION* getConnection() {
         return _conn;
     }
+
+    /**
+     * Returns the URI of the table persisting the oplog truncation points across restarts, or an
+     * empty string if there is no such table.
+     */
+    const std::string& getOplogStonesUri() const {
+        return _oplogStonesUri;
+    }
+
+    /**
+     * Returns the cache read-ahead service used by forward collection scans, or nullptr for
+     * in-memory engines.
+     */
+    WiredTigerReadAhead* getReadAhead() const {
+        return _readAhead.get();
+    }
     void dropSomeQueuedIdents();
-    std::list<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
-        std::list<WiredTigerCachedCursor>* cache);
+    std::vector<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
+        WiredTigerCursorCache* cache);
     bool haveDropsQueued() const;
 
     void syncSizeInfo(bool sync) const;
@@ -362,6 +379,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerSizeStorerFlusher;
 
     struct IdentToDrop {
         std::string uri;
@@ -438,8 +456,11 @@ private:
     std::string _path;
     std::string _wtOpenConfig;
 
+    // Prevents the size storer flusher thread from using _sizeStorer while it is being replaced.
+    Mutex _sizeStorerMutex = MONGO_MAKE_LATCH("WiredTigerKVEngine::_sizeStorerMutex");
     std::unique_ptr<WiredTigerSizeStorer> _sizeStorer;
     std::string _sizeStorerUri;
+    std::string _oplogStonesUri;
     mutable ElapsedTracker _sizeStorerSyncTracker;
 
     bool _durable;
@@ -455,6 +476,10 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    // Writes back the size storer buffer on behalf of threads that notice it is due for a sync.
+    std::unique_ptr<WiredTigerSizeStorerFlusher> _sizeStorerFlusher;
+    // Warms the cache ahead of forward collection scans. Shut down before the session cache.
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;
 
     std::string _rsOptions;
     std::string _indexOptions;
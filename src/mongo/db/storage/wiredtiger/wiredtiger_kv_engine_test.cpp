@@ -47,10 +47,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/fail_point.h"
 
 namespace mongo {
 namespace {
@@ -396,6 +398,53 @@ TEST_F(WiredTigerKVEngineTest, IdentDrop) {
     ASSERT(boost::filesystem::exists(renamedFilePath));
 }
 
+TEST_F(WiredTigerKVEngineTest, RecoverToStableTimestampWaitsForSizeStorerFlusher) {
+    NamespaceString nss("a.b");
+    std::string ident = "collection-1234";
+    CollectionOptions defaultCollectionOptions;
+    std::unique_ptr<RecordStore> rs;
+    {
+        auto opCtxPtr = _makeOperationContext();
+        ASSERT_OK(
+            _engine->createRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions));
+        rs = _engine->getRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions);
+        ASSERT(rs);
+
+        // Take a stable checkpoint to roll back to.
+        _engine->setInitialDataTimestamp(Timestamp(1, 1));
+        _engine->setStableTimestamp(Timestamp(1, 1), false);
+        _engine->flushAllFiles(opCtxPtr.get(), false);
+
+        // Buffer size information for the flusher thread to write back.
+        rs->updateStatsAfterRepair(opCtxPtr.get(), 1, 4);
+    }
+
+    // Pause the flusher thread with its write-back transaction open. The flusher is woken by the
+    // checks for queued drops, which request a flush every so often.
+    auto fp = globalFailPointRegistry().find("WTPauseSizeStorerFlush");
+    auto timesEntered = fp->setMode(FailPoint::alwaysOn);
+    AtomicWord<bool> flusherPaused{false};
+    stdx::thread requester([&] {
+        while (!flusherPaused.load()) {
+            _engine->haveDropsQueued();
+        }
+    });
+    fp->waitForTimesEntered(timesEntered + 1);
+    flusherPaused.store(true);
+    requester.join();
+
+    // Rolling back must wait for the flusher rather than fail while its transaction is active.
+    stdx::thread releaser([&] {
+        sleepmillis(100);
+        fp->setMode(FailPoint::off);
+    });
+    auto opCtxPtr = _makeOperationContext();
+    auto swTimestamp = _engine->recoverToStableTimestamp(opCtxPtr.get());
+    releaser.join();
+    ASSERT_OK(swTimestamp);
+    ASSERT_EQ(swTimestamp.getValue(), Timestamp(1, 1));
+}
+
 TEST_F(WiredTigerKVEngineTest, TestBasicPinOldestTimestamp) {
     auto opCtxRaii = _makeOperationContext();
     const Timestamp initTs = Timestamp(1, 0);
@@ -145,9 +145,11 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
 
     // Prevent any scheduled oplog visibility updates from being delayed for batching and blocking
-    // this wait excessively.
+    // this wait excessively. Wake the visibility thread so that an update already being delayed
+    // sees this waiter now rather than at its next one millisecond check.
     ++_opsWaitingForOplogVisibilityUpdate;
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
+    _oplogVisibilityThreadCV.notify_one();
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
 
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include <algorithm>
+
+#include <wiredtiger.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+// The number of records a new cursor's first read-ahead request walks.
+constexpr long long kInitialDepth = 64;
+
+ThreadPool::Options makeThreadPoolOptions(size_t numThreads) {
+    ThreadPool::Options options;
+    options.poolName = "WTReadAhead";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    return options;
+}
+
+}  // namespace
+
+WiredTigerReadAhead::WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, size_t numThreads)
+    : _sessionCache(sessionCache), _pool(makeThreadPoolOptions(numThreads)) {
+    _pool.startup();
+}
+
+WiredTigerReadAhead::~WiredTigerReadAhead() {
+    shutdown();
+}
+
+std::shared_ptr<WiredTigerReadAhead::Window> WiredTigerReadAhead::makeWindow() const {
+    const long long maxDepth = gWiredTigerReadAheadMaxRecords.load();
+    if (maxDepth <= 0 || _shuttingDown.load()) {
+        return nullptr;
+    }
+
+    auto window = std::make_shared<Window>();
+    window->depth = std::min(kInitialDepth, maxDepth);
+    return window;
+}
+
+void WiredTigerReadAhead::onRecordReturned(const std::shared_ptr<Window>& window,
+                                           const std::string& uri,
+                                           long long id) {
+    if (++window->recordsSinceRequest < window->depth / 2) {
+        return;
+    }
+
+    const long long maxDepth = gWiredTigerReadAheadMaxRecords.load();
+    if (maxDepth <= 0 || _shuttingDown.load()) {
+        return;
+    }
+
+    if (window->inFlight.load()) {
+        if (!window->grewForRequest) {
+            window->depth = std::min(window->depth * 2, maxDepth);
+            window->grewForRequest = true;
+        }
+        return;
+    }
+
+    window->recordsSinceRequest = 0;
+    window->grewForRequest = false;
+    window->depth = std::min(window->depth, maxDepth);
+    window->inFlight.store(true);
+
+    // Resume where the previous request stopped, unless the scan has already moved past it.
+    const long long start = std::max(id, window->readThrough.load());
+    const long long depth = window->depth;
+    std::weak_ptr<Window> weakWindow = window;
+    _pool.schedule([this, weakWindow, uri, start, depth](Status status) {
+        auto window = weakWindow.lock();
+        if (!window) {
+            return;
+        }
+        ON_BLOCK_EXIT([&] { window->inFlight.store(false); });
+
+        if (!status.isOK() || _shuttingDown.load()) {
+            return;
+        }
+
+        try {
+            _readAhead(window.get(), uri, start, depth);
+        } catch (const DBException& ex) {
+            // Read-ahead is best-effort, e.g. the collection may have been dropped under us.
+            LOGV2_DEBUG(6101800,
+                        2,
+                        "WiredTiger read-ahead request failed",
+                        "uri"_attr = uri,
+                        "error"_attr = ex.toStatus());
+        }
+    });
+}
+
+void WiredTigerReadAhead::_readAhead(Window* window,
+                                     const std::string& uri,
+                                     long long start,
+                                     long long depth) {
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    // Nothing read here is returned to a caller, so there is no need to pay for a snapshot.
+    if (s->begin_transaction(s, "isolation=read-uncommitted") != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { s->rollback_transaction(s, nullptr); });
+
+    // Use an uncached cursor so that idle sessions in the session cache do not keep the table open
+    // and hold up drops.
+    WT_CURSOR* c = session->getNewCursor(uri);
+    ON_BLOCK_EXIT([&] { session->closeCursor(c); });
+
+    c->set_key(c, static_cast<int64_t>(start));
+    int cmp;
+    int ret = c->search_near(c, &cmp);
+    if (ret == 0 && cmp < 0) {
+        ret = c->next(c);
+    }
+
+    int64_t lastKey = start;
+    for (long long i = 0; ret == 0 && i < depth && !_shuttingDown.load(); ++i) {
+        // Fetching the value also brings in overflow items, not just the leaf page.
+        WT_ITEM value;
+        if (c->get_value(c, &value) != 0 || c->get_key(c, &lastKey) != 0) {
+            break;
+        }
+        ret = c->next(c);
+    }
+
+    window->readThrough.store(lastKey);
+}
+
+void WiredTigerReadAhead::shutdown() {
+    if (_shuttingDown.swap(true)) {
+        return;
+    }
+    _pool.shutdown();
+    _pool.join();
+}
+
+}  // namespace mongo
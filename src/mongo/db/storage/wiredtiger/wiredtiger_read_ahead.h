@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class WiredTigerSessionCache;
+
+/**
+ * Warms the WiredTiger cache ahead of forward collection scans. As a scan advances, its cursor
+ * periodically hands the prefetcher the RecordId it has reached, and a small pool of worker
+ * threads walks the records that follow on their own sessions. The pages are then already
+ * resident, or at least already being read, by the time the scan gets to them, so cold scans keep
+ * several reads outstanding instead of stalling on one page at a time.
+ *
+ * Read-ahead is only a cache hint: failures on the worker threads are ignored, and nothing read
+ * there is ever returned to a caller. It is disabled unless 'wiredTigerReadAheadMaxRecords' is
+ * positive.
+ */
+class WiredTigerReadAhead {
+public:
+    /**
+     * Per-cursor read-ahead progress. The owning cursor updates the non-atomic members from its
+     * own thread; the worker threads only hold a weak reference, so requests that complete after
+     * the cursor is gone are dropped.
+     */
+    struct Window {
+        // Set while a read-ahead request for this cursor is scheduled or running.
+        AtomicWord<bool> inFlight{false};
+        // The last RecordId reached by a completed read-ahead request.
+        AtomicWord<long long> readThrough{0};
+
+        // Number of records each read-ahead request walks.
+        long long depth = 0;
+        // Records returned by the cursor since the last request was scheduled.
+        long long recordsSinceRequest = 0;
+        // Whether 'depth' was already grown while waiting on the outstanding request.
+        bool grewForRequest = false;
+    };
+
+    WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, size_t numThreads);
+    ~WiredTigerReadAhead();
+
+    /**
+     * Returns a window for a new forward cursor, or nullptr if read-ahead is disabled.
+     */
+    std::shared_ptr<Window> makeWindow() const;
+
+    /**
+     * Called by the cursor owning 'window' each time it returns the record 'id' from the table
+     * 'uri'. Schedules the next read-ahead request once the cursor has consumed half of the
+     * previous one. If the previous request is still outstanding at that point, the scan is
+     * outpacing the device, so the window is doubled, up to 'wiredTigerReadAheadMaxRecords'.
+     */
+    void onRecordReturned(const std::shared_ptr<Window>& window,
+                          const std::string& uri,
+                          long long id);
+
+    /**
+     * Stops accepting requests and waits for the outstanding ones. Must be called before the
+     * session cache is shut down.
+     */
+    void shutdown();
+
+private:
+    void _readAhead(Window* window, const std::string& uri, long long start, long long depth);
+
+    WiredTigerSessionCache* const _sessionCache;
+    ThreadPool _pool;
+    AtomicWord<bool> _shuttingDown{false};
+};
+
+}  // namespace mongo
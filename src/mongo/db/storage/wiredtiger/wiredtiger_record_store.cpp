@@ -107,6 +107,9 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+// Format version of the oplog stones persisted in the side table.
+const int kPersistedOplogStonesVersion = 1;
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
@@ -186,6 +189,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_stonesNeedPersisting = true;
     }
 
     void rollback() final {}
@@ -195,7 +199,7 @@ private:
 };
 
 WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTigerRecordStore* rs)
-    : _rs(rs) {
+    : _rs(rs), _persistedStonesTableId(WiredTigerSession::genTableId()) {
     stdx::lock_guard<Latch> reclaimLk(_oplogReclaimMutex);
     stdx::lock_guard<Latch> lk(_mutex);
 
@@ -240,6 +244,10 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<Latch> lk(_mutex);
+            if (_stonesNeedPersisting) {
+                break;
+            }
+
             if (hasExcessStones_inlock()) {
                 // There are now excess oplog stones. However, there it may be necessary to keep
                 // additional oplog.
@@ -264,7 +272,13 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
                 }
             }
         }
-        _oplogReclaimCv.wait(lock);
+
+        if (gOplogTruncationMaxRetentionHours.load() > 0.0) {
+            // Stones become expired without any insert poking this thread, so check periodically.
+            _oplogReclaimCv.wait_for(lock, stdx::chrono::minutes(1));
+        } else {
+            _oplogReclaimCv.wait(lock);
+        }
     }
 }
 
@@ -274,8 +288,9 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
         totalBytes += stone.bytes;
     }
 
-    // check that oplog stones is at capacity
-    if (totalBytes <= *_rs->_oplogMaxSize) {
+    // check that oplog stones is at capacity, or that the oldest stone is past the maximum
+    // retention
+    if (totalBytes <= *_rs->_oplogMaxSize && !_hasExpiredStone_inlock()) {
         return false;
     }
 
@@ -295,6 +310,16 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
     return currRetentionHours >= minRetentionHours;
 }
 
+bool WiredTigerRecordStore::OplogStones::_hasExpiredStone_inlock() const {
+    double maxRetentionHours = gOplogTruncationMaxRetentionHours.load();
+    if (maxRetentionHours == 0.0 || _stones.empty()) {
+        return false;
+    }
+
+    auto currRetentionMS = durationCount<Milliseconds>(Date_t::now() - _stones.front().wallTime);
+    return currRetentionMS / kNumMSInHour >= maxRetentionHours;
+}
+
 boost::optional<WiredTigerRecordStore::OplogStones::Stone>
 WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
     stdx::lock_guard<Latch> lk(_mutex);
@@ -309,6 +334,7 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stones.pop_front();
+    _stonesNeedPersisting = true;
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -350,6 +376,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _stonesNeedPersisting = true;
 
     LOGV2_DEBUG(22381,
                 2,
@@ -396,6 +423,9 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    if (numStonesToRemove > 0) {
+        _stonesNeedPersisting = true;
+    }
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -442,6 +472,13 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_loadPersistedStones(opCtx, numRecords, dataSize)) {
+        return;
+    }
+
+    // Persist the recalculated stones so the next startup doesn't need to recalculate them.
+    _stonesNeedPersisting = true;
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -614,8 +651,137 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx,
+                                                              long long numRecords,
+                                                              long long dataSize) {
+    const auto& uri = _rs->_kvEngine->getOplogStonesUri();
+    if (uri.empty() || numRecords < 0 || dataSize < 0) {
+        return false;
+    }
+
+    BSONObj data;
+    {
+        WiredTigerCursor cursor(uri, _persistedStonesTableId, false, opCtx);
+        WiredTigerItem key(_rs->_uri.c_str(), _rs->_uri.size());
+        cursor->set_key(cursor.get(), key.Get());
+        int ret =
+            wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->search(cursor.get()); });
+        if (ret == WT_NOTFOUND) {
+            return false;
+        }
+        invariantWTOK(ret);
+
+        WT_ITEM value;
+        invariantWTOK(cursor->get_value(cursor.get(), &value));
+        data = BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
+    }
+
+    if (data["version"].numberInt() != kPersistedOplogStonesVersion ||
+        data["stones"].type() != Array) {
+        return false;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    for (auto&& elem : data["stones"].Obj()) {
+        BSONObj stone = elem.Obj();
+        stones.emplace_back(stone["records"].safeNumberLong(),
+                            stone["bytes"].safeNumberLong(),
+                            RecordId(stone["lastRecord"].safeNumberLong()),
+                            stone["wallTime"].date());
+    }
+
+    // The stones are persisted separately from the truncations and inserts that change them, so
+    // discard the ones that no longer fall within the oplog after an unclean shutdown.
+    auto earliest = _rs->getCursor(opCtx, /*forward=*/true)->next();
+    auto latest = _rs->getCursor(opCtx, /*forward=*/false)->next();
+    if (!earliest || !latest) {
+        return false;
+    }
+    while (!stones.empty() && stones.front().lastRecord < earliest->id) {
+        stones.pop_front();
+    }
+    while (!stones.empty() && stones.back().lastRecord > latest->id) {
+        stones.pop_back();
+    }
+
+    int64_t stoneRecords = 0;
+    int64_t stoneBytes = 0;
+    for (auto&& stone : stones) {
+        stoneRecords += stone.records;
+        stoneBytes += stone.bytes;
+    }
+
+    // The records after the newest stone make up the stone currently being filled. If there are
+    // more of them than fit in a couple of stones, the persisted stones are too stale to be useful.
+    if (dataSize - stoneBytes > 2 * _minBytesPerStone) {
+        LOGV2(6101501,
+              "Persisted oplog truncation points do not cover the oplog, recalculating them",
+              "numStones"_attr = stones.size(),
+              "uncoveredBytes"_attr = dataSize - stoneBytes);
+        return false;
+    }
+
+    _processByLoading.store(true);
+    _stones = std::move(stones);
+    _currentRecords.store(std::max<int64_t>(numRecords - stoneRecords, 0));
+    _currentBytes.store(std::max<int64_t>(dataSize - stoneBytes, 0));
+
+    LOGV2(6101502,
+          "Loaded the persisted oplog truncation points",
+          "numStones"_attr = _stones.size(),
+          "currentRecords"_attr = _currentRecords.load(),
+          "currentBytes"_attr = _currentBytes.load());
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::persistStonesIfNeeded(OperationContext* opCtx) {
+    const auto& uri = _rs->_kvEngine->getOplogStonesUri();
+    if (uri.empty()) {
+        return;
+    }
+
+    BSONObj data;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_stonesNeedPersisting) {
+            return;
+        }
+        // Clear the flag before writing so that a failed write doesn't keep waking up the reclaim
+        // thread. The next change to the stones retries.
+        _stonesNeedPersisting = false;
+
+        BSONObjBuilder builder;
+        builder.append("version", kPersistedOplogStonesVersion);
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord" << stone.lastRecord.getLong()
+                                                << "wallTime" << stone.wallTime));
+        }
+        stonesBuilder.done();
+        data = builder.obj();
+    }
+
+    try {
+        writeConflictRetry(opCtx, "persistOplogStones", _rs->ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            WiredTigerCursor cursor(uri, _persistedStonesTableId, true, opCtx);
+            WiredTigerItem key(_rs->_uri.c_str(), _rs->_uri.size());
+            WiredTigerItem value(data.objdata(), data.objsize());
+            cursor->set_key(cursor.get(), key.Get());
+            cursor->set_value(cursor.get(), value.Get());
+            uassertStatusOK(wtRCToStatus(wiredTigerCursorInsert(opCtx, cursor.get())));
+            wuow.commit();
+        });
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(6101503,
+                      "Failed to persist the oplog truncation points",
+                      "error"_attr = ex.toStatus());
+    }
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
-    if (hasExcessStones_inlock()) {
+    if (_stonesNeedPersisting || hasExcessStones_inlock()) {
         _oplogReclaimCv.notify_one();
     }
 }
@@ -1133,6 +1299,7 @@ bool WiredTigerRecordStore::yieldAndAwaitOplogDeletionRequest(OperationContext*
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
     reclaimOplog(opCtx, _kvEngine->getPinnedOplog());
+    _oplogStones->persistStonesIfNeeded(opCtx);
 }
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
@@ -1360,6 +1527,99 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+/**
+ * Appends records to an empty record store through a WiredTiger bulk cursor, which writes them
+ * directly into new leaf pages without searching the tree, checking for conflicts or logging them.
+ */
+class WiredTigerRecordStore::BulkBuilder final : public RecordStoreBulkBuilderInterface {
+public:
+    BulkBuilder(WiredTigerRecordStore* rs,
+                OperationContext* opCtx,
+                UniqueWiredTigerSession session,
+                WT_CURSOR* cursor)
+        : _rs(rs), _opCtx(opCtx), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkBuilder() {
+        if (_cursor) {
+            _cursor->close(_cursor);
+        }
+    }
+
+    StatusWith<RecordId> addRecord(const char* data, int len) override {
+        invariant(_cursor);
+
+        // RecordIds are generated in increasing order, as bulk cursors require.
+        RecordId id = _rs->_nextId(_opCtx);
+        CursorKey key = makeCursorKey(id, KeyFormat::Long);
+        _rs->setKey(_cursor, &key);
+        WiredTigerItem value(data, len);
+        _cursor->set_value(_cursor, value.Get());
+        // The bulk cursor belongs to this builder's own session, not to the recovery unit's
+        // transaction, so the insert must not mark the recovery unit as modified.
+        int ret = _cursor->insert(_cursor);
+        if (ret)
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkBuilder::addRecord");
+
+        _numRecords++;
+        _dataSize += len;
+
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+        metricsCollector.incrementOneDocWritten(value.size);
+        return id;
+    }
+
+    void commit() override {
+        invariant(_cursor);
+
+        // The records become visible once the bulk cursor is closed.
+        invariantWTOK(_cursor->close(_cursor));
+        _cursor = nullptr;
+
+        _rs->_changeNumRecords(_opCtx, _numRecords);
+        _rs->_increaseDataSize(_opCtx, _dataSize);
+    }
+
+private:
+    WiredTigerRecordStore* const _rs;
+    OperationContext* const _opCtx;
+    UniqueWiredTigerSession const _session;
+    WT_CURSOR* _cursor;
+    int64_t _numRecords = 0;
+    int64_t _dataSize = 0;
+};
+
+std::unique_ptr<RecordStoreBulkBuilderInterface> WiredTigerRecordStore::makeBulkBuilder(
+    OperationContext* opCtx) {
+    if (_isCapped || _isOplog || _keyFormat != KeyFormat::Long || numRecords(opCtx) != 0) {
+        return nullptr;
+    }
+
+    // The next RecordId is initialized by reading the table, which is not possible once the bulk
+    // cursor is open.
+    _initNextIdIfNeeded(opCtx);
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(_uri);
+
+    // Use a different session to ensure we don't hijack an existing transaction. Configure the bulk
+    // cursor open to fail quickly if it would wait on a checkpoint completing, and fall back to the
+    // regular insert path instead.
+    auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* s = session->getSession();
+    WT_CURSOR* cursor;
+    int ret = s->open_cursor(s, _uri.c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+    if (ret) {
+        LOGV2_DEBUG(6101300,
+                    1,
+                    "Failed to create WiredTiger bulk cursor, falling back to regular inserts",
+                    "uri"_attr = _uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return nullptr;
+    }
+
+    return std::make_unique<BulkBuilder>(this, opCtx, std::move(session), cursor);
+}
+
 bool WiredTigerRecordStore::isOpHidden_forTest(const RecordId& id) const {
     invariant(_isOplog);
     invariant(id.getLong() > 0);
@@ -1999,6 +2259,12 @@ WiredTigerRecordStoreCursorBase::WiredTigerRecordStoreCursorBase(OperationContex
         _oplogVisibleTs = WiredTigerRecoveryUnit::get(opCtx)->getOplogVisibilityTs();
     }
     _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
+
+    if (_forward && !_rs._isOplog && _rs._keyFormat == KeyFormat::Long && _rs._kvEngine) {
+        if (auto readAhead = _rs._kvEngine->getReadAhead()) {
+            _readAheadWindow = readAhead->makeWindow();
+        }
+    }
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
@@ -2061,6 +2327,12 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     metricsCollector.incrementOneDocRead(value.size);
 
     _lastReturnedId = id;
+
+    if (_readAheadWindow) {
+        _rs._kvEngine->getReadAhead()->onRecordReturned(
+            _readAheadWindow, _rs.getURI(), id.getLong());
+    }
+
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
@@ -38,6 +38,7 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -152,6 +153,15 @@ public:
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
 
+    /**
+     * Returns a builder which appends records to this record store through a WiredTiger bulk
+     * cursor. Only supported for empty, uncapped record stores with the Long key format, and only
+     * when WiredTiger can open the bulk cursor, which it cannot while any other cursor is open on
+     * the table. Returns nullptr otherwise.
+     */
+    std::unique_ptr<RecordStoreBulkBuilderInterface> makeBulkBuilder(
+        OperationContext* opCtx) override;
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& recordId,
                                 const char* data,
@@ -277,6 +287,7 @@ protected:
     virtual void setKey(WT_CURSOR* cursor, const CursorKey* key) const = 0;
 
 private:
+    class BulkBuilder;
     class RandomCursor;
 
     class NumRecordsChange;
@@ -424,6 +435,9 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    // Set for forward scans over tables with integer keys when cache read-ahead is enabled.
+    std::shared_ptr<WiredTigerReadAhead::Window> _readAheadWindow;
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
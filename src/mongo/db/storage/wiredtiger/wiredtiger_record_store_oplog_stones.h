@@ -67,7 +67,10 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        builder.append("processingMethod",
+                       _processByLoading.load()
+                           ? "persisted"
+                           : (_processBySampling.load() ? "sampling" : "scanning"));
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
@@ -94,6 +97,11 @@ public:
     // Resize oplog size
     void adjust(int64_t maxSize);
 
+    // Writes the current oplog stones to the side table they are loaded from on startup, if they
+    // changed since they were last written. Failures are logged and otherwise ignored, as the
+    // stones are recalculated on startup if the persisted ones don't match the oplog.
+    void persistStonesIfNeeded(OperationContext* opCtx);
+
     // The start point of where to truncate next. Used by the background reclaim thread to
     // efficiently truncate records with WiredTiger by skipping over tombstones, etc.
     RecordId firstRecord;
@@ -121,6 +129,10 @@ public:
         return _processBySampling.load();
     }
 
+    bool processedByLoading() const {
+        return _processByLoading.load();
+    }
+
 private:
     class InsertChange;
     class TruncateChange;
@@ -131,6 +143,13 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Loads the stones persisted by the last call to persistStonesIfNeeded(). Returns false,
+    // leaving the stones untouched, if there are none or they don't cover the current oplog.
+    bool _loadPersistedStones(OperationContext* opCtx, long long numRecords, long long dataSize);
+
+    // Returns true if the oldest stone is older than the maximum oplog retention, if one is set.
+    bool _hasExpiredStone_inlock() const;
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
@@ -153,10 +172,17 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _processByLoading;        // Whether the stones were loaded from disk.
+
+    // Table id used to cache cursors on the side table holding the persisted stones.
+    const uint64_t _persistedStonesTableId;
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
+
+    // Whether '_stones' changed since they were last persisted. Protected by '_mutex'.
+    bool _stonesNeedPersisting = false;
 };
 
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context_noop.h"
+#include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
@@ -333,6 +334,37 @@ TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     ASSERT_EQUALS(creationStringElement.type(), String);
 }
 
+TEST(WiredTigerRecordStoreTest, BulkBuilderAppendsToEmptyRecordStore) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
+
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto bulkBuilder = rs->makeBulkBuilder(opCtx.get());
+        ASSERT(bulkBuilder);
+        for (int i = 0; i < 10; ++i) {
+            BSONObj obj = BSON("_id" << i);
+            auto res = bulkBuilder->addRecord(obj.objdata(), obj.objsize());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+
+        WriteUnitOfWork wuow(opCtx.get());
+        bulkBuilder->commit();
+        wuow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    ASSERT_EQUALS(10, rs->numRecords(opCtx.get()));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_BSONOBJ_EQ(BSON("_id" << i), rs->dataFor(opCtx.get(), ids[i]).toBson());
+    }
+
+    // Bulk cursors can only be opened on empty tables.
+    ASSERT_FALSE(rs->makeBulkBuilder(opCtx.get()));
+}
+
 BSONObj makeBSONObjWithSize(const Timestamp& opTime, int size, char fill = 'x') {
     BSONObj objTemplate = BSON("ts" << opTime << "str"
                                     << "");
@@ -916,6 +948,82 @@ TEST(WiredTigerRecordStoreTest, OplogStones_Duplicates) {
     }
 }
 
+// Stones persisted by the reclaim thread are loaded instead of recalculated when the oplog is
+// reopened.
+TEST(WiredTigerRecordStoreTest, OplogStones_LoadPersistedStones) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    auto wtHarnessHelper = dynamic_cast<WiredTigerHarnessHelper*>(harnessHelper.get());
+    auto wtKvEngine = dynamic_cast<WiredTigerKVEngine*>(harnessHelper->getEngine());
+
+    {
+        std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+        WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+        WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+        oplogStones->setMinBytesPerStone(100);
+
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 110), RecordId(1, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 50), RecordId(1, 3));
+        ASSERT_EQ(2U, oplogStones->numStones());
+
+        // The oplog is far below its maximum size, so this only persists the stones.
+        wtrs->reclaimOplog(opCtx.get());
+        ASSERT_EQ(3, rs->numRecords(opCtx.get()));
+    }
+
+    std::unique_ptr<RecordStore> rs(wtHarnessHelper->newOplogRecordStoreNoInit());
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    wtKvEngine->getOplogManager()->setOplogReadTimestamp(Timestamp(1, 3));
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        wtrs->setNumRecords(3);
+        wtrs->setDataSize(260);
+        wtrs->postConstructorInit(opCtx.get());
+    }
+
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+    ASSERT(oplogStones->processedByLoading());
+    ASSERT_EQ(2U, oplogStones->numStones());
+    ASSERT_EQ(1, oplogStones->currentRecords());
+    ASSERT_EQ(50, oplogStones->currentBytes());
+}
+
+// Stones older than the maximum retention are truncated even though the oplog is not full.
+TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimExpiredStones) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+    oplogStones->setMinBytesPerStone(100);
+
+    const auto originalMaxRetentionHours = gOplogTruncationMaxRetentionHours.load();
+    ON_BLOCK_EXIT([&] { gOplogTruncationMaxRetentionHours.store(originalMaxRetentionHours); });
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    for (int i = 1; i <= 3; ++i) {
+        // Date the entries two hours back.
+        BSONObj obj = BSON("ts" << Timestamp(1, i) << "wall" << Date_t::now() - Hours(2) << "str"
+                                << std::string(100, 'x'));
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(wtrs->oplogDiskLocRegister(opCtx.get(), Timestamp(1, i), false));
+        ASSERT_OK(rs->insertRecord(opCtx.get(), obj.objdata(), obj.objsize(), Timestamp(1, i)));
+        wuow.commit();
+    }
+    ASSERT_EQ(3U, oplogStones->numStones());
+
+    wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 3));
+    ASSERT_EQ(3U, oplogStones->numStones());
+
+    gOplogTruncationMaxRetentionHours.store(1.0);
+    wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 3));
+
+    // The newest stone is kept, as the entire oplog is never truncated.
+    ASSERT_EQ(1U, oplogStones->numStones());
+    ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+}
+
 TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
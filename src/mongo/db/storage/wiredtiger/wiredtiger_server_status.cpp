@@ -90,6 +90,11 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
+    {
+        BSONObjBuilder subsection(bob.subobjStart("session cursor cache"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendCursorCacheStats(&subsection);
+    }
+
     {
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
@@ -33,9 +33,12 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -45,9 +48,134 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+namespace {
+
+// Upper bound on the number of stripes in a session cache.
+constexpr size_t kMaxSessionCacheStripes = 64;
+
+size_t getNumSessionCacheStripes() {
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxSessionCacheStripes);
+}
+
+// Threads are assigned home stripes round-robin, in the order they first use a session cache.
+AtomicWord<unsigned> nextHomeStripe;
+thread_local const unsigned threadHomeStripe = nextHomeStripe.fetchAndAdd(1);
+
+}  // namespace
+
+namespace {
+// Number of slots in a newly created cursor cache.
+constexpr size_t kInitialCursorCacheCapacity = 16;
+}  // namespace
+
+WiredTigerCursorCache::WiredTigerCursorCache() : _slots(kInitialCursorCacheCapacity) {}
+
+size_t WiredTigerCursorCache::_hash(uint64_t id, const std::string& config) {
+    size_t hash = std::hash<std::string>{}(config);
+    boost::hash_combine(hash, id);
+    return hash;
+}
+
+WT_CURSOR* WiredTigerCursorCache::take(uint64_t id, const std::string& config) {
+    const size_t hash = _hash(id, config);
+
+    // Find the most recently released matching cursor in the probe sequence. Note that this uses
+    // an exact string match, so cursor configurations with parameters in different orders will not
+    // be considered equivalent.
+    boost::optional<size_t> found;
+    for (size_t pos = hash & _mask(); _slots[pos].cursor._cursor; pos = (pos + 1) & _mask()) {
+        const auto& slot = _slots[pos];
+        if (slot.hash == hash && slot.cursor._id == id && slot.cursor._config == config &&
+            (!found || slot.cursor._gen > _slots[*found].cursor._gen)) {
+            found = pos;
+        }
+    }
+
+    if (!found) {
+        ++_stats.misses;
+        return nullptr;
+    }
+
+    ++_stats.hits;
+    WT_CURSOR* cursor = _slots[*found].cursor._cursor;
+    _erase(*found);
+    return cursor;
+}
+
+void WiredTigerCursorCache::insert(uint64_t id,
+                                   uint64_t gen,
+                                   WT_CURSOR* cursor,
+                                   const std::string& config) {
+    invariant(cursor);
+    if ((_size + 1) * 2 > _slots.size()) {
+        _rehash(_slots.size() * 2);
+    }
+
+    Slot slot;
+    slot.hash = _hash(id, config);
+    slot.cursor = WiredTigerCachedCursor(id, gen, cursor, config);
+    _releaseOrder.emplace_back(gen, slot.hash);
+    _place(std::move(slot));
+}
+
+std::vector<WiredTigerCachedCursor> WiredTigerCursorCache::evictOlderThan(uint64_t minGen) {
+    std::vector<WiredTigerCachedCursor> evicted;
+    while (!_releaseOrder.empty() && _releaseOrder.front().first < minGen) {
+        const auto [gen, hash] = _releaseOrder.front();
+        _releaseOrder.pop_front();
+
+        for (size_t pos = hash & _mask(); _slots[pos].cursor._cursor; pos = (pos + 1) & _mask()) {
+            if (_slots[pos].cursor._gen == gen) {
+                evicted.push_back(std::move(_slots[pos].cursor));
+                _erase(pos);
+                ++_stats.evictions;
+                break;
+            }
+        }
+    }
+    return evicted;
+}
+
+void WiredTigerCursorCache::_place(Slot slot) {
+    size_t pos = slot.hash & _mask();
+    while (_slots[pos].cursor._cursor) {
+        pos = (pos + 1) & _mask();
+    }
+    _slots[pos] = std::move(slot);
+    ++_size;
+}
+
+void WiredTigerCursorCache::_erase(size_t pos) {
+    // Shift back any later slot in the probe sequence that would otherwise become unreachable, so
+    // that no tombstones are needed.
+    for (size_t next = (pos + 1) & _mask(); _slots[next].cursor._cursor;
+         next = (next + 1) & _mask()) {
+        const size_t home = _slots[next].hash & _mask();
+        const bool canMove =
+            pos <= next ? (home <= pos || home > next) : (home <= pos && home > next);
+        if (canMove) {
+            _slots[pos] = std::move(_slots[next]);
+            pos = next;
+        }
+    }
+    _slots[pos] = Slot();
+    --_size;
+}
+
+void WiredTigerCursorCache::_rehash(size_t capacity) {
+    std::vector<Slot> slots(capacity);
+    _slots.swap(slots);
+    _size = 0;
+    for (auto&& slot : slots) {
+        if (slot.cursor._cursor) {
+            _place(std::move(slot));
+        }
+    }
+}
 
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
@@ -112,19 +240,13 @@ void _openCursor(WT_SESSION* session,
 }  // namespace
 
 WT_CURSOR* WiredTigerSession::getCachedCursor(uint64_t id, const std::string& config) {
-    // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        // Ensure that all properties of this cursor are identical to avoid mixing cursor
-        // configurations. Note that this uses an exact string match, so cursor configurations with
-        // parameters in different orders will not be considered equivalent.
-        if (i->_id == id && i->_config == config) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            return c;
-        }
+    // Find the most recently used cursor. All properties of the cursor must be identical to avoid
+    // mixing cursor configurations.
+    WT_CURSOR* c = _cursors.take(id, config);
+    if (c) {
+        _cursorsOut++;
     }
-    return nullptr;
+    return c;
 }
 
 WT_CURSOR* WiredTigerSession::getNewCursor(const std::string& uri, const char* config) {
@@ -141,16 +263,16 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor, const std:
 
     invariantWTOK(cursor->reset(cursor));
 
-    // Cursors are pushed to the front of the list and removed from the back
-    _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor, config));
+    _cursors.insert(id, _cursorGen++, cursor, config);
 
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
 
-    while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
-        cursor = _cursors.back()._cursor;
-        _cursors.pop_back();
-        invariantWTOK(cursor->close(cursor));
+    // Close the cursors released more than 'cacheSize' releases ago.
+    if (_cursorGen > cacheSize) {
+        for (auto&& evicted : _cursors.evictOlderThan(_cursorGen - cacheSize)) {
+            invariantWTOK(evicted._cursor->close(evicted._cursor));
+        }
     }
 }
 
@@ -166,13 +288,11 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
     invariant(_session);
 
     bool all = (uri == "");
-    for (auto i = _cursors.begin(); i != _cursors.end();) {
-        WT_CURSOR* cursor = i->_cursor;
-        if (cursor && (all || uri == cursor->uri)) {
-            invariantWTOK(cursor->close(cursor));
-            i = _cursors.erase(i);
-        } else
-            ++i;
+    auto toClose = _cursors.removeIf([&](const WiredTigerCachedCursor& cached) {
+        return all || uri == cached._cursor->uri;
+    });
+    for (auto&& cached : toClose) {
+        invariantWTOK(cached._cursor->close(cached._cursor));
     }
 }
 
@@ -182,11 +302,8 @@ void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
     _cursorEpoch = _cache->getCursorEpoch();
     auto toDrop = engine->filterCursorsWithQueuedDrops(&_cursors);
 
-    for (auto i = toDrop.begin(); i != toDrop.end(); i++) {
-        WT_CURSOR* cursor = i->_cursor;
-        if (cursor) {
-            invariantWTOK(cursor->close(cursor));
-        }
+    for (auto&& cached : toDrop) {
+        invariantWTOK(cached._cursor->close(cached._cursor));
     }
 }
 
@@ -205,6 +322,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numStripes(getNumSessionCacheStripes()),
+      _stripes(std::make_unique<CacheStripe[]>(_numStripes)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -212,6 +331,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numStripes(getNumSessionCacheStripes()),
+      _stripes(std::make_unique<CacheStripe[]>(_numStripes)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -376,10 +497,16 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
+WiredTigerSessionCache::CacheStripe& WiredTigerSessionCache::_getHomeStripe() {
+    return _stripes[threadHomeStripe % _numStripes];
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t i = 0; i < _numStripes; ++i) {
+        stdx::lock_guard<Latch> lock(_stripes[i].mutex);
+        for (auto session : _stripes[i].sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -387,15 +514,16 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t i = 0; i < _numStripes; ++i) {
+        stdx::lock_guard<Latch> lock(_stripes[i].mutex);
+        for (auto session : _stripes[i].sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    return _idleSessionsCount.load();
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,14 +535,16 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t i = 0; i < _numStripes; ++i) {
+        auto& stripe = _stripes[i];
+        stdx::lock_guard<Latch> lock(stripe.mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = stripe.sessions.begin(); it != stripe.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = stripe.sessions.erase(it);
+                _idleSessionsCount.fetchAndSubtract(1);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
@@ -430,13 +560,17 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This must happen
+    // before any stripe is emptied, see releaseSession().
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t i = 0; i < _numStripes; ++i) {
+        auto& stripe = _stripes[i];
+        stdx::lock_guard<Latch> lock(stripe.mutex);
+        _idleSessionsCount.fetchAndSubtract(stripe.sessions.size());
+        swap.insert(swap.end(), stripe.sessions.begin(), stripe.sessions.end());
+        stripe.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -453,15 +587,29 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
+    auto takeCachedSession = [&](CacheStripe& stripe) -> WiredTigerSession* {
+        stdx::lock_guard<Latch> lock(stripe.mutex);
+        if (stripe.sessions.empty()) {
+            return nullptr;
+        }
+        // Get the most recently used session so that if we discard sessions, we're
+        // discarding older ones
+        WiredTigerSession* cachedSession = stripe.sessions.back();
+        stripe.sessions.pop_back();
+        _idleSessionsCount.fetchAndSubtract(1);
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return cachedSession;
+    };
+
+    // Prefer this thread's own stripe, and only then take a session cached by another thread
+    // rather than open a new one.
+    const size_t home = threadHomeStripe % _numStripes;
+    if (auto cachedSession = takeCachedSession(_stripes[home])) {
+        return UniqueWiredTigerSession(cachedSession);
+    }
+    for (size_t i = 1; i < _numStripes && _idleSessionsCount.load() > 0; ++i) {
+        if (auto cachedSession = takeCachedSession(_stripes[(home + i) % _numStripes])) {
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -478,6 +626,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     const int shuttingDown = _shuttingDown.fetchAndAdd(1);
     ON_BLOCK_EXIT([this] { _shuttingDown.fetchAndSubtract(1); });
 
+    const auto cursorCacheStats = session->_cursors.takeStats();
+    _cursorCacheHits.fetchAndAdd(cursorCacheStats.hits);
+    _cursorCacheMisses.fetchAndAdd(cursorCacheStats.misses);
+    _cursorCacheEvictions.fetchAndAdd(cursorCacheStats.evictions);
+
     if (shuttingDown & kShuttingDownMask) {
         // There is a race condition with clean shutdown, where the storage engine is ripped from
         // underneath OperationContexts, which are not "active" (i.e., do not have any locks), but
@@ -521,10 +674,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& stripe = _getHomeStripe();
+        stdx::lock_guard<Latch> lock(stripe.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            stripe.sessions.push_back(session);
+            _idleSessionsCount.fetchAndAdd(1);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -537,6 +692,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+void WiredTigerSessionCache::appendCursorCacheStats(BSONObjBuilder* builder) const {
+    builder->append("hits", static_cast<long long>(_cursorCacheHits.load()));
+    builder->append("misses", static_cast<long long>(_cursorCacheMisses.load()));
+    builder->append("evictions", static_cast<long long>(_cursorCacheEvictions.load()));
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<Latch> lk(_journalListenerMutex);
 
@@ -29,8 +29,10 @@
 
 #pragma once
 
-#include <list>
+#include <deque>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -38,10 +40,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -56,6 +60,104 @@ public:
     std::string _config;  // Cursor config. Do not serve cursors with different configurations
 };
 
+/**
+ * The cursors cached by a WiredTigerSession, keyed by table id and cursor config. This is a flat,
+ * open-addressing hash table with linear probing and backward shift deletion, so that a lookup
+ * touches a few adjacent cache lines rather than walking a list of every cached cursor. Several
+ * cursors may be cached under the same key, and cursors age out in the order they were released.
+ * NOT THREADSAFE
+ */
+class WiredTigerCursorCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    WiredTigerCursorCache();
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Removes and returns the most recently released cursor on table 'id' with config 'config', or
+     * returns nullptr if there is none.
+     */
+    WT_CURSOR* take(uint64_t id, const std::string& config);
+
+    /**
+     * Caches 'cursor'. The generation 'gen' must be greater than that of every cursor inserted
+     * before.
+     */
+    void insert(uint64_t id, uint64_t gen, WT_CURSOR* cursor, const std::string& config);
+
+    /**
+     * Removes and returns the cursors with a generation lower than 'minGen', counting them as
+     * evictions.
+     */
+    std::vector<WiredTigerCachedCursor> evictOlderThan(uint64_t minGen);
+
+    /**
+     * Removes and returns every cursor for which 'pred' returns true.
+     */
+    template <typename Pred>
+    std::vector<WiredTigerCachedCursor> removeIf(Pred pred) {
+        std::vector<WiredTigerCachedCursor> removed;
+        for (auto&& slot : _slots) {
+            if (slot.cursor._cursor && pred(slot.cursor)) {
+                removed.push_back(std::move(slot.cursor));
+                slot = Slot();
+                --_size;
+            }
+        }
+        if (!removed.empty()) {
+            // Emptying slots may have broken probe sequences, so re-place what is left.
+            _rehash(_slots.size());
+        }
+        return removed;
+    }
+
+    /**
+     * Returns the counters accumulated since the last call, and resets them.
+     */
+    Stats takeStats() {
+        return std::exchange(_stats, {});
+    }
+
+private:
+    // Sized to fill a cache line on common platforms. An empty slot has a null '_cursor'.
+    struct alignas(stdx::hardware_constructive_interference_size) Slot {
+        size_t hash = 0;
+        WiredTigerCachedCursor cursor{0, 0, nullptr, {}};
+    };
+
+    static size_t _hash(uint64_t id, const std::string& config);
+
+    size_t _mask() const {
+        return _slots.size() - 1;
+    }
+
+    void _place(Slot slot);
+    void _erase(size_t pos);
+    void _rehash(size_t capacity);
+
+    // Always a power of two in size, and kept at most half full.
+    std::vector<Slot> _slots;
+    size_t _size = 0;
+
+    // The (generation, hash) of cursors in the order they were released, oldest first. Entries for
+    // cursors that were taken or removed since are skipped when they reach the front.
+    std::deque<std::pair<uint64_t, size_t>> _releaseOrder;
+
+    Stats _stats;
+};
+
 /**
  * This is a structure that caches 1 cursor for each uri.
  * The idea is that there is a pool of these somewhere.
@@ -145,7 +247,7 @@ public:
     }
 
     int cachedCursors() const {
-        return _cursors.size();
+        return static_cast<int>(_cursors.size());
     }
 
     bool isDropQueuedIdentsAtSessionEndAllowed() const {
@@ -182,9 +284,6 @@ private:
     friend class WiredTigerSessionCache;
     friend class WiredTigerKVEngine;
 
-    // The cursor cache is a list of pairs that contain an ID and cursor
-    typedef std::list<WiredTigerCachedCursor> CursorCache;
-
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
         return _epoch;
@@ -199,7 +298,7 @@ private:
     uint64_t _cursorEpoch;
     WiredTigerSessionCache* _cache;  // not owned
     WT_SESSION* _session;            // owned
-    CursorCache _cursors;            // owned
+    WiredTigerCursorCache _cursors;  // owned
     uint64_t _cursorGen;
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
@@ -367,6 +466,12 @@ public:
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
 
+    /**
+     * Appends the hit, miss and eviction counts of the cursor caches of the sessions released to
+     * this cache so far.
+     */
+    void appendCursorCacheStats(BSONObjBuilder* builder) const;
+
 private:
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
@@ -379,16 +484,45 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
 
-    // Bumped when all open sessions need to be closed
-    AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
+    /**
+     * One of the independently locked free lists that make up the cache. A thread releases its
+     * sessions to its home stripe and takes them from there first, so that threads running on
+     * different cores rarely contend on the same mutex or cache line.
+     */
+    struct alignas(stdx::hardware_destructive_interference_size) CacheStripe {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::CacheStripe::mutex");
+        SessionCache sessions;
+    };
+
+    /**
+     * Returns the stripe the calling thread caches its sessions in.
+     */
+    CacheStripe& _getHomeStripe();
+
+    const size_t _numStripes;
+    std::unique_ptr<CacheStripe[]> _stripes;
+
+    // Count of the sessions cached across all stripes. Only modified while holding the mutex of
+    // the stripe being changed, but read without any lock so that getSession() does not search
+    // the other stripes when there is nothing to find.
+    AtomicWord<size_t> _idleSessionsCount{0};
+
+    // Bumped when all open sessions need to be closed. It is checked outside of any lock, and
+    // rechecked under the stripe mutex before caching a session: closeAll() bumps it before it
+    // empties each stripe, so no session from an older epoch can be cached behind its back.
+    AtomicWord<unsigned long long> _epoch;
 
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
+    // Cursor cache counters folded in from sessions as they are released, so that the hot path of
+    // fetching a cached cursor never touches shared memory.
+    AtomicWord<unsigned long long> _cursorCacheHits{0};
+    AtomicWord<unsigned long long> _cursorCacheMisses{0};
+    AtomicWord<unsigned long long> _cursorCacheEvictions{0};
+
     // Counter and critical section mutex for waitUntilDurable
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
@@ -34,10 +34,13 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -114,4 +117,78 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, SessionsReleasedByOtherThreadsAreReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release a session on each of several threads, which may cache them in different stripes.
+    const size_t kNumThreads = 4;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] { sessionCache->getSession(); });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), kNumThreads);
+
+    // This thread takes sessions from any stripe before it opens new ones.
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < kNumThreads; ++i) {
+        sessions.push_back(sessionCache->getSession());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    sessions.clear();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), kNumThreads);
+
+    // Sessions released after closeAll() are not cached.
+    auto session = sessionCache->getSession();
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    session.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheReturnsMostRecentlyReleasedMatchingCursor) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    UniqueWiredTigerSession session = harnessHelper.getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    const std::string uri = "table:cursor_cache";
+    ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, uri.c_str(), nullptr)));
+
+    const auto originalCacheSize = gWiredTigerCursorCacheSize.load();
+    ON_BLOCK_EXIT([&] { gWiredTigerCursorCacheSize.store(originalCacheSize); });
+    gWiredTigerCursorCacheSize.store(100);
+
+    const uint64_t tableId = WiredTigerSession::genTableId();
+    WT_CURSOR* first = session->getNewCursor(uri);
+    WT_CURSOR* second = session->getNewCursor(uri);
+    session->releaseCursor(tableId, first, "");
+    session->releaseCursor(tableId, second, "");
+    ASSERT_EQ(session->cachedCursors(), 2);
+
+    // Cursors are only served for the exact table id and config they were released with.
+    ASSERT_FALSE(session->getCachedCursor(tableId, "overwrite=false"));
+    ASSERT_FALSE(session->getCachedCursor(tableId + 1, ""));
+    ASSERT_EQ(session->getCachedCursor(tableId, ""), second);
+    ASSERT_EQ(session->getCachedCursor(tableId, ""), first);
+    ASSERT_EQ(session->cachedCursors(), 0);
+
+    // Only the most recently released cursors stay cached.
+    gWiredTigerCursorCacheSize.store(1);
+    session->releaseCursor(tableId, first, "");
+    session->releaseCursor(tableId + 1, second, "");
+    ASSERT_EQ(session->cachedCursors(), 1);
+    ASSERT_FALSE(session->getCachedCursor(tableId, ""));
+    ASSERT_EQ(session->getCachedCursor(tableId + 1, ""), second);
+    session->releaseCursor(tableId + 1, second, "");
+
+    // Releasing the session folds its counters into the session cache.
+    session.reset();
+    BSONObjBuilder builder;
+    harnessHelper.getSessionCache()->appendCursorCacheStats(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(), BSON("hits" << 3 << "misses" << 3 << "evictions" << 1));
+}
+
 }  // namespace mongo
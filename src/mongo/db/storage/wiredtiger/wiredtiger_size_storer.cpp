@@ -43,10 +43,17 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
+namespace {
+
+MONGO_FAIL_POINT_DEFINE(WTPauseSizeStorerFlush);
+
+}  // namespace
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool readOnly)
@@ -74,8 +81,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    auto key = StringMapHasher{}.hashed_key(uri);
+    auto& shard = _shardFor(key);
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    auto& entry = shard.buffer[key];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -94,9 +103,11 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        auto key = StringMapHasher{}.hashed_key(uri);
+        auto& shard = _shardFor(key);
+        stdx::lock_guard<Latch> bufferLock(shard.mutex);
+        Buffer::const_iterator it = shard.buffer.find(key);
+        if (it != shard.buffer.end())
             return it->second;
     }
 
@@ -126,61 +137,91 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    std::vector<Entry> entries;
+    for (auto& shard : _bufferShards) {
+        Buffer buffer;
+        {
+            stdx::lock_guard<Latch> bufferLock(shard.mutex);
+            shard.buffer.swap(buffer);
+        }
+        for (auto& it : buffer)
+            entries.emplace_back(it.first, std::move(it.second));
     }
 
-    if (buffer.empty())
+    if (entries.empty())
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    auto batchStart = entries.cbegin();
     {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
+        // On failure, place the entries that were not written back into the buffer, unless a newer
+        // value already exists.
+        ON_BLOCK_EXIT([this, &entries, &batchStart]() {
+            for (auto it = batchStart; it != entries.cend(); ++it) {
+                auto key = StringMapHasher{}.hashed_key(it->first);
+                auto& shard = _shardFor(key);
+                stdx::lock_guard<Latch> bufferLock(shard.mutex);
+                shard.buffer.try_emplace(key, it->second);
             }
         });
 
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
-
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-
-            // Ordering is important here: when the store method checks if the SizeInfo
-            // is dirty and it returns true, the current values of numRecords and dataSize must
-            // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
-            sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
-
-            auto& uri = it->first;
-            LOGV2_DEBUG(22425,
-                        2,
-                        "WiredTigerSizeStorer::flush",
-                        "uri"_attr = uri,
-                        "data"_attr = redact(data));
-            WiredTigerItem key(uri.c_str(), uri.size());
-            WiredTigerItem value(data.objdata(), data.objsize());
-            _cursor->set_key(_cursor, key.Get());
-            _cursor->set_value(_cursor, value.Get());
-            invariantWTOK(_cursor->insert(_cursor));
+        // Only the last batch needs to be synced to disk, as that also makes all earlier commits
+        // durable.
+        while (batchStart != entries.cend()) {
+            auto batchEnd = batchStart +
+                std::min<ptrdiff_t>(kFlushBatchSize, std::distance(batchStart, entries.cend()));
+            _writeBatch(batchStart, batchEnd, syncToDisk && batchEnd == entries.cend());
+            batchStart = batchEnd;
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
     }
 
     LOGV2_DEBUG(22426,
                 2,
                 "WiredTigerSizeStorer::flush completed",
+                "numEntries"_attr = entries.size(),
                 "duration"_attr = Microseconds{t.micros()});
 }
+
+WiredTigerSizeStorer::BufferShard& WiredTigerSizeStorer::_shardFor(
+    const StringMapHashedKey& key) const {
+    // The low bits of the hash are used to probe within each shard's table, so pick the shard from
+    // the high bits to keep the entries of a shard well spread.
+    return _bufferShards[(key.hash() >> 32) % kNumBufferShards];
+}
+
+void WiredTigerSizeStorer::_writeBatch(std::vector<Entry>::const_iterator first,
+                                       std::vector<Entry>::const_iterator last,
+                                       bool syncToDisk) {
+    // Holding the cursor mutex for a single batch only bounds how long concurrent loads of entries
+    // that aren't buffered have to wait.
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([this] { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    // Pauses with the write-back transaction open, so that tests can interleave other work with it.
+    WTPauseSizeStorerFlush.pauseWhileSet();
+
+    for (auto it = first; it != last; ++it) {
+        // Ordering is important here: when the store method checks if the SizeInfo is dirty and it
+        // returns true, the current values of numRecords and dataSize must still be written back.
+        // So, the required order is to clear the dirty flag first.
+        SizeInfo& sizeInfo = *it->second;
+        sizeInfo._dirty.store(false);
+        BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
+                                         << sizeInfo.dataSize.load());
+
+        auto& uri = it->first;
+        LOGV2_DEBUG(
+            22425, 2, "WiredTigerSizeStorer::flush", "uri"_attr = uri, "data"_attr = redact(data));
+        WiredTigerItem key(uri.c_str(), uri.size());
+        WiredTigerItem value(data.objdata(), data.objsize());
+        _cursor->set_key(_cursor, key.Get());
+        _cursor->set_value(_cursor, value.Get());
+        invariantWTOK(_cursor->insert(_cursor));
+    }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+}
 }  // namespace mongo
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <array>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -51,6 +54,11 @@ namespace mongo {
  * in size updates to be lost, so size information is only approximate. Reads use the buffer for
  * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
  * and cursor.
+ *
+ * Writers only ever bump the atomic counters of a SizeInfo; the first update after a flush also
+ * files it into one of several independently locked buffer shards, so that writers to different
+ * collections don't contend. Flushes drain the shards and write the dirty entries back in bounded
+ * batches, so neither stores nor reads of unbuffered entries wait for the whole write-back.
  */
 class WiredTigerSizeStorer {
 public:
@@ -93,16 +101,37 @@ public:
     void flush(bool syncToDisk);
 
 private:
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+
+    // Number of independently locked shards the dirty entries are spread over.
+    static constexpr size_t kNumBufferShards = 16;
+
+    // Maximum number of entries written back in a single WiredTiger transaction by flush.
+    static constexpr size_t kFlushBatchSize = 1000;
+
+    struct BufferShard {
+        // Guards buffer. Acquire *after* _cursorMutex.
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::BufferShard::mutex");
+        Buffer buffer;
+    };
+
+    using Entry = std::pair<std::string, std::shared_ptr<SizeInfo>>;
+
+    BufferShard& _shardFor(const StringMapHashedKey& key) const;
+
+    /**
+     * Writes the entries in the range [first, last) to the table in a single transaction.
+     */
+    void _writeBatch(std::vector<Entry>::const_iterator first,
+                     std::vector<Entry>::const_iterator last,
+                     bool syncToDisk);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any BufferShard::mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
-
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    mutable std::array<BufferShard, kNumBufferShards> _bufferShards;
 };
 }  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
@@ -153,6 +154,75 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+// Flushing more entries than fit in a single write-back batch must persist all of them.
+TEST(WiredTigerRecordStoreTest, ForwardScanWithReadAhead) {
+    const auto oldMaxRecords = gWiredTigerReadAheadMaxRecords.load();
+    gWiredTigerReadAheadMaxRecords.store(256);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadAheadMaxRecords.store(oldMaxRecords); });
+
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int N = 5000;
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < N; i++) {
+            string data = str::stream() << "record" << i;
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    // Read-ahead requests run concurrently with the scan, which must still see every record once,
+    // in order. Scan twice so that the second cursor starts while the first one's requests may
+    // still be outstanding.
+    for (int pass = 0; pass < 2; pass++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        for (int i = 0; i < N; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(ids[i], record->id);
+            ASSERT_EQ(string(str::stream() << "record" << i), record->data.data());
+        }
+        ASSERT(!cursor->next());
+    }
+}
+
+TEST(WiredTigerRecordStoreTest, SizeStorerFlushesManyEntries) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    string sizeStorerUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    const bool enableWtLogging = false;
+    const int N = 2500;
+
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> sizeInfos;
+    {
+        WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri, enableWtLogging);
+        for (int i = 0; i < N; i++) {
+            sizeInfos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, 2 * i));
+            ss.store("table:coll-" + std::to_string(i), sizeInfos.back());
+        }
+        ss.flush(true);
+
+        // Updates made after the flush are picked up by the next one.
+        sizeInfos[7]->numRecords.store(-7);
+        ss.store("table:coll-7", sizeInfos[7]);
+        ss.flush(false);
+    }
+
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri, enableWtLogging);
+    for (int i = 0; i < N; i++) {
+        auto info = ss.load("table:coll-" + std::to_string(i));
+        ASSERT_EQUALS(i == 7 ? -7 : i, info->numRecords.load());
+        ASSERT_EQUALS(2 * i, info->dataSize.load());
+    }
+}
+
 class SizeStorerUpdateTest : public mongo::unittest::Test {
 private:
     virtual void setUp() {
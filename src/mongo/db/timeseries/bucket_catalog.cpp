@@ -43,6 +43,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -51,6 +52,15 @@ void normalizeArray(BSONArrayBuilder* builder, const BSONObj& obj);
 void normalizeObject(BSONObjBuilder* builder, const BSONObj& obj);
 
 const auto getBucketCatalog = ServiceContext::declareDecoration<BucketCatalog>();
+
+// Number of measurements from other clients a group commit waits for, given the average time
+// between measurements arriving in the bucket.
+constexpr uint64_t kGroupCommitArrivalsToWaitFor = 4;
+
+// Upper bound on a single sample of the time between arriving measurements, so one long pause in
+// the writes does not prevent grouping for long once they pick up again.
+constexpr uint64_t kMaxInterArrivalSampleMicros = 1000 * 1000;
+
 MONGO_FAIL_POINT_DEFINE(hangTimeseriesDirectModificationBeforeWriteConflict);
 
 uint8_t numDigits(uint32_t num) {
@@ -150,6 +160,38 @@ OperationId getOpId(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+/**
+ * Hashes the metadata value such that two values which are equal after normalization hash
+ * identically, regardless of the field order of any embedded objects. This lets us pick the stripe
+ * for a key without first paying for normalization.
+ */
+std::size_t hashMetadataIgnoringFieldOrder(const BSONElement& elem) {
+    using Combine = absl::Hash<std::pair<std::size_t, std::size_t>>;
+    switch (elem.type()) {
+        case BSONType::Object: {
+            // Fields are combined with a commutative operation so their order does not matter.
+            std::size_t hash = 0;
+            for (auto&& field : elem.Obj()) {
+                hash += Combine{}(
+                    {absl::Hash<absl::string_view>{}(absl::string_view(field.fieldName(),
+                                                                       field.fieldNameSize() - 1)),
+                     hashMetadataIgnoringFieldOrder(field)});
+            }
+            return Combine{}({static_cast<std::size_t>(BSONType::Object), hash});
+        }
+        case BSONType::Array: {
+            std::size_t hash = static_cast<std::size_t>(BSONType::Array);
+            for (auto&& element : elem.Obj()) {
+                hash = Combine{}({hash, hashMetadataIgnoringFieldOrder(element)});
+            }
+            return hash;
+        }
+        default:
+            return absl::Hash<absl::string_view>{}(
+                absl::string_view(elem.value(), elem.valuesize()));
+    }
+}
+
 BSONObj buildControlMinTimestampDoc(StringData timeField, long long roundedSeconds) {
     BSONObjBuilder builder;
     builder.append(timeField, Date_t::fromMillisSinceEpoch(1000 * roundedSeconds));
@@ -168,8 +210,8 @@ BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
     return get(opCtx->getServiceContext());
 }
 
-BSONObj BucketCatalog::getMetadata(Bucket* ptr) const {
-    BucketAccess bucket{const_cast<BucketCatalog*>(this), ptr};
+BSONObj BucketCatalog::getMetadata(const std::shared_ptr<WriteBatch>& batch) const {
+    BucketAccess bucket{const_cast<BucketCatalog*>(this), batch->bucket(), batch->_stripe};
     if (!bucket) {
         return {};
     }
@@ -204,7 +246,10 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
 
     auto time = timeElem.Date();
 
-    BucketAccess bucket{this, key, options, stats.get(), time};
+    auto stripeNumber = _getStripeNumber(key);
+    auto& stripe = _stripes[stripeNumber];
+
+    BucketAccess bucket{this, key, stripeNumber, options, stats.get(), time};
     invariant(bucket);
 
     NewFieldNames newFieldNamesToBeInserted;
@@ -251,6 +296,9 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     batch->_addMeasurement(doc);
     batch->_recordNewFields(std::move(newFieldNamesToBeInserted));
 
+    bucket->_recordArrival(curTimeMicros64());
+    batch->_avgInterArrivalMicros.store(bucket->_avgInterArrivalMicros);
+
     bucket->_numMeasurements++;
     bucket->_size += sizeToBeAdded;
     if (time > bucket->_latestTime) {
@@ -259,23 +307,43 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     if (bucket->_ns.isEmpty()) {
         // The namespace and metadata only need to be set if this bucket was newly created.
         bucket->_ns = ns;
+        bucket->_timeField = options.getTimeField().toString();
         key.metadata.normalize();
         bucket->_metadata = key.metadata;
 
-        // The namespace is stored two times: the bucket itself and _openBuckets.
+        // The namespace is stored two times: the bucket itself and openBuckets.
         // The metadata is stored two times, normalized and un-normalized. A unique pointer to the
-        // bucket is stored once: _allBuckets. A raw pointer to the bucket is stored at most twice:
-        // _openBuckets, _idleBuckets.
-        bucket->_memoryUsage += (ns.size() * 2) + (bucket->_metadata.toBSON().objsize() * 2) +
+        // bucket is stored once: allBuckets. A raw pointer to the bucket is stored at most twice:
+        // openBuckets, idleBuckets.
+        bucket->_memoryUsage += (ns.size() * 2) + bucket->_timeField.size() +
+            (bucket->_metadata.toBSON().objsize() * 2) +
             sizeof(Bucket) + sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2);
     } else {
-        _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
+        stripe.memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
     }
-    _memoryUsage.fetchAndAdd(bucket->_memoryUsage);
+    stripe.memoryUsage.fetchAndAdd(bucket->_memoryUsage);
 
     return batch;
 }
 
+Microseconds BucketCatalog::getGroupCommitDelay(const std::shared_ptr<WriteBatch>& batch) const {
+    const uint64_t maxDelay = gTimeseriesInsertMaxGroupCommitDelayMicros.load();
+
+    // Only batches shared with other clients, which use the default operation id, can gain
+    // measurements while we wait.
+    if (!maxDelay || batch->_opId != 0) {
+        return Microseconds{0};
+    }
+
+    auto avgInterArrival = batch->_avgInterArrivalMicros.load();
+    if (!avgInterArrival || avgInterArrival >= maxDelay) {
+        return Microseconds{0};
+    }
+
+    return Microseconds{static_cast<long long>(
+        std::min(maxDelay, avgInterArrival * kGroupCommitArrivalsToWaitFor))};
+}
+
 bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
     if (batch->finished()) {
         // In this case, someone else aborted the batch behind our back. Oops.
@@ -284,7 +352,7 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
 
     _waitToCommitBatch(batch);
 
-    BucketAccess bucket(this, batch->bucket(), BucketState::kPrepared);
+    BucketAccess bucket(this, batch->bucket(), batch->_stripe, BucketState::kPrepared);
     if (batch->finished()) {
         // Someone may have aborted it while we were waiting.
         return false;
@@ -295,21 +363,23 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
 
     auto prevMemoryUsage = bucket->_memoryUsage;
     batch->_prepareCommit();
-    _memoryUsage.fetchAndAdd(bucket->_memoryUsage - prevMemoryUsage);
+    _stripes[batch->_stripe].memoryUsage.fetchAndAdd(bucket->_memoryUsage - prevMemoryUsage);
 
     bucket->_batches.erase(batch->_opId);
 
     return true;
 }
 
-void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
+boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
+    std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
     invariant(!batch->finished());
     invariant(!batch->active());
 
     Bucket* ptr(batch->bucket());
+    auto& stripe = _stripes[batch->_stripe];
     batch->_finish(info);
 
-    BucketAccess bucket(this, ptr, BucketState::kNormal);
+    BucketAccess bucket(this, ptr, batch->_stripe, BucketState::kNormal);
     if (bucket) {
         bucket->_preparedBatch.reset();
     }
@@ -327,38 +397,42 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
         bucket->_numCommittedMeasurements += batch->measurements().size();
     }
 
+    boost::optional<ClosedBucket> closedBucket;
     if (!bucket) {
         // It's possible that we cleared the bucket in between preparing the commit and finishing
         // here. In this case, we should abort any other ongoing batches and clear the bucket from
         // the catalog so it's not hanging around idle.
-        auto lk = _lockExclusive();
-        if (_allBuckets.contains(ptr)) {
+        auto lk = stripe.mutex.lockExclusive();
+        if (stripe.allBuckets.contains(ptr)) {
             stdx::unique_lock blk{ptr->_mutex};
             ptr->_preparedBatch.reset();
-            _abort(blk, ptr, nullptr, boost::none);
+            _abort(&stripe, blk, ptr, nullptr, boost::none);
         }
     } else if (bucket->allCommitted()) {
         if (bucket->_full) {
             // Everything in the bucket has been committed, and nothing more will be added since the
             // bucket is full. Thus, we can remove it.
-            _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
+            stripe.memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
+            closedBucket = ClosedBucket{
+                bucket->_id, bucket->_timeField, bucket->_numCommittedMeasurements};
 
             bucket.release();
-            auto lk = _lockExclusive();
+            auto lk = stripe.mutex.lockExclusive();
 
-            // Only remove from _allBuckets and _idleBuckets. If it was marked full, we know that
+            // Only remove from allBuckets and idleBuckets. If it was marked full, we know that
             // happened in BucketAccess::rollover, and that there is already a new open bucket for
             // this metadata.
-            _markBucketNotIdle(ptr, false /* locked */);
+            _markBucketNotIdle(&stripe, ptr, false /* locked */);
             {
-                stdx::lock_guard statesLk{_statesMutex};
-                _bucketStates.erase(ptr->_id);
+                stdx::lock_guard statesLk{stripe.statesMutex};
+                stripe.bucketStates.erase(ptr->_id);
             }
-            _allBuckets.erase(ptr);
+            stripe.allBuckets.erase(ptr);
         } else {
-            _markBucketIdle(bucket);
+            _markBucketIdle(&stripe, bucket);
         }
     }
+    return closedBucket;
 }
 
 void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
@@ -376,42 +450,53 @@ void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
     }
 
     Bucket* bucket = batch->bucket();
+    auto& stripe = _stripes[batch->_stripe];
 
     // Before we access the bucket, make sure it's still there.
-    auto lk = _lockExclusive();
-    if (!_allBuckets.contains(bucket)) {
+    auto lk = stripe.mutex.lockExclusive();
+    if (!stripe.allBuckets.contains(bucket)) {
         // Special case, bucket has already been cleared, and we need only abort this batch.
         batch->_abort(status, false);
         return;
     }
 
     stdx::unique_lock blk{bucket->_mutex};
-    _abort(blk, bucket, batch, status);
+    _abort(&stripe, blk, bucket, batch, status);
 }
 
 void BucketCatalog::clear(const OID& oid) {
-    auto result = _setBucketState(oid, BucketState::kCleared);
-    if (result && *result == BucketState::kPreparedAndCleared) {
-        hangTimeseriesDirectModificationBeforeWriteConflict.pauseWhileSet();
-        throw WriteConflictException();
+    // Only the bucket id is known here, so look for the stripe which owns the bucket. Direct writes
+    // to the buckets collection are rare enough that visiting each stripe is acceptable.
+    for (auto& stripe : _stripes) {
+        auto result = _setBucketState(&stripe, oid, BucketState::kCleared);
+        if (!result) {
+            continue;
+        }
+        if (*result == BucketState::kPreparedAndCleared) {
+            hangTimeseriesDirectModificationBeforeWriteConflict.pauseWhileSet();
+            throw WriteConflictException();
+        }
+        return;
     }
 }
 
 void BucketCatalog::clear(const std::function<bool(const NamespaceString&)>& shouldClear) {
-    auto lk = _lockExclusive();
-    auto statsLk = _statsMutex.lockExclusive();
-
-    for (auto it = _allBuckets.begin(); it != _allBuckets.end();) {
-        auto nextIt = std::next(it);
+    for (auto& stripe : _stripes) {
+        auto lk = stripe.mutex.lockExclusive();
+        auto statsLk = _statsMutex.lockExclusive();
+
+        for (auto it = stripe.allBuckets.begin(); it != stripe.allBuckets.end();) {
+            auto nextIt = std::next(it);
+
+            const auto& bucket = *it;
+            stdx::unique_lock blk{bucket->_mutex};
+            if (shouldClear(bucket->_ns)) {
+                _executionStats.erase(bucket->_ns);
+                _abort(&stripe, blk, bucket.get(), nullptr, boost::none);
+            }
 
-        const auto& bucket = *it;
-        stdx::unique_lock blk{bucket->_mutex};
-        if (shouldClear(bucket->_ns)) {
-            _executionStats.erase(bucket->_ns);
-            _abort(blk, bucket.get(), nullptr, boost::none);
+            it = nextIt;
         }
-
-        it = nextIt;
     }
 }
 
@@ -464,17 +549,16 @@ BucketCatalog::StripedMutex::ExclusiveLock BucketCatalog::StripedMutex::lockExcl
     return ExclusiveLock{*this};
 }
 
-BucketCatalog::StripedMutex::SharedLock BucketCatalog::_lockShared() const {
-    return _bucketMutex.lockShared();
-}
-
-BucketCatalog::StripedMutex::ExclusiveLock BucketCatalog::_lockExclusive() const {
-    return _bucketMutex.lockExclusive();
+std::size_t BucketCatalog::_getStripeNumber(const BucketKey& key) {
+    auto hash = absl::Hash<std::pair<std::size_t, std::size_t>>{}(
+        {absl::Hash<NamespaceString>{}(key.ns),
+         hashMetadataIgnoringFieldOrder(key.metadata.getMetaElement())});
+    return hash % kNumberOfStripes;
 }
 
 void BucketCatalog::_waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch) {
     while (true) {
-        BucketAccess bucket{this, batch->bucket()};
+        BucketAccess bucket{this, batch->bucket(), batch->_stripe};
         if (!bucket) {
             return;
         }
@@ -492,36 +576,37 @@ void BucketCatalog::_waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch)
     }
 }
 
-bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
-    auto it = _allBuckets.find(bucket);
-    if (it == _allBuckets.end()) {
+bool BucketCatalog::_removeBucket(Stripe* stripe, Bucket* bucket, bool expiringBuckets) {
+    auto it = stripe->allBuckets.find(bucket);
+    if (it == stripe->allBuckets.end()) {
         return false;
     }
 
     invariant(bucket->_batches.empty());
     invariant(!bucket->_preparedBatch);
 
-    _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
-    _markBucketNotIdle(bucket, expiringBuckets /* locked */);
-    _removeNonNormalizedKeysForBucket(bucket);
-    _openBuckets.erase({bucket->_ns, bucket->_metadata});
+    stripe->memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
+    _markBucketNotIdle(stripe, bucket, expiringBuckets /* locked */);
+    _removeNonNormalizedKeysForBucket(stripe, bucket);
+    stripe->openBuckets.erase({bucket->_ns, bucket->_metadata});
     {
-        stdx::lock_guard statesLk{_statesMutex};
-        _bucketStates.erase(bucket->_id);
+        stdx::lock_guard statesLk{stripe->statesMutex};
+        stripe->bucketStates.erase(bucket->_id);
     }
-    _allBuckets.erase(it);
+    stripe->allBuckets.erase(it);
 
     return true;
 }
 
-void BucketCatalog::_removeNonNormalizedKeysForBucket(Bucket* bucket) {
+void BucketCatalog::_removeNonNormalizedKeysForBucket(Stripe* stripe, Bucket* bucket) {
     auto comparator = bucket->_metadata.getComparator();
     for (auto&& metadata : bucket->_nonNormalizedKeyMetadatas) {
-        _openBuckets.erase({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
+        stripe->openBuckets.erase({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
     }
 }
 
-void BucketCatalog::_abort(stdx::unique_lock<Mutex>& lk,
+void BucketCatalog::_abort(Stripe* stripe,
+                           stdx::unique_lock<Mutex>& lk,
                            Bucket* bucket,
                            std::shared_ptr<WriteBatch> batch,
                            const boost::optional<Status>& status) {
@@ -548,25 +633,26 @@ void BucketCatalog::_abort(stdx::unique_lock<Mutex>& lk,
 
     lk.unlock();
     if (doRemove) {
-        [[maybe_unused]] bool removed = _removeBucket(bucket, false /* expiringBuckets */);
+        [[maybe_unused]] bool removed =
+            _removeBucket(stripe, bucket, false /* expiringBuckets */);
     }
 }
 
-void BucketCatalog::_markBucketIdle(Bucket* bucket) {
+void BucketCatalog::_markBucketIdle(Stripe* stripe, Bucket* bucket) {
     invariant(bucket);
-    stdx::lock_guard lk{_idleMutex};
-    _idleBuckets.push_front(bucket);
-    bucket->_idleListEntry = _idleBuckets.begin();
+    stdx::lock_guard lk{stripe->idleMutex};
+    stripe->idleBuckets.push_front(bucket);
+    bucket->_idleListEntry = stripe->idleBuckets.begin();
 }
 
-void BucketCatalog::_markBucketNotIdle(Bucket* bucket, bool locked) {
+void BucketCatalog::_markBucketNotIdle(Stripe* stripe, Bucket* bucket, bool locked) {
     invariant(bucket);
     if (bucket->_idleListEntry) {
         stdx::unique_lock<Mutex> guard;
         if (!locked) {
-            guard = stdx::unique_lock{_idleMutex};
+            guard = stdx::unique_lock{stripe->idleMutex};
         }
-        _idleBuckets.erase(*bucket->_idleListEntry);
+        stripe->idleBuckets.erase(*bucket->_idleListEntry);
         bucket->_idleListEntry = boost::none;
     }
 }
@@ -578,38 +664,46 @@ void BucketCatalog::_verifyBucketIsUnused(Bucket* bucket) const {
     stdx::lock_guard<Mutex> lk{bucket->_mutex};
 }
 
-void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats) {
-    // Must hold an exclusive lock on _bucketMutex from outside.
-    stdx::lock_guard lk{_idleMutex};
+void BucketCatalog::_expireIdleBuckets(Stripe* stripe, ExecutionStats* stats) {
+    // Must hold an exclusive lock on the stripe's mutex from outside.
+    stdx::lock_guard lk{stripe->idleMutex};
 
-    // As long as we still need space and have entries, close idle buckets.
-    while (!_idleBuckets.empty() &&
-           _memoryUsage.load() >
+    // As long as we still need space and have entries, close idle buckets. The threshold applies to
+    // the catalog as a whole, but only buckets in this stripe can be closed without taking the
+    // locks of the other stripes.
+    while (!stripe->idleBuckets.empty() &&
+           _memoryUsage() >
                static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold)) {
-        Bucket* bucket = _idleBuckets.back();
+        Bucket* bucket = stripe->idleBuckets.back();
         _verifyBucketIsUnused(bucket);
-        if (_removeBucket(bucket, true /* expiringBuckets */)) {
+        if (_removeBucket(stripe, bucket, true /* expiringBuckets */)) {
             stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
         }
     }
 }
 
-std::size_t BucketCatalog::_numberOfIdleBuckets() const {
-    stdx::lock_guard lk{_idleMutex};
-    return _idleBuckets.size();
+uint64_t BucketCatalog::_memoryUsage() const {
+    uint64_t memoryUsage = 0;
+    for (const auto& stripe : _stripes) {
+        memoryUsage += stripe.memoryUsage.load();
+    }
+    return memoryUsage;
 }
 
-BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
+BucketCatalog::Bucket* BucketCatalog::_allocateBucket(std::size_t stripeNumber,
+                                                      const BucketKey& key,
                                                       const Date_t& time,
                                                       const TimeseriesOptions& options,
                                                       ExecutionStats* stats,
                                                       bool openedDuetoMetadata) {
-    _expireIdleBuckets(stats);
+    auto& stripe = _stripes[stripeNumber];
+    _expireIdleBuckets(&stripe, stats);
 
-    auto [it, inserted] = _allBuckets.insert(std::make_unique<Bucket>());
+    auto [it, inserted] = stripe.allBuckets.insert(std::make_unique<Bucket>());
     Bucket* bucket = it->get();
-    _setIdTimestamp(bucket, time, options);
-    _openBuckets[key] = bucket;
+    bucket->_stripe = stripeNumber;
+    _setIdTimestamp(&stripe, bucket, time, options);
+    stripe.openBuckets[key] = bucket;
 
     if (openedDuetoMetadata) {
         stats->numBucketsOpenedDueToMetadata.fetchAndAddRelaxed(1);
@@ -644,7 +738,8 @@ const std::shared_ptr<BucketCatalog::ExecutionStats> BucketCatalog::_getExecutio
     return kEmptyStats;
 }
 
-void BucketCatalog::_setIdTimestamp(Bucket* bucket,
+void BucketCatalog::_setIdTimestamp(Stripe* stripe,
+                                    Bucket* bucket,
                                     const Date_t& time,
                                     const TimeseriesOptions& options) {
     auto roundedTime = timeseries::roundTimestampToGranularity(time, options.getGranularity());
@@ -656,15 +751,16 @@ void BucketCatalog::_setIdTimestamp(Bucket* bucket,
     bucket->_minmax.update(
         controlDoc, bucket->_metadata.getMetaField(), bucket->_metadata.getComparator());
 
-    stdx::lock_guard statesLk{_statesMutex};
-    _bucketStates.emplace(bucket->_id, BucketState::kNormal);
+    stdx::lock_guard statesLk{stripe->statesMutex};
+    stripe->bucketStates.emplace(bucket->_id, BucketState::kNormal);
 }
 
-boost::optional<BucketCatalog::BucketState> BucketCatalog::_setBucketState(const OID& id,
+boost::optional<BucketCatalog::BucketState> BucketCatalog::_setBucketState(Stripe* stripe,
+                                                                           const OID& id,
                                                                            BucketState target) {
-    stdx::lock_guard statesLk{_statesMutex};
-    auto it = _bucketStates.find(id);
-    if (it == _bucketStates.end()) {
+    stdx::lock_guard statesLk{stripe->statesMutex};
+    auto it = stripe->bucketStates.find(id);
+    if (it == stripe->bucketStates.end()) {
         return boost::none;
     }
 
@@ -804,6 +900,17 @@ bool BucketCatalog::Bucket::allCommitted() const {
     return _batches.empty() && !_preparedBatch;
 }
 
+void BucketCatalog::Bucket::_recordArrival(uint64_t nowMicros) {
+    if (_lastArrivalMicros && nowMicros >= _lastArrivalMicros) {
+        // Samples are at least one microsecond so that an average of zero means 'unknown'.
+        auto sample = std::clamp<uint64_t>(
+            nowMicros - _lastArrivalMicros, 1, kMaxInterArrivalSampleMicros);
+        _avgInterArrivalMicros =
+            _avgInterArrivalMicros ? (_avgInterArrivalMicros * 7 + sample) / 8 : sample;
+    }
+    _lastArrivalMicros = nowMicros;
+}
+
 std::shared_ptr<BucketCatalog::WriteBatch> BucketCatalog::Bucket::_activeBatch(
     OperationId opId, const std::shared_ptr<ExecutionStats>& stats) {
     auto it = _batches.find(opId);
@@ -815,10 +922,17 @@ std::shared_ptr<BucketCatalog::WriteBatch> BucketCatalog::Bucket::_activeBatch(
 
 BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           BucketKey& key,
+                                          std::size_t stripe,
                                           const TimeseriesOptions& options,
                                           ExecutionStats* stats,
                                           const Date_t& time)
-    : _catalog(catalog), _key(&key), _options(&options), _stats(stats), _time(&time) {
+    : _catalog(catalog),
+      _stripeNumber(stripe),
+      _stripe(&catalog->_stripes[stripe]),
+      _key(&key),
+      _options(&options),
+      _stats(stats),
+      _time(&time) {
 
     auto bucketFound = [](BucketState bucketState) {
         return bucketState == BucketState::kNormal || bucketState == BucketState::kPrepared;
@@ -872,18 +986,19 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
         ? key.withCopiedMetadata(nonNormalizedMetadata.wrap())
         : key.withCopiedMetadata(BSONObj());
     hashedKey.key = &originalBucketKey;
-    auto lk = _catalog->_lockExclusive();
+    auto lk = _stripe->mutex.lockExclusive();
     _findOrCreateOpenBucketThenLock(hashedNormalizedKey, hashedKey);
 }
 
 BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           Bucket* bucket,
+                                          std::size_t stripe,
                                           boost::optional<BucketState> targetState)
-    : _catalog(catalog) {
+    : _catalog(catalog), _stripeNumber(stripe), _stripe(&catalog->_stripes[stripe]) {
     {
-        auto lk = _catalog->_lockShared();
-        auto bucketIt = _catalog->_allBuckets.find(bucket);
-        if (bucketIt == _catalog->_allBuckets.end()) {
+        auto lk = _stripe->mutex.lockShared();
+        auto bucketIt = _stripe->allBuckets.find(bucket);
+        if (bucketIt == _stripe->allBuckets.end()) {
             return;
         }
 
@@ -894,11 +1009,11 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
     boost::optional<BucketState> state{BucketState::kCleared};
     if (targetState) {
         invariant(*targetState == BucketState::kNormal || *targetState == BucketState::kPrepared);
-        state = _catalog->_setBucketState(_bucket->_id, *targetState);
+        state = _catalog->_setBucketState(_stripe, _bucket->_id, *targetState);
     } else {
-        stdx::lock_guard statesLk{_catalog->_statesMutex};
-        auto statesIt = _catalog->_bucketStates.find(_bucket->_id);
-        if (statesIt != _catalog->_bucketStates.end()) {
+        stdx::lock_guard statesLk{_stripe->statesMutex};
+        auto statesIt = _stripe->bucketStates.find(_bucket->_id);
+        if (statesIt != _stripe->bucketStates.end()) {
             state = statesIt->second;
         }
     }
@@ -916,9 +1031,9 @@ BucketCatalog::BucketAccess::~BucketAccess() {
 BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLock(
     const HashedBucketKey& key) {
     {
-        auto lk = _catalog->_lockShared();
-        auto it = _catalog->_openBuckets.find(key);
-        if (it == _catalog->_openBuckets.end()) {
+        auto lk = _stripe->mutex.lockShared();
+        auto it = _stripe->openBuckets.find(key);
+        if (it == _stripe->openBuckets.end()) {
             // Bucket does not exist.
             return BucketState::kCleared;
         }
@@ -936,9 +1051,9 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLockA
     BSONObj nonNormalizedMetadata) {
     invariant(!isLocked());
     {
-        auto lk = _catalog->_lockExclusive();
-        auto it = _catalog->_openBuckets.find(normalizedKey);
-        if (it == _catalog->_openBuckets.end()) {
+        auto lk = _stripe->mutex.lockExclusive();
+        auto it = _stripe->openBuckets.find(normalizedKey);
+        if (it == _stripe->openBuckets.end()) {
             // Bucket does not exist.
             return BucketState::kCleared;
         }
@@ -950,10 +1065,10 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLockA
         if (_bucket->_nonNormalizedKeyMetadatas.size() <
             _bucket->_nonNormalizedKeyMetadatas.capacity()) {
             auto [_, inserted] =
-                _catalog->_openBuckets.insert(std::make_pair(nonNormalizedKey, _bucket));
+                _stripe->openBuckets.insert(std::make_pair(nonNormalizedKey, _bucket));
             if (inserted) {
                 _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedMetadata);
-                // Increment the memory usage to store this key and value in _openBuckets
+                // Increment the memory usage to store this key and value in openBuckets
                 _bucket->_memoryUsage += nonNormalizedKey.key->ns.size() +
                     nonNormalizedMetadata.objsize() + sizeof(_bucket);
             }
@@ -964,14 +1079,14 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLockA
 }
 
 BucketCatalog::BucketState BucketCatalog::BucketAccess::_confirmStateForAcquiredBucket() {
-    stdx::lock_guard statesLk{_catalog->_statesMutex};
-    auto statesIt = _catalog->_bucketStates.find(_bucket->_id);
-    invariant(statesIt != _catalog->_bucketStates.end());
+    stdx::lock_guard statesLk{_stripe->statesMutex};
+    auto statesIt = _stripe->bucketStates.find(_bucket->_id);
+    invariant(statesIt != _stripe->bucketStates.end());
     auto& [_, state] = *statesIt;
     if (state == BucketState::kCleared || state == BucketState::kPreparedAndCleared) {
         release();
     } else {
-        _catalog->_markBucketNotIdle(_bucket, false /* locked */);
+        _catalog->_markBucketNotIdle(_stripe, _bucket, false /* locked */);
     }
 
     return state;
@@ -979,8 +1094,8 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_confirmStateForAcquired
 
 void BucketCatalog::BucketAccess::_findOrCreateOpenBucketThenLock(
     const HashedBucketKey& normalizedKey, const HashedBucketKey& nonNormalizedKey) {
-    auto it = _catalog->_openBuckets.find(normalizedKey);
-    if (it == _catalog->_openBuckets.end()) {
+    auto it = _stripe->openBuckets.find(normalizedKey);
+    if (it == _stripe->openBuckets.end()) {
         // No open bucket for this metadata.
         _create(normalizedKey, nonNormalizedKey);
         return;
@@ -990,17 +1105,17 @@ void BucketCatalog::BucketAccess::_findOrCreateOpenBucketThenLock(
     _acquire();
 
     {
-        stdx::lock_guard statesLk{_catalog->_statesMutex};
-        auto statesIt = _catalog->_bucketStates.find(_bucket->_id);
-        invariant(statesIt != _catalog->_bucketStates.end());
+        stdx::lock_guard statesLk{_stripe->statesMutex};
+        auto statesIt = _stripe->bucketStates.find(_bucket->_id);
+        invariant(statesIt != _stripe->bucketStates.end());
         auto& [_, state] = *statesIt;
         if (state == BucketState::kNormal || state == BucketState::kPrepared) {
-            _catalog->_markBucketNotIdle(_bucket, false /* locked */);
+            _catalog->_markBucketNotIdle(_stripe, _bucket, false /* locked */);
             return;
         }
     }
 
-    _catalog->_abort(_guard, _bucket, nullptr, boost::none);
+    _catalog->_abort(_stripe, _guard, _bucket, nullptr, boost::none);
     _create(normalizedKey, nonNormalizedKey);
 }
 
@@ -1013,9 +1128,9 @@ void BucketCatalog::BucketAccess::_create(const HashedBucketKey& normalizedKey,
                                           const HashedBucketKey& nonNormalizedKey,
                                           bool openedDuetoMetadata) {
     invariant(_options);
-    _bucket =
-        _catalog->_allocateBucket(normalizedKey, *_time, *_options, _stats, openedDuetoMetadata);
-    _catalog->_openBuckets[nonNormalizedKey] = _bucket;
+    _bucket = _catalog->_allocateBucket(
+        _stripeNumber, normalizedKey, *_time, *_options, _stats, openedDuetoMetadata);
+    _stripe->openBuckets[nonNormalizedKey] = _bucket;
     _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedKey.key->metadata.toBSON());
     _acquire();
 }
@@ -1059,7 +1174,7 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
                                       : _key->withCopiedMetadata(BSONObj());
     auto hashedKey = BucketHasher{}.hashed_key(prevBucketKey);
 
-    auto lk = _catalog->_lockExclusive();
+    auto lk = _stripe->mutex.lockExclusive();
     _findOrCreateOpenBucketThenLock(hashedNormalizedKey, hashedKey);
 
     // Recheck if still full now that we've reacquired the bucket.
@@ -1072,14 +1187,15 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
             // remove it now. Otherwise, we must keep the bucket around until it is committed.
             oldBucket = _bucket;
             release();
-            bool removed = _catalog->_removeBucket(oldBucket, false /* expiringBuckets */);
+            bool removed =
+                _catalog->_removeBucket(_stripe, oldBucket, false /* expiringBuckets */);
             invariant(removed);
         } else {
             _bucket->_full = true;
 
             // We will recreate a new bucket for the same key below. We also need to cleanup all
             // extra metadata keys added for the old bucket instance.
-            _catalog->_removeNonNormalizedKeysForBucket(_bucket);
+            _catalog->_removeNonNormalizedKeysForBucket(_stripe, _bucket);
             release();
         }
 
@@ -1094,7 +1210,7 @@ Date_t BucketCatalog::BucketAccess::getTime() const {
 BucketCatalog::WriteBatch::WriteBatch(Bucket* bucket,
                                       OperationId opId,
                                       const std::shared_ptr<ExecutionStats>& stats)
-    : _bucket{bucket}, _opId(opId), _stats{stats} {}
+    : _bucket{bucket}, _stripe{bucket->_stripe}, _opId(opId), _stats{stats} {}
 
 bool BucketCatalog::WriteBatch::claimCommitRights() {
     return !_commitRights.swap(true);
@@ -1249,16 +1365,42 @@ public:
             }
         }
 
-        auto lk = bucketCatalog._lockShared();
+        long long numBuckets = 0;
+        long long numOpenBuckets = 0;
+        long long numIdleBuckets = 0;
+        long long memoryUsage = 0;
+        BSONArrayBuilder stripesBuilder;
+        for (const auto& stripe : bucketCatalog._stripes) {
+            long long stripeNumBuckets;
+            long long stripeNumOpenBuckets;
+            long long stripeNumIdleBuckets;
+            {
+                auto lk = stripe.mutex.lockShared();
+                stripeNumBuckets = stripe.allBuckets.size();
+                stripeNumOpenBuckets = stripe.openBuckets.size();
+                stdx::lock_guard idleLk{stripe.idleMutex};
+                stripeNumIdleBuckets = stripe.idleBuckets.size();
+            }
+            auto stripeMemoryUsage = static_cast<long long>(stripe.memoryUsage.load());
+
+            BSONObjBuilder stripeBuilder(stripesBuilder.subobjStart());
+            stripeBuilder.appendNumber("numBuckets", stripeNumBuckets);
+            stripeBuilder.appendNumber("numOpenBuckets", stripeNumOpenBuckets);
+            stripeBuilder.appendNumber("numIdleBuckets", stripeNumIdleBuckets);
+            stripeBuilder.appendNumber("memoryUsage", stripeMemoryUsage);
+
+            numBuckets += stripeNumBuckets;
+            numOpenBuckets += stripeNumOpenBuckets;
+            numIdleBuckets += stripeNumIdleBuckets;
+            memoryUsage += stripeMemoryUsage;
+        }
+
         BSONObjBuilder builder;
-        builder.appendNumber("numBuckets",
-                             static_cast<long long>(bucketCatalog._allBuckets.size()));
-        builder.appendNumber("numOpenBuckets",
-                             static_cast<long long>(bucketCatalog._openBuckets.size()));
-        builder.appendNumber("numIdleBuckets",
-                             static_cast<long long>(bucketCatalog._numberOfIdleBuckets()));
-        builder.appendNumber("memoryUsage",
-                             static_cast<long long>(bucketCatalog._memoryUsage.load()));
+        builder.appendNumber("numBuckets", numBuckets);
+        builder.appendNumber("numOpenBuckets", numOpenBuckets);
+        builder.appendNumber("numIdleBuckets", numIdleBuckets);
+        builder.appendNumber("memoryUsage", memoryUsage);
+        builder.append("stripes", stripesBuilder.arr());
         return builder.obj();
     }
 } bucketCatalogServerStatus;
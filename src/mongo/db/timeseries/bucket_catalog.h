@@ -149,6 +149,11 @@ public:
 
 
         Bucket* _bucket;
+
+        // The catalog stripe which owns '_bucket'. It is recorded at creation so that the bucket
+        // can be looked up again without dereferencing '_bucket', which may have been removed.
+        std::size_t _stripe;
+
         OperationId _opId;
         std::shared_ptr<ExecutionStats> _stats;
 
@@ -160,10 +165,24 @@ public:
 
         bool _active = true;
 
+        // The bucket's average time between arriving measurements as of the latest insert into
+        // this batch, in microseconds. Zero if not known yet.
+        AtomicWord<uint64_t> _avgInterArrivalMicros{0};
+
         AtomicWord<bool> _commitRights{false};
         SharedPromise<CommitInfo> _promise;
     };
 
+    /**
+     * Return type for the finish function. Describes a bucket which was closed and removed from the
+     * catalog once all of its measurements were committed.
+     */
+    struct ClosedBucket {
+        OID bucketId;
+        std::string timeField;
+        uint32_t numMeasurements;
+    };
+
     static BucketCatalog& get(ServiceContext* svcCtx);
     static BucketCatalog& get(OperationContext* opCtx);
 
@@ -173,14 +192,14 @@ public:
     BucketCatalog operator=(const BucketCatalog&) = delete;
 
     /**
-     * Returns the metadata for the given bucket in the following format:
+     * Returns the metadata for the bucket of the given batch in the following format:
      *     {<metadata field name>: <value>}
      * All measurements in the given bucket share same metadata value.
      *
      * Returns an empty document if the given bucket cannot be found or if this time-series
      * collection was not created with a metadata field name.
      */
-    BSONObj getMetadata(Bucket* bucket) const;
+    BSONObj getMetadata(const std::shared_ptr<WriteBatch>& batch) const;
 
     /**
      * Returns the WriteBatch into which the document was inserted. Any caller who receives the same
@@ -195,6 +214,16 @@ public:
         const BSONObj& doc,
         CombineWithInsertsFromOtherClients combine);
 
+    /**
+     * Returns how long the holder of commit rights on the given batch should wait before preparing
+     * it, so that concurrent inserts from other clients can join the batch and be written by the
+     * same bucket update. The delay is bounded by 'timeseriesInsertMaxGroupCommitDelayMicros' and
+     * adapts to the rate at which measurements arrive in the bucket. It is zero when no other
+     * measurement is expected within the bound, or if the batch cannot be combined with inserts
+     * from other clients.
+     */
+    Microseconds getGroupCommitDelay(const std::shared_ptr<WriteBatch>& batch) const;
+
     /**
      * Prepares a batch for commit, transitioning it to an inactive state. Caller must already have
      * commit rights on batch. Returns true if the batch was successfully prepared, or false if the
@@ -204,9 +233,11 @@ public:
 
     /**
      * Records the result of a batch commit. Caller must already have commit rights on batch, and
-     * batch must have been previously prepared.
+     * batch must have been previously prepared. Returns the bucket if committing this batch closed
+     * it, in which case no further writes will be made to it by the catalog.
      */
-    void finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info);
+    boost::optional<ClosedBucket> finish(std::shared_ptr<WriteBatch> batch,
+                                         const CommitInfo& info);
 
     /**
      * Aborts the given write batch and any other outstanding batches on the same bucket. Caller
@@ -369,15 +400,27 @@ public:
         std::shared_ptr<WriteBatch> _activeBatch(OperationId opId,
                                                  const std::shared_ptr<ExecutionStats>& stats);
 
+        /**
+         * Updates the average time between arriving measurements with a measurement arriving at
+         * the given time, as returned by curTimeMicros64().
+         */
+        void _recordArrival(uint64_t nowMicros);
+
         // Access to the bucket is controlled by this lock
         mutable Mutex _mutex;
 
         // The bucket ID for the underlying document
         OID _id = OID::gen();
 
+        // The catalog stripe this bucket belongs to.
+        std::size_t _stripe = 0;
+
         // The namespace that this bucket is used for.
         NamespaceString _ns;
 
+        // The name of the time field of the time-series collection this bucket belongs to.
+        std::string _timeField;
+
         // The metadata of the data that this bucket contains.
         BucketMetadata _metadata;
 
@@ -410,6 +453,13 @@ public:
         // range.
         bool _full = false;
 
+        // Exponentially weighted moving average of the time between measurements arriving in the
+        // bucket, in microseconds. Zero until a second measurement arrives.
+        uint64_t _avgInterArrivalMicros = 0;
+
+        // The time at which the latest measurement arrived, in microseconds.
+        uint64_t _lastArrivalMicros = 0;
+
         // The batch that has been prepared and is currently in the process of being committed, if
         // any.
         std::shared_ptr<WriteBatch> _preparedBatch;
@@ -417,7 +467,7 @@ public:
         // Batches, per operation, that haven't been committed or aborted yet.
         stdx::unordered_map<OperationId, std::shared_ptr<WriteBatch>> _batches;
 
-        // If the bucket is in _idleBuckets, then its position is recorded here.
+        // If the bucket is in its stripe's idleBuckets, then its position is recorded here.
         boost::optional<IdleList::iterator> _idleListEntry = boost::none;
 
         // Approximate memory usage of this bucket.
@@ -536,6 +586,53 @@ private:
         }
     };
 
+    /**
+     * An independent partition of the catalog. Each bucket lives in exactly one stripe, chosen by
+     * hashing its BucketKey in a way that does not depend on the field order of the metadata, so
+     * that the normalized and non-normalized keys for a bucket always map to the same stripe.
+     * Writers to series in different stripes never contend on the same catalog locks.
+     *
+     * You must hold a lock on 'mutex' when accessing 'allBuckets' or 'openBuckets'. While holding
+     * a lock on 'mutex', you can take a lock on an individual bucket, then release 'mutex'. Any
+     * iterators on the protected structures should be considered invalid once the lock is
+     * released. Any subsequent access to the structures requires relocking 'mutex'. You must *not*
+     * be holding a lock on a bucket when you attempt to acquire the lock on 'mutex', as this can
+     * result in deadlock.
+     *
+     * The StripedMutex class has both shared (read-only) and exclusive (write) locks. If you are
+     * going to write to any of the protected structures, you must hold an exclusive lock.
+     *
+     * Typically, if you want to acquire a bucket, you should use the BucketAccess RAII class to do
+     * so, as it will take care of most of this logic for you. Only use 'mutex' directly for more
+     * global maintenance where you want to take the lock once and interact with multiple buckets
+     * atomically.
+     */
+    struct Stripe {
+        mutable StripedMutex mutex;
+
+        // All buckets currently in the stripe, including buckets which are full but not yet
+        // committed.
+        stdx::unordered_set<std::unique_ptr<Bucket>> allBuckets;
+
+        // The current open bucket for each namespace and metadata pair.
+        stdx::unordered_map<BucketKey, Bucket*, BucketHasher, BucketEq> openBuckets;
+
+        // Bucket state
+        mutable Mutex statesMutex = MONGO_MAKE_LATCH("BucketCatalog::Stripe::statesMutex");
+        stdx::unordered_map<OID, BucketState, OID::Hasher> bucketStates;
+
+        // This mutex protects access to idleBuckets
+        mutable Mutex idleMutex = MONGO_MAKE_LATCH("BucketCatalog::Stripe::idleMutex");
+
+        // Buckets that do not have any writers.
+        IdleList idleBuckets;
+
+        // Approximate memory usage of the buckets in the stripe.
+        AtomicWord<uint64_t> memoryUsage;
+    };
+
+    static constexpr std::size_t kNumberOfStripes = 32;
+
     /**
      * Helper class to handle all the locking necessary to lookup and lock a bucket for use. This
      * is intended primarily for using a single bucket, including replacing it when it becomes full.
@@ -547,11 +644,13 @@ private:
         BucketAccess() = delete;
         BucketAccess(BucketCatalog* catalog,
                      BucketKey& key,
+                     std::size_t stripe,
                      const TimeseriesOptions& options,
                      ExecutionStats* stats,
                      const Date_t& time);
         BucketAccess(BucketCatalog* catalog,
                      Bucket* bucket,
+                     std::size_t stripe,
                      boost::optional<BucketState> targetState = boost::none);
         ~BucketAccess();
 
@@ -577,14 +676,14 @@ private:
     private:
         /**
          * Helper to find and lock an open bucket for the given metadata if it exists. Takes a
-         * shared lock on the catalog. Returns the state of the bucket if it is locked and usable.
+         * shared lock on the stripe. Returns the state of the bucket if it is locked and usable.
          * In case the bucket does not exist or was previously cleared and thus is not usable, the
          * return value will be BucketState::kCleared.
          */
         BucketState _findOpenBucketThenLock(const HashedBucketKey& key);
 
         /**
-         * Same as _findOpenBucketThenLock above but takes an exclusive lock on the catalog. In
+         * Same as _findOpenBucketThenLock above but takes an exclusive lock on the stripe. In
          * addition to finding the bucket it also store a non-normalized key if there are available
          * slots in the bucket.
          */
@@ -600,7 +699,7 @@ private:
         BucketState _confirmStateForAcquiredBucket();
 
         // Helper to find an open bucket for the given metadata if it exists, create it if it
-        // doesn't, and lock it. Requires an exclusive lock on the catalog.
+        // doesn't, and lock it. Requires an exclusive lock on the stripe.
         void _findOrCreateOpenBucketThenLock(const HashedBucketKey& normalizedKey,
                                              const HashedBucketKey& key);
 
@@ -614,6 +713,8 @@ private:
                      bool openedDuetoMetadata = true);
 
         BucketCatalog* _catalog;
+        std::size_t _stripeNumber;
+        Stripe* _stripe;
         BucketKey* _key = nullptr;
         const TimeseriesOptions* _options = nullptr;
         ExecutionStats* _stats = nullptr;
@@ -625,27 +726,30 @@ private:
 
     class ServerStatus;
 
-    StripedMutex::SharedLock _lockShared() const;
-    StripedMutex::ExclusiveLock _lockExclusive() const;
+    /**
+     * Returns the stripe which owns the buckets for the given key.
+     */
+    static std::size_t _getStripeNumber(const BucketKey& key);
 
     void _waitToCommitBatch(const std::shared_ptr<WriteBatch>& batch);
 
     /**
-     * Removes the given bucket from the bucket catalog's internal data structures.
+     * Removes the given bucket from the stripe's internal data structures.
      */
-    bool _removeBucket(Bucket* bucket, bool expiringBuckets);
+    bool _removeBucket(Stripe* stripe, Bucket* bucket, bool expiringBuckets);
 
     /**
      * Removes extra non-normalized BucketKey's for the given bucket from the
-     * bucket catalog's internal data structures.
+     * stripe's internal data structures.
      */
-    void _removeNonNormalizedKeysForBucket(Bucket* bucket);
+    void _removeNonNormalizedKeysForBucket(Stripe* stripe, Bucket* bucket);
 
     /**
      * Aborts any batches it can for the given bucket, then removes the bucket. If batch is
      * non-null, it is assumed that the caller has commit rights for that batch.
      */
-    void _abort(stdx::unique_lock<Mutex>& lk,
+    void _abort(Stripe* stripe,
+                stdx::unique_lock<Mutex>& lk,
                 Bucket* bucket,
                 std::shared_ptr<WriteBatch> batch,
                 const boost::optional<Status>& status);
@@ -653,13 +757,13 @@ private:
     /**
      * Adds the bucket to a list of idle buckets to be expired at a later date
      */
-    void _markBucketIdle(Bucket* bucket);
+    void _markBucketIdle(Stripe* stripe, Bucket* bucket);
 
     /**
-     * Remove the bucket from the list of idle buckets. The second parameter encodes whether the
-     * caller holds a lock on _idleMutex.
+     * Remove the bucket from the list of idle buckets. The third parameter encodes whether the
+     * caller holds a lock on the stripe's idleMutex.
      */
-    void _markBucketNotIdle(Bucket* bucket, bool locked);
+    void _markBucketNotIdle(Stripe* stripe, Bucket* bucket, bool locked);
 
     /**
      * Verify the bucket is currently unused by taking a lock on it. Must hold exclusive lock from
@@ -668,14 +772,19 @@ private:
     void _verifyBucketIsUnused(Bucket* bucket) const;
 
     /**
-     * Expires idle buckets until the bucket catalog's memory usage is below the expiry threshold.
+     * Expires idle buckets in the given stripe until the bucket catalog's memory usage is below
+     * the expiry threshold or the stripe has no idle buckets left.
      */
-    void _expireIdleBuckets(ExecutionStats* stats);
+    void _expireIdleBuckets(Stripe* stripe, ExecutionStats* stats);
 
-    std::size_t _numberOfIdleBuckets() const;
+    /**
+     * Returns the approximate memory usage of the bucket catalog, summed over all stripes.
+     */
+    uint64_t _memoryUsage() const;
 
-    // Allocate a new bucket (and ID) and add it to the catalog
-    Bucket* _allocateBucket(const BucketKey& key,
+    // Allocate a new bucket (and ID) and add it to the given stripe
+    Bucket* _allocateBucket(std::size_t stripeNumber,
+                            const BucketKey& key,
                             const Date_t& time,
                             const TimeseriesOptions& options,
                             ExecutionStats* stats,
@@ -684,51 +793,25 @@ private:
     std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns);
     const std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns) const;
 
-    void _setIdTimestamp(Bucket* bucket, const Date_t& time, const TimeseriesOptions& options);
+    void _setIdTimestamp(Stripe* stripe,
+                         Bucket* bucket,
+                         const Date_t& time,
+                         const TimeseriesOptions& options);
 
     /**
      * Changes the bucket state, taking into account the current state, the specified target state,
      * and allowed state transitions. The return value, if set, is the final state of the bucket
-     * with the given id; if no such bucket exists, the return value will not be set.
+     * with the given id; if no such bucket exists in the stripe, the return value will not be set.
      *
      * Ex. For a bucket with state kPrepared, and a target of kCleared, the return will be
      * kPreparedAndCleared.
      */
-    boost::optional<BucketState> _setBucketState(const OID& id, BucketState target);
+    boost::optional<BucketState> _setBucketState(Stripe* stripe,
+                                                 const OID& id,
+                                                 BucketState target);
 
-    /**
-     * You must hold a lock on _bucketMutex when accessing _allBuckets or _openBuckets.
-     * While holding a lock on _bucketMutex, you can take a lock on an individual bucket, then
-     * release _bucketMutex. Any iterators on the protected structures should be considered invalid
-     * once the lock is released. Any subsequent access to the structures requires relocking
-     * _bucketMutex. You must *not* be holding a lock on a bucket when you attempt to acquire the
-     * lock on _mutex, as this can result in deadlock.
-     *
-     * The StripedMutex class has both shared (read-only) and exclusive (write) locks. If you are
-     * going to write to any of the protected structures, you must hold an exclusive lock.
-     *
-     * Typically, if you want to acquire a bucket, you should use the BucketAccess RAII
-     * class to do so, as it will take care of most of this logic for you. Only use the _bucketMutex
-     * directly for more global maintenance where you want to take the lock once and interact with
-     * multiple buckets atomically.
-     */
-    mutable StripedMutex _bucketMutex;
-
-    // All buckets currently in the catalog, including buckets which are full but not yet committed.
-    stdx::unordered_set<std::unique_ptr<Bucket>> _allBuckets;
-
-    // The current open bucket for each namespace and metadata pair.
-    stdx::unordered_map<BucketKey, Bucket*, BucketHasher, BucketEq> _openBuckets;
-
-    // Bucket state
-    mutable Mutex _statesMutex = MONGO_MAKE_LATCH("BucketCatalog::_statesMutex");
-    stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
-
-    // This mutex protects access to _idleBuckets
-    mutable Mutex _idleMutex = MONGO_MAKE_LATCH("BucketCatalog::_idleMutex");
-
-    // Buckets that do not have any writers.
-    IdleList _idleBuckets;
+    // The independent partitions of the catalog, see Stripe.
+    std::array<Stripe, kNumberOfStripes> _stripes;
 
     /**
      * This mutex protects access to the _executionStats map. Once you complete your lookup, you
@@ -745,8 +828,5 @@ private:
 
     // Counter for buckets created by the bucket catalog.
     uint64_t _bucketNum = 0;
-
-    // Approximate memory usage of the bucket catalog.
-    AtomicWord<uint64_t> _memoryUsage;
 };
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -235,9 +236,8 @@ TEST_F(BucketCatalogTest, GetMetadataReturnsEmptyDocOnMissingBucket) {
                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
                      .getValue();
     ASSERT(batch->claimCommitRights());
-    auto bucket = batch->bucket();
     _bucketCatalog->abort(batch);
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucket));
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch));
 }
 
 TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
@@ -270,10 +270,10 @@ TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
 
     // Check metadata in buckets.
     ASSERT_BSONOBJ_EQ(BSON(_metaField << "123"),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj()),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
-    ASSERT(_bucketCatalog->getMetadata(result3.getValue()->bucket()).isEmpty());
+                      _bucketCatalog->getMetadata(result2.getValue()));
+    ASSERT(_bucketCatalog->getMetadata(result3.getValue()).isEmpty());
 
     // Committing one bucket should only return the one document in that bucket and should not
     // affect the other bucket.
@@ -302,9 +302,9 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketArray) {
 
     // Check metadata in buckets.
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSON_ARRAY(BSON("a" << 0 << "b" << 1))),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSON_ARRAY(BSON("a" << 0 << "b" << 1))),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result2.getValue()));
 }
 
 TEST_F(BucketCatalogTest, InsertIntoSameBucketObjArray) {
@@ -333,11 +333,11 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketObjArray) {
     ASSERT_BSONOBJ_EQ(
         BSON(_metaField << BSONObj(BSON(
                  "c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1) << BSON("f" << 1 << "g" << 0))))),
-        _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+        _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(
         BSON(_metaField << BSONObj(BSON(
                  "c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1) << BSON("f" << 1 << "g" << 0))))),
-        _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+        _bucketCatalog->getMetadata(result2.getValue()));
 }
 
 
@@ -369,11 +369,89 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucketNestedArray) {
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj(BSON("c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1)
                                                                         << BSON_ARRAY("123"
                                                                                       << "456"))))),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result1.getValue()));
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj(BSON("c" << BSON_ARRAY(BSON("a" << 0 << "b" << 1)
                                                                         << BSON_ARRAY("123"
                                                                                       << "456"))))),
-                      _bucketCatalog->getMetadata(result2.getValue()->bucket()));
+                      _bucketCatalog->getMetadata(result2.getValue()));
+}
+
+TEST_F(BucketCatalogTest, InsertManySeriesIntoDistinctBuckets) {
+    // Enough series to populate every stripe of the catalog, each inserted twice with a different
+    // field order so that both lookups must resolve to the same stripe.
+    static constexpr int kNumSeries = 200;
+    std::vector<std::shared_ptr<BucketCatalog::WriteBatch>> batches;
+    for (int i = 0; i < kNumSeries; ++i) {
+        auto result = _bucketCatalog->insert(
+            _opCtx,
+            _ns1,
+            _getCollator(_ns1),
+            _getTimeseriesOptions(_ns1),
+            BSON(_timeField << Date_t::now() << _metaField << BSON("a" << i << "b" << 0)),
+            BucketCatalog::CombineWithInsertsFromOtherClients::kAllow);
+        batches.push_back(result.getValue());
+    }
+    for (int i = 0; i < kNumSeries; ++i) {
+        auto result = _bucketCatalog->insert(
+            _opCtx,
+            _ns1,
+            _getCollator(_ns1),
+            _getTimeseriesOptions(_ns1),
+            BSON(_timeField << Date_t::now() << _metaField << BSON("b" << 0 << "a" << i)),
+            BucketCatalog::CombineWithInsertsFromOtherClients::kAllow);
+        ASSERT_EQ(batches[i], result.getValue());
+    }
+
+    std::set<BucketCatalog::Bucket*> buckets;
+    for (const auto& batch : batches) {
+        buckets.insert(batch->bucket());
+    }
+    ASSERT_EQ(buckets.size(), static_cast<size_t>(kNumSeries));
+
+    for (int i = 0; i < kNumSeries; ++i) {
+        ASSERT_BSONOBJ_EQ(BSON(_metaField << BSON("a" << i << "b" << 0)),
+                          _bucketCatalog->getMetadata(batches[i]));
+        _commit(batches[i], 0, 2);
+    }
+}
+
+TEST_F(BucketCatalogTest, GroupCommitDelayAdaptsToArrivals) {
+    static constexpr int kMaxDelayMicros = 100 * 1000;
+    RAIIServerParameterControllerForTest controller{"timeseriesInsertMaxGroupCommitDelayMicros",
+                                                    kMaxDelayMicros};
+    auto insert = [&](BucketCatalog::CombineWithInsertsFromOtherClients combine) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << Date_t::now()),
+                     combine)
+            .getValue();
+    };
+
+    // A single measurement does not tell us how often measurements arrive.
+    auto batch = insert(BucketCatalog::CombineWithInsertsFromOtherClients::kAllow);
+    ASSERT_EQ(Microseconds{0}, _bucketCatalog->getGroupCommitDelay(batch));
+
+    ASSERT_EQ(batch, insert(BucketCatalog::CombineWithInsertsFromOtherClients::kAllow));
+    auto delay = _bucketCatalog->getGroupCommitDelay(batch);
+    ASSERT_GT(delay, Microseconds{0});
+    ASSERT_LTE(delay, Microseconds{kMaxDelayMicros});
+
+    // Batches private to an operation cannot gain measurements from other clients.
+    auto privateBatch = insert(BucketCatalog::CombineWithInsertsFromOtherClients::kDisallow);
+    ASSERT_NE(batch, privateBatch);
+    ASSERT_EQ(Microseconds{0}, _bucketCatalog->getGroupCommitDelay(privateBatch));
+
+    {
+        RAIIServerParameterControllerForTest disabled{"timeseriesInsertMaxGroupCommitDelayMicros",
+                                                      0};
+        ASSERT_EQ(Microseconds{0}, _bucketCatalog->getGroupCommitDelay(batch));
+    }
+
+    _commit(batch, 0, 2);
+    _commit(privateBatch, 2);
 }
 
 TEST_F(BucketCatalogTest, InsertNullAndMissingMetaFieldIntoDifferentBuckets) {
@@ -397,8 +475,8 @@ TEST_F(BucketCatalogTest, InsertNullAndMissingMetaFieldIntoDifferentBuckets) {
 
     // Check metadata in buckets.
     ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONNULL),
-                      _bucketCatalog->getMetadata(result1.getValue()->bucket()));
-    ASSERT(_bucketCatalog->getMetadata(result2.getValue()->bucket()).isEmpty());
+                      _bucketCatalog->getMetadata(result1.getValue()));
+    ASSERT(_bucketCatalog->getMetadata(result2.getValue()).isEmpty());
 
     // Committing one bucket should only return the one document in that bucket and should not
     // affect the other bucket.
@@ -501,7 +579,7 @@ TEST_F(BucketCatalogWithoutMetadataTest, GetMetadataReturnsEmptyDoc) {
                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
                      .getValue();
 
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch->bucket()));
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(batch));
 
     _commit(batch, 0);
 }
@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/decimal_counter.h"
+
+namespace mongo::timeseries {
+namespace {
+
+/**
+ * Appends a copy of the control object with its version replaced by the given one.
+ */
+void appendControl(BSONObjBuilder* builder, const BSONObj& control, int version) {
+    BSONObjBuilder controlBuilder(builder->subobjStart(kBucketControlFieldName));
+    controlBuilder.append(kBucketControlVersionFieldName, version);
+    for (auto&& elem : control) {
+        if (elem.fieldNameStringData() != kBucketControlVersionFieldName) {
+            controlBuilder.append(elem);
+        }
+    }
+}
+
+/**
+ * Appends every top-level field of the bucket except 'data', using 'appendData' in its place.
+ */
+template <typename DataAppender>
+BSONObj rebuildBucket(const BSONObj& bucketDoc, int version, DataAppender&& appendData) {
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kBucketControlFieldName) {
+            appendControl(&builder, elem.Obj(), version);
+        } else if (fieldName == kBucketDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kBucketDataFieldName));
+            appendData(&dataBuilder, elem.Obj());
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace
+
+bool isCompressedBucket(const BSONObj& bucketDoc) {
+    auto version = bucketDoc.getObjectField(kBucketControlFieldName)
+                       .getIntField(kBucketControlVersionFieldName);
+    return version == kTimeseriesControlCompressedVersion;
+}
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName) try {
+    if (isCompressedBucket(bucketDoc)) {
+        return boost::none;
+    }
+
+    auto data = bucketDoc.getObjectField(kBucketDataFieldName);
+    auto timeColumn = data.getObjectField(timeFieldName);
+    if (timeColumn.isEmpty()) {
+        return boost::none;
+    }
+
+    // Every other data field is stored as a sparse object keyed by measurement index, in the same
+    // key order as the time field. Walk them in lockstep to form one row per measurement.
+    struct Measurement {
+        BSONElement time;
+        std::vector<BSONElement> fields;
+    };
+
+    std::vector<StringData> fieldNames;
+    std::vector<BSONObjIterator> fieldIterators;
+    for (auto&& field : data) {
+        if (field.type() != Object) {
+            return boost::none;
+        }
+        if (field.fieldNameStringData() != timeFieldName) {
+            fieldNames.push_back(field.fieldNameStringData());
+            fieldIterators.emplace_back(field.Obj());
+        }
+    }
+
+    std::vector<Measurement> measurements;
+    for (auto&& time : timeColumn) {
+        if (time.type() != Date) {
+            return boost::none;
+        }
+        auto& measurement = measurements.emplace_back();
+        measurement.time = time;
+        measurement.fields.resize(fieldIterators.size());
+        for (size_t i = 0; i < fieldIterators.size(); ++i) {
+            auto& it = fieldIterators[i];
+            if (it.more() && (*it).fieldNameStringData() == time.fieldNameStringData()) {
+                measurement.fields[i] = it.next();
+            }
+        }
+    }
+
+    // A field holding an index that is not present in the time field cannot be represented.
+    for (auto&& it : fieldIterators) {
+        if (it.more()) {
+            return boost::none;
+        }
+    }
+
+    // Ordering by time keeps the deltas of the time field, and usually of the other fields, small.
+    std::stable_sort(measurements.begin(),
+                     measurements.end(),
+                     [](const Measurement& lhs, const Measurement& rhs) {
+                         return lhs.time.date() < rhs.time.date();
+                     });
+
+    return rebuildBucket(
+        bucketDoc, kTimeseriesControlCompressedVersion, [&](BSONObjBuilder* dataBuilder, auto&&) {
+            {
+                BSONColumnBuilder column(timeFieldName);
+                for (auto&& measurement : measurements) {
+                    column.append(measurement.time);
+                }
+                dataBuilder->append(timeFieldName, column.finalize());
+            }
+            for (size_t i = 0; i < fieldNames.size(); ++i) {
+                BSONColumnBuilder column(fieldNames[i]);
+                for (auto&& measurement : measurements) {
+                    if (auto elem = measurement.fields[i]) {
+                        column.append(elem);
+                    } else {
+                        column.skip();
+                    }
+                }
+                dataBuilder->append(fieldNames[i], column.finalize());
+            }
+        });
+} catch (const DBException&) {
+    return boost::none;
+}
+
+BSONObj decompressBucket(const BSONObj& bucketDoc) {
+    if (!isCompressedBucket(bucketDoc)) {
+        return bucketDoc;
+    }
+
+    return rebuildBucket(bucketDoc,
+                         kTimeseriesControlDefaultVersion,
+                         [](BSONObjBuilder* dataBuilder, const BSONObj& data) {
+                             for (auto&& field : data) {
+                                 BSONColumn column(field);
+                                 BSONObjBuilder fieldBuilder(
+                                     dataBuilder->subobjStart(field.fieldNameStringData()));
+                                 DecimalCounter<uint32_t> count;
+                                 for (auto&& elem : column) {
+                                     if (elem) {
+                                         fieldBuilder.appendAs(elem, count);
+                                     }
+                                     ++count;
+                                 }
+                             }
+                         });
+}
+
+}  // namespace mongo::timeseries
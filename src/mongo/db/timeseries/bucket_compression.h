@@ -0,0 +1,60 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo::timeseries {
+
+/**
+ * Returns a copy of the given version 1 bucket document with every data field stored as a
+ * BSONColumn binary, and control.version set to 2. Measurements are ordered by the time field
+ * before compression. Returns boost::none if the bucket could not be compressed, e.g. if it is
+ * already compressed or its data fields are not indexed consistently with the time field.
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName);
+
+/**
+ * Returns the given bucket document with every data field expanded back into an object of
+ * measurements keyed by index, and control.version set to 1. Buckets which are not compressed are
+ * returned unchanged. Throws if a compressed data field is malformed.
+ */
+BSONObj decompressBucket(const BSONObj& bucketDoc);
+
+/**
+ * Returns true if the given bucket document is stored in the compressed (version 2) format.
+ */
+bool isCompressedBucket(const BSONObj& bucketDoc);
+
+}  // namespace mongo::timeseries
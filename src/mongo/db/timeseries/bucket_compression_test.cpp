@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+const OID kBucketId("6113b5ea1ae4b1e0cd3e1a87");
+
+Date_t date(long long millis) {
+    return Date_t::fromMillisSinceEpoch(millis);
+}
+
+BSONObj makeBucket(const BSONObj& data) {
+    return BSON("_id" << kBucketId << "control"
+                      << BSON("version" << 1 << "min" << BSON("time" << date(1)) << "max"
+                                        << BSON("time" << date(3)))
+                      << "meta" << BSON("sensor" << 7) << "data" << data);
+}
+
+TEST(BucketCompression, RoundTrip) {
+    auto bucket = makeBucket(BSON("time" << BSON("0" << date(1) << "1" << date(2) << "2" << date(3))
+                                         << "a" << BSON("0" << 1 << "1" << 2 << "2" << 3)));
+
+    auto compressed = compressBucket(bucket, "time"_sd);
+    ASSERT(compressed);
+    ASSERT(isCompressedBucket(*compressed));
+    ASSERT_EQ(compressed->getObjectField("control").getIntField("version"), 2);
+    ASSERT_BSONOBJ_EQ(compressed->getObjectField("meta"), BSON("sensor" << 7));
+
+    auto data = compressed->getObjectField("data");
+    ASSERT_EQ(data["time"].type(), BinData);
+    ASSERT_EQ(data["time"].binDataType(), Column);
+    ASSERT_EQ(BSONColumn(data["a"]).size(), 3u);
+
+    ASSERT_BSONOBJ_EQ(decompressBucket(*compressed), bucket);
+}
+
+TEST(BucketCompression, SparseFieldsAreSkipped) {
+    auto bucket = makeBucket(BSON("time" << BSON("0" << date(1) << "1" << date(2) << "2" << date(3))
+                                         << "a" << BSON("1" << "x")
+                                         << "b" << BSON("0" << 1.5 << "2" << 2.5)));
+
+    auto compressed = compressBucket(bucket, "time"_sd);
+    ASSERT(compressed);
+    ASSERT_EQ(BSONColumn(compressed->getObjectField("data")["a"]).size(), 3u);
+    ASSERT_BSONOBJ_EQ(decompressBucket(*compressed), bucket);
+}
+
+TEST(BucketCompression, MeasurementsAreSortedByTime) {
+    auto bucket = makeBucket(BSON("time" << BSON("0" << date(3) << "1" << date(1) << "2" << date(2))
+                                         << "a" << BSON("0" << 3 << "1" << 1)));
+    auto expected = makeBucket(BSON("time" << BSON("0" << date(1) << "1" << date(2) << "2"
+                                                       << date(3))
+                                           << "a" << BSON("0" << 1 << "2" << 3)));
+
+    auto compressed = compressBucket(bucket, "time"_sd);
+    ASSERT(compressed);
+    ASSERT_BSONOBJ_EQ(decompressBucket(*compressed), expected);
+}
+
+TEST(BucketCompression, UncompressedBucketIsUnchanged) {
+    auto bucket = makeBucket(BSON("time" << BSON("0" << date(1))));
+    ASSERT_FALSE(isCompressedBucket(bucket));
+    ASSERT_BSONOBJ_EQ(decompressBucket(bucket), bucket);
+}
+
+TEST(BucketCompression, CannotCompress) {
+    // Already compressed.
+    auto compressed = compressBucket(makeBucket(BSON("time" << BSON("0" << date(1)))), "time"_sd);
+    ASSERT(compressed);
+    ASSERT_FALSE(compressBucket(*compressed, "time"_sd));
+
+    // Missing time field.
+    ASSERT_FALSE(compressBucket(makeBucket(BSON("a" << BSON("0" << 1))), "time"_sd));
+
+    // Index not present in the time field.
+    ASSERT_FALSE(compressBucket(
+        makeBucket(BSON("time" << BSON("0" << date(1)) << "a" << BSON("1" << 1))), "time"_sd));
+
+    // Non-date time value.
+    ASSERT_FALSE(compressBucket(makeBucket(BSON("time" << BSON("0" << 1))), "time"_sd));
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
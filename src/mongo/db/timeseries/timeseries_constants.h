@@ -43,9 +43,15 @@ static constexpr StringData kBucketMetaFieldName = "meta"_sd;
 static constexpr StringData kBucketControlFieldName = "control"_sd;
 static constexpr StringData kBucketControlMinFieldName = "min"_sd;
 static constexpr StringData kBucketControlMaxFieldName = "max"_sd;
+static constexpr StringData kBucketControlVersionFieldName = "version"_sd;
 static constexpr StringData kControlMaxFieldNamePrefix = "control.max."_sd;
 static constexpr StringData kControlMinFieldNamePrefix = "control.min."_sd;
 
+// Values of control.version in the bucket schema. Version 1 buckets store each data field as an
+// object of measurements, version 2 buckets store each data field as a BSONColumn binary.
+static constexpr int kTimeseriesControlDefaultVersion = 1;
+static constexpr int kTimeseriesControlCompressedVersion = 2;
+
 // These are hard-coded field names in create collection for time-series collections.
 static constexpr StringData kTimeFieldName = "timeField"_sd;
 static constexpr StringData kMetaFieldName = "metaField"_sd;
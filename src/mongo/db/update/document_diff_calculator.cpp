@@ -55,17 +55,22 @@ std::unique_ptr<diff_tree::ArrayNode> computeArrayDiff(const BSONObj& pre, const
         }
 
         auto preVal = *preItr;
-        auto postVal = *postItr;
+        // Fast path for case where they're equal, which saves the cost of constructing 'postVal'.
+        if (postItr.currentElementBinaryEqual(preVal)) {
+            preItr.advance(preVal);
+            postItr.advance(preVal);
+            ++nFieldsInPostArray;
+            continue;
+        }
 
-        if (!preVal.binaryEqual(postVal)) {
-            // If both are arrays or objects, then recursively compute the diff of the respective
-            // array or object.
-            if (preVal.type() == postVal.type() &&
-                (preVal.type() == BSONType::Object || preVal.type() == BSONType::Array)) {
-                calculateSubDiffHelper(preVal, postVal, nFieldsInPostArray, diffNode.get());
-            } else {
-                diffNode->addUpdate(nFieldsInPostArray, postVal);
-            }
+        auto postVal = *postItr;
+        // If both are arrays or objects, then recursively compute the diff of the respective
+        // array or object.
+        if (preVal.type() == postVal.type() &&
+            (preVal.type() == BSONType::Object || preVal.type() == BSONType::Array)) {
+            calculateSubDiffHelper(preVal, postVal, nFieldsInPostArray, diffNode.get());
+        } else {
+            diffNode->addUpdate(nFieldsInPostArray, postVal);
         }
 
         preItr.advance(preVal);
@@ -220,10 +220,23 @@ mongo::BSONArray MockRemoteDBServer::query(MockRemoteDBServer::InstanceID id,
     scoped_spinlock sLock(_lock);
     _queryCount++;
 
+    // Documents are returned in insertion order, so $min and $max only select the documents
+    // whose fields named by the bound compare within it.
+    const BSONObj& settings = querySettings.getFullSettingsDeprecated();
+    const BSONObj minKey = settings.getObjectField("$min");
+    const BSONObj maxKey = settings.getObjectField("$max");
+    auto compareToBound = [](const BSONObj& doc, const BSONObj& bound) {
+        return doc.extractFieldsUndotted(bound).woCompare(bound, BSONObj(), false);
+    };
+
     auto ns = nsOrUuid.uuid() ? _uuidToNs[*nsOrUuid.uuid()] : nsOrUuid.nss()->ns();
     const vector<BSONObj>& coll = _dataMgr[ns];
     BSONArrayBuilder result;
     for (vector<BSONObj>::const_iterator iter = coll.begin(); iter != coll.end(); ++iter) {
+        if ((!minKey.isEmpty() && compareToBound(*iter, minKey) < 0) ||
+            (!maxKey.isEmpty() && compareToBound(*iter, maxKey) >= 0)) {
+            continue;
+        }
         result.append(project(projectionExecutor.get(), *iter));
     }
 
@@ -95,7 +95,7 @@ public:
     AtomicWord<unsigned> canceled{0U};
     WorkQueue::iterator iter;
     boost::optional<WorkQueue::iterator> exhaustIter;  // Used only in the exhaust path
-    Date_t readyDate;
+    Date_t readyDate;  // Reset once scheduled, so it is only set while in _sleepersQueue.
     bool isNetworkOperation = false;
     bool isTimerOperation = false;
     AtomicWord<bool> isFinished{false};
@@ -498,17 +498,9 @@ void ThreadPoolTaskExecutor::cancel(const CallbackHandle& cbHandle) {
         lk.lock();
     }
     if (cbState->readyDate != Date_t{}) {
-        // This callback might still be in the sleeper queue; if it is, schedule it now
-        // rather than when the alarm fires.
-        auto iter = std::find_if(_sleepersQueue.begin(),
-                                 _sleepersQueue.end(),
-                                 [cbState](const std::shared_ptr<CallbackState>& other) {
-                                     return cbState == other.get();
-                                 });
-        if (iter != _sleepersQueue.end()) {
-            invariant(iter == cbState->iter);
-            scheduleIntoPool_inlock(&_sleepersQueue, cbState->iter, std::move(lk));
-        }
+        // This callback is still in the sleeper queue, so schedule it now rather than when the
+        // alarm fires. Checking 'readyDate' avoids a linear search of '_sleepersQueue'.
+        scheduleIntoPool_inlock(&_sleepersQueue, cbState->iter, std::move(lk));
     }
 }
 
@@ -587,6 +579,9 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
     std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    for (const auto& cbState : todo) {
+        cbState->readyDate = Date_t{};
+    }
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
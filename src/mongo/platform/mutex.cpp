@@ -29,6 +29,8 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <chrono>
+
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
@@ -71,8 +73,13 @@ void Mutex::lock() {
     }
 
     _onContendedLock();
+    const auto waitStart = std::chrono::steady_clock::now();
     _mutex.lock();
     _isLocked = true;
+    _data->counts().contendedWaitMicros.fetchAndAdd(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                              waitStart)
+            .count());
     _onSlowLock();
 }
 
@@ -236,6 +236,9 @@ private:
         AtomicWord<int> destroyed{0};
 
         AtomicWord<int> contended{0};
+        // Total time spent blocked in contended acquisitions. Only the contended path reads the
+        // clock, so uncontended acquisitions pay nothing for it.
+        AtomicWord<long long> contendedWaitMicros{0};
         AtomicWord<int> acquired{0};
         AtomicWord<int> released{0};
     };
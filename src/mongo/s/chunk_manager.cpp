@@ -202,6 +202,20 @@ void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
     }
 }
 
+void ChunkMap::_appendNonOverlappingChunks(ChunkVector::const_iterator first,
+                                           ChunkVector::const_iterator last) {
+    _chunkMap.insert(_chunkMap.end(), first, last);
+    for (auto it = first; it != last; ++it) {
+        const auto chunkVersion = (*it)->getLastmod();
+        if (_collectionVersion.isOlderThan(chunkVersion)) {
+            _collectionVersion = ChunkVersion(chunkVersion.majorVersion(),
+                                              chunkVersion.minorVersion(),
+                                              chunkVersion.epoch(),
+                                              _collTimestamp);
+        }
+    }
+}
+
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
@@ -228,6 +242,22 @@ ChunkMap ChunkMap::createMerged(
     ChunkMap updatedChunkMap(
         getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
 
+    // Appends the unchanged chunks up to 'end'. Only the first few of them can overlap the changed
+    // chunk appended last, and those go through appendChunk() so that it drops them. The rest are
+    // copied in bulk without comparing their bounds.
+    auto appendUnchangedChunks = [&](size_t end) {
+        while (chunkMapIndex < end && !updatedChunkMap._chunkMap.empty() &&
+               _chunkMap[chunkMapIndex]->getRange().overlaps(
+                   updatedChunkMap._chunkMap.back()->getRange())) {
+            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+        }
+        if (chunkMapIndex < end) {
+            updatedChunkMap._appendNonOverlappingChunks(_chunkMap.begin() + chunkMapIndex,
+                                                        _chunkMap.begin() + end);
+            chunkMapIndex = end;
+        }
+    };
+
     while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
         if (chunkMapIndex >= _chunkMap.size()) {
             validateChunk(changedChunks[changedChunkIndex], getVersion());
@@ -236,7 +266,16 @@ ChunkMap ChunkMap::createMerged(
         }
 
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            appendUnchangedChunks(_chunkMap.size());
+            continue;
+        }
+
+        // Every unchanged chunk whose max bound is at or below the min bound of the next changed
+        // chunk lies entirely before it, so skip over all of them at once.
+        const size_t firstPossiblyOverlapping = std::distance(
+            _chunkMap.begin(), _findIntersectingChunk(changedChunks[changedChunkIndex]->getMin()));
+        if (firstPossiblyOverlapping > chunkMapIndex) {
+            appendUnchangedChunks(firstPossiblyOverlapping);
             continue;
         }
 
@@ -278,21 +317,27 @@ BSONObj ChunkMap::toBSON() const {
 
 ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
                                                                        bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+    // Keep the encoded key in the builder's stack buffer so that targeting a document does not
+    // have to allocate a copy of it.
+    KeyString::Builder ks(KeyString::Version::V1);
+    ShardKeyPattern::toKeyString(shardKey, &ks);
+    const StringData shardKeyString(ks.getBuffer(), ks.getSize());
 
     if (!isMaxInclusive) {
         return std::lower_bound(_chunkMap.begin(),
                                 _chunkMap.end(),
                                 shardKey,
                                 [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
+                                    return StringData(chunkInfo->getMaxKeyString()) <
+                                        shardKeyString;
                                 });
     } else {
         return std::upper_bound(_chunkMap.begin(),
                                 _chunkMap.end(),
                                 shardKey,
                                 [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
+                                    return shardKeyString <
+                                        StringData(chunkInfo->getMaxKeyString());
                                 });
     }
 }
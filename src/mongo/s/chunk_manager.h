@@ -130,6 +130,11 @@ private:
     std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
         const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
 
+    // Appends the chunks in [first, last), which must be ordered, must not overlap each other and
+    // must come after the chunks already in this map without overlapping any of them.
+    void _appendNonOverlappingChunks(ChunkVector::const_iterator first,
+                                     ChunkVector::const_iterator last);
+
     ChunkVector _chunkMap;
 
     // Max version across all chunks
@@ -45,6 +45,46 @@ public:
         return _shardKeyPattern;
     }
 
+    std::shared_ptr<ChunkInfo> makeChunk(const BSONObj& min,
+                                         const BSONObj& max,
+                                         const ChunkVersion& version) const {
+        return std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, version, kThisShard});
+    }
+
+    /**
+     * Returns the chunks [MinKey, 0), [0, 10), ..., [70, 80), [80, MaxKey) with versions 1|0 to
+     * 1|9.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> makeTenChunks(const OID& epoch) const {
+        std::vector<std::shared_ptr<ChunkInfo>> chunks;
+        auto min = getShardKeyPattern().globalMin();
+        for (int i = 0; i < 10; ++i) {
+            auto max = i < 9 ? BSON("a" << i * 10) : getShardKeyPattern().globalMax();
+            ChunkVersion version{1, static_cast<uint32_t>(i), epoch, boost::none /* timestamp */};
+            chunks.push_back(makeChunk(min, max, version));
+            min = max;
+        }
+        return chunks;
+    }
+
+    /**
+     * Asserts that 'chunkMap' holds exactly the 'expected' chunk objects, in order.
+     */
+    void assertChunks(const ChunkMap& chunkMap,
+                      const std::vector<std::shared_ptr<ChunkInfo>>& expected) const {
+        ASSERT_EQ(chunkMap.size(), expected.size());
+
+        size_t idx = 0;
+        chunkMap.forEach([&](const auto& chunkInfo) {
+            ASSERT_EQ(chunkInfo.get(), expected[idx].get())
+                << "at index " << idx << ": " << chunkInfo->toString() << " instead of "
+                << expected[idx]->toString();
+            ++idx;
+            return true;
+        });
+    }
+
 private:
     KeyPattern _shardKeyPattern{BSON("a" << 1)};
 };
@@ -165,4 +205,64 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeSplitsAndMergesStraddlingSkippedChunks) {
+    const OID epoch = OID::gen();
+    const auto oldChunks = makeTenChunks(epoch);
+    const auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(oldChunks);
+
+    // [10, 40) merges three old chunks, [40, 50) is split at 45 and [50, 70) merges two more.
+    // Unchanged chunks are skipped both before and between the changed ones.
+    const auto merged1040 = makeChunk(BSON("a" << 10), BSON("a" << 40), {2, 0, epoch, boost::none});
+    const auto split4045 = makeChunk(BSON("a" << 40), BSON("a" << 45), {2, 1, epoch, boost::none});
+    const auto split4550 = makeChunk(BSON("a" << 45), BSON("a" << 50), {2, 2, epoch, boost::none});
+    const auto merged5070 = makeChunk(BSON("a" << 50), BSON("a" << 70), {2, 3, epoch, boost::none});
+
+    const auto newChunkMap = chunkMap.createMerged({merged1040, split4045, split4550, merged5070});
+
+    assertChunks(newChunkMap,
+                 {oldChunks[0],
+                  oldChunks[1],
+                  merged1040,
+                  split4045,
+                  split4550,
+                  merged5070,
+                  oldChunks[8],
+                  oldChunks[9]});
+    ASSERT_EQ(newChunkMap.getVersion(), ChunkVersion(2, 3, epoch, boost::none));
+}
+
+TEST_F(ChunkMapTest, TestMergeChangedChunksAfterLastOldChunk) {
+    const OID epoch = OID::gen();
+    const auto oldChunks = makeTenChunks(epoch);
+
+    // The old map ends at the chunk [0, 10), so both changed chunks come after all of it.
+    const auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        {oldChunks[0], oldChunks[1]});
+
+    const auto chunk1050 = makeChunk(BSON("a" << 10), BSON("a" << 50), {2, 0, epoch, boost::none});
+    const auto chunk50Max =
+        makeChunk(BSON("a" << 50), getShardKeyPattern().globalMax(), {2, 1, epoch, boost::none});
+
+    const auto newChunkMap = chunkMap.createMerged({chunk1050, chunk50Max});
+
+    assertChunks(newChunkMap, {oldChunks[0], oldChunks[1], chunk1050, chunk50Max});
+    ASSERT_EQ(newChunkMap.getVersion(), ChunkVersion(2, 1, epoch, boost::none));
+}
+
+TEST_F(ChunkMapTest, TestMergeChangedChunkStartingAtOldChunkMax) {
+    const OID epoch = OID::gen();
+    const auto oldChunks = makeTenChunks(epoch);
+    const auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(oldChunks);
+
+    // The min of the changed chunk equals the max of the old chunk [30, 40), which must be kept.
+    const auto chunk4050 = makeChunk(BSON("a" << 40), BSON("a" << 50), {2, 0, epoch, boost::none});
+
+    const auto newChunkMap = chunkMap.createMerged({chunk4050});
+
+    auto expected = oldChunks;
+    expected[5] = chunk4050;
+    assertChunks(newChunkMap, expected);
+    ASSERT_EQ(newChunkMap.getVersion(), ChunkVersion(2, 0, epoch, boost::none));
+}
+
 }  // namespace mongo
@@ -103,6 +103,12 @@ public:
             auto response = uassertStatusOK(ClusterFind::runGetMore(opCtx, _cmd));
             response.addToBSON(CursorResponse::ResponseType::SubsequentResponse, &bob);
 
+            if (opCtx->isExhaust() && response.getCursorId() != CursorId(0)) {
+                // Indicate that an exhaust message should be generated and the previous BSONObj
+                // command parameters should be reused as the next BSONObj command parameters.
+                reply->setNextInvocation(boost::none);
+            }
+
             if (getTestCommandsEnabled()) {
                 validateResult(bob.asTempObj());
             }
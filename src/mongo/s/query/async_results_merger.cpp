@@ -74,7 +74,7 @@ const int kMaxNumFailedHostRetryAttempts = 3;
  * and 'compareWholeSortKey'=true, this function will return
  *   {"": <value>}
  */
-BSONObj extractSortKey(BSONObj obj, bool compareWholeSortKey) {
+BSONObj extractSortKey(const BSONObj& obj, bool compareWholeSortKey) {
     auto key = obj[AsyncResultsMerger::kSortKeyField];
     invariant(key);
     if (compareWholeSortKey) {
@@ -88,7 +88,9 @@ BSONObj extractSortKey(BSONObj obj, bool compareWholeSortKey) {
  * Returns an int less than 0 if 'leftSortKey' < 'rightSortKey', 0 if the two are equal, and an int
  * > 0 if 'leftSortKey' > 'rightSortKey' according to the pattern 'sortKeyPattern'.
  */
-int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPattern) {
+int compareSortKeys(const BSONObj& leftSortKey,
+                    const BSONObj& rightSortKey,
+                    const BSONObj& sortKeyPattern) {
     // This does not need to sort with a collator, since mongod has already mapped strings to their
     // ICU comparison keys as part of the $sortKey meta projection.
     const BSONObj::ComparisonRulesSet rules = 0;  // 'considerFieldNames' flag is not set.
@@ -320,7 +322,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
     }
 
     auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    const auto& smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
@@ -377,7 +379,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
+    ClusterQueryResult front = std::move(_remotes[smallestRemote].docBuffer.front());
     _remotes[smallestRemote].docBuffer.pop();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
@@ -404,7 +406,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
         invariant(_remotes[_gettingFromRemote].status.isOK());
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
+            ClusterQueryResult front = std::move(_remotes[_gettingFromRemote].docBuffer.front());
             _remotes[_gettingFromRemote].docBuffer.pop();
 
             if (_tailableMode == TailableModeEnum::kTailable &&
@@ -928,6 +930,14 @@ bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const
     const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
     const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
 
+    if (_compareWholeSortKey) {
+        // The sort pattern is {$sortKey: 1}, so compare the scalar sort keys directly rather than
+        // wrapping each of them into a new object on every comparison.
+        const BSONObj::ComparisonRulesSet rules = 0;
+        return (*leftDoc.getResult())[kSortKeyField].woCompare(
+                   (*rightDoc.getResult())[kSortKeyField], rules) > 0;
+    }
+
     return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
                            extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
                            _sort) > 0;
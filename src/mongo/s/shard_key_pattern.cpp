@@ -264,14 +264,20 @@ std::string ShardKeyPattern::toString() const {
 }
 
 std::string ShardKeyPattern::toKeyString(const BSONObj& shardKey) {
-    KeyString::Builder ks(KeyString::Version::V1, Ordering::allAscending());
+    KeyString::Builder ks(KeyString::Version::V1);
+    toKeyString(shardKey, &ks);
+
+    return {ks.getBuffer(), ks.getSize()};
+}
+
+void ShardKeyPattern::toKeyString(const BSONObj& shardKey, KeyString::Builder* ks) {
+    invariant(ks->version == KeyString::Version::V1);
+    ks->resetToEmpty(Ordering::allAscending());
 
     BSONObjIterator it(shardKey);
     while (auto elem = it.next()) {
-        ks.appendBSONElement(elem);
+        ks->appendBSONElement(elem);
     }
-
-    return {ks.getBuffer(), ks.getSize()};
 }
 
 bool ShardKeyPattern::isShardKey(const BSONObj& shardKey) const {
@@ -38,6 +38,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 
@@ -129,6 +130,12 @@ public:
      */
     static std::string toKeyString(const BSONObj& shardKey);
 
+    /**
+     * Same as above, but encodes the KeyString into the caller-provided builder 'ks' instead of
+     * returning a copy of it. The builder is reset first, and must use KeyString::Version::V1.
+     */
+    static void toKeyString(const BSONObj& shardKey, KeyString::Builder* ks);
+
     /**
      * Returns true if the provided document is a shard key - i.e. has the same fields as the
      * shard key pattern and valid shard key values.
@@ -903,5 +903,16 @@ TEST_F(ShardKeyPatternTest, ExtractShardKeyFromDocumentKey_Hashed) {
         BSONObj());
 }
 
+TEST_F(ShardKeyPatternTest, ToKeyStringIntoBuilderMatchesToKeyString) {
+    KeyString::Builder ks(KeyString::Version::V1);
+    for (const auto& shardKey :
+         {BSON("a" << 1 << "b" << 2), BSON("a" << MINKEY), BSON("a" << -3 << "b" << 2.5)}) {
+        // The builder is reused, so each key must overwrite the one encoded before it.
+        ShardKeyPattern::toKeyString(shardKey, &ks);
+        ASSERT_EQ(std::string(ks.getBuffer(), ks.getSize()),
+                  ShardKeyPattern::toKeyString(shardKey));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -306,7 +306,10 @@ ScriptingFunction Scope::createFunction(const char* code) {
         }
     }
 
-    FunctionCacheMap::iterator i = _cachedFunctions.find(code);
+    // Callers such as $function and $where look the same source up once per document, so the
+    // lookup is heterogeneous and does not copy the source into a temporary std::string.
+    const StringData codeStr(code);
+    FunctionCacheMap::iterator i = _cachedFunctions.find(codeStr);
     if (i != _cachedFunctions.end())
         return i->second;
 
@@ -37,7 +37,7 @@
 namespace mongo {
 typedef unsigned long long ScriptingFunction;
 typedef BSONObj (*NativeFunction)(const BSONObj& args, void* data);
-typedef std::map<std::string, ScriptingFunction> FunctionCacheMap;
+typedef std::map<std::string, ScriptingFunction, std::less<>> FunctionCacheMap;
 
 class DBClientBase;
 class OperationContext;
@@ -168,8 +168,7 @@ void checkOverflow(std::unique_ptr<MessageCompressorBase> compressor) {
         compressor->decompressData(tooSmallRange, DataRange(scratch.data(), scratch.size())));
 }
 
-Message buildMessage() {
-    const auto data = std::string{"Hello, world!"};
+Message buildMessage(const std::string& data = "Hello, world!") {
     const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
     auto buf = SharedBuffer::allocate(bufferSize);
     MsgData::View testView(buf.get());
@@ -261,6 +260,17 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, FidelityAfterLargeMessage) {
+    // Compression contexts are reused across messages, so a small message compressed with a
+    // context which has just handled a much larger one must still round trip.
+    std::string largeData;
+    for (int i = 0; largeData.size() < 4 * 1024 * 1024; ++i) {
+        largeData += std::to_string(i * 7919);
+    }
+    checkFidelity(buildMessage(largeData), std::make_unique<ZstdMessageCompressor>());
+    checkFidelity(buildMessage(), std::make_unique<ZstdMessageCompressor>());
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -30,14 +30,87 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+// Creating a zstd context allocates and initializes its working tables, which costs more than
+// compressing a typical small message. Contexts are reused, which produces exactly the same frames
+// as the one-shot ZSTD_compress()/ZSTD_decompress() calls. They are kept in small pools shared by
+// all threads rather than one per thread: a compression context holds over a megabyte once it has
+// compressed a large message, and a server may run thousands of connection threads.
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// The most contexts of each kind that are kept for reuse. Threads which find the pool empty create
+// a context of their own, which is freed after use if the pool is full again by then.
+constexpr size_t kMaxPooledContexts = 16;
+
+template <typename Context, Context* (*createContext)()>
+class ZstdContextPool {
+public:
+    using ContextPtr = std::unique_ptr<Context, ZstdContextDeleter>;
+
+    /**
+     * Returns a free pooled context, or a new one if there is none. Returns a null pointer if a
+     * new context could not be allocated.
+     */
+    ContextPtr acquire() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_contexts.empty()) {
+                auto ctx = std::move(_contexts.back());
+                _contexts.pop_back();
+                return ctx;
+            }
+        }
+        return ContextPtr{createContext()};
+    }
+
+    /**
+     * Hands 'ctx' back for reuse, or frees it if the pool is full.
+     */
+    void release(ContextPtr ctx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_contexts.size() < kMaxPooledContexts) {
+            _contexts.push_back(std::move(ctx));
+        }
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ZstdContextPool::_mutex");
+    std::vector<ContextPtr> _contexts;
+};
+
+using ZstdCompressionContextPool = ZstdContextPool<ZSTD_CCtx, &ZSTD_createCCtx>;
+using ZstdDecompressionContextPool = ZstdContextPool<ZSTD_DCtx, &ZSTD_createDCtx>;
+
+// The pools are never destroyed, so that threads still compressing during shutdown can use them.
+ZstdCompressionContextPool& compressionContextPool() {
+    static auto& pool = *new ZstdCompressionContextPool();
+    return pool;
+}
+
+ZstdDecompressionContextPool& decompressionContextPool() {
+    static auto& pool = *new ZstdDecompressionContextPool();
+    return pool;
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +120,17 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto ctx = compressionContextPool().acquire();
+    if (!ctx) {
+        return Status{ErrorCodes::InternalError, "Could not create zstd compression context"};
+    }
+    size_t ret = ZSTD_compressCCtx(ctx.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
+    compressionContextPool().release(std::move(ctx));
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +142,13 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto ctx = decompressionContextPool().acquire();
+    if (!ctx) {
+        return Status{ErrorCodes::InternalError, "Could not create zstd decompression context"};
+    }
+    size_t ret = ZSTD_decompressDCtx(
+        ctx.get(), const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    decompressionContextPool().release(std::move(ctx));
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -52,14 +52,14 @@ void SpinLock::_lockSlowPath() {
      */
 
     for (int i = 0; i < 1000; i++) {
-        if (_tryLock())
+        if (_looksUnlocked() && _tryLock())
             return;
 
         MONGO_YIELD_CORE_FOR_SMT();
     }
 
     for (int i = 0; i < 1000; i++) {
-        if (_tryLock())
+        if (_looksUnlocked() && _tryLock())
             return;
         sched_yield();
     }
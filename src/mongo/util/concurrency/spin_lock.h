@@ -107,7 +107,7 @@ public:
     SpinLock() = default;
 
     void unlock() override {
-        _locked.clear(std::memory_order_release);
+        _locked.store(false, std::memory_order_release);
     }
 
     void lock() override {
@@ -122,14 +122,20 @@ public:
 
 private:
     bool _tryLock() {
-        bool wasLocked = _locked.test_and_set(std::memory_order_acquire);
+        bool wasLocked = _locked.exchange(true, std::memory_order_acquire);
         return !wasLocked;
     }
 
+    // Only reads the lock word, so that waiters spinning on a held lock share its cache line
+    // instead of taking it away from the holder with every attempt.
+    bool _looksUnlocked() const {
+        return !_locked.load(std::memory_order_relaxed);
+    }
+
     void _lockSlowPath();
 
-    // Initializes to the cleared state.
-    std::atomic_flag _locked = ATOMIC_FLAG_INIT;  // NOLINT
+    // Initializes to the unlocked state.
+    std::atomic<bool> _locked{false};  // NOLINT
 };
 
 #endif
@@ -354,6 +354,7 @@ void LatchAnalyzer::appendToBSON(mongo::BSONObjBuilder& result) const {
         latchObj.append("acquired", data->counts().acquired.loadRelaxed());
         latchObj.append("released", data->counts().released.loadRelaxed());
         latchObj.append("contended", data->counts().contended.loadRelaxed());
+        latchObj.append("contendedWaitMicros", data->counts().contendedWaitMicros.loadRelaxed());
 
         auto appendViolations = [&] {
             stdx::lock_guard lk(_mutex);
@@ -297,6 +297,17 @@ std::string escapeForText(StringData str) {
 }
 
 void escapeForJSON(fmt::memory_buffer& buffer, StringData str) {
+    // Most strings written as JSON are printable ASCII without quotes or backslashes. Copy the
+    // prefix that needs no escaping in one go and only run the escaper on what remains. The prefix
+    // is pure ASCII, so the remainder starts on a UTF-8 code point boundary.
+    auto firstToEscape = std::find_if(str.begin(), str.end(), [](uint8_t c) {
+        return c < 0x20 || c >= 0x7f || c == '"' || c == '\\';
+    });
+    buffer.append(str.begin(), firstToEscape);
+    if (firstToEscape == str.end())
+        return;
+    str = StringData(firstToEscape, str.end() - firstToEscape);
+
     auto singleByteHandler = [](const auto& writer, uint8_t unescaped) {
         switch (unescaped) {
             case '\0':